@@ -38,6 +38,7 @@
 #include "omnetpp/cdataratechannel.h"
 #include "omnetpp/cconfiguration.h"
 #include "omnetpp/ccoroutine.h"
+#include "omnetpp/ccoroutinemodule.h"
 #include "omnetpp/cdefaultowner.h"
 #include "omnetpp/cabstracthistogram.h"
 #include "omnetpp/cconfigoption.h"
@@ -71,6 +72,8 @@
 #include "omnetpp/cmodelchange.h"
 #include "omnetpp/cmodule.h"
 #include "omnetpp/ceventheap.h"
+#include "omnetpp/ccalendarqueue.h"
+#include "omnetpp/cdaryeventheap.h"
 #include "omnetpp/cmatchexpression.h"
 #include "omnetpp/cpatternmatcher.h"
 #include "omnetpp/cnedfunction.h"
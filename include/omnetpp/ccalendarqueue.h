@@ -0,0 +1,223 @@
+//==========================================================================
+//  CCALENDARQUEUE.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_CCALENDARQUEUE_H
+#define __OMNETPP_CCALENDARQUEUE_H
+
+#include <vector>
+#include "cfutureeventset.h"
+
+namespace omnetpp {
+
+/**
+ * @brief Calendar queue based implementation of the future event set.
+ *
+ * The calendar queue (R. Brown, 1988) distributes events into an array of
+ * buckets ("days") by arrival time, and serves them by walking the buckets
+ * like the days of a calendar. With a bucket width adapted to the typical
+ * distance between events, both insertion and removal are O(1) amortized,
+ * which makes this class a good choice for models that keep millions of
+ * events in the FES, where the O(log n) cost and cache misses of cEventHeap
+ * dominate. The number of buckets and the bucket width are recomputed when
+ * the number of events grows or shrinks by a factor of two.
+ *
+ * Like cEventHeap, this class employs a circular buffer for events inserted
+ * for the current simulation time with zero priority, so that bursts of
+ * zero-delay events do not cost more than appending to a FIFO.
+ *
+ * Events are served in exactly the same order as with cEventHeap, i.e.
+ * in arrival time, scheduling priority and insertion order, so simulation
+ * results and fingerprints do not depend on the choice of the FES class.
+ * To use it, add the following line to the ini file:
+ *
+ * <pre>
+ * futureeventset-class = omnetpp::cCalendarQueue
+ * </pre>
+ *
+ * @ingroup SimSupport
+ */
+class SIM_API cCalendarQueue : public cFutureEventSet
+{
+  private:
+    typedef std::vector<cEvent*> Bucket;  // in reverse scheduling order, i.e. first event is at the back
+
+    // calendar
+    std::vector<Bucket> buckets;  // size is always power of 2
+    int64_t bucketWidth;          // in raw simtime units
+    int calendarLength;           // number of events in the buckets
+    eventnumber_t insertCount;    // counts insertions; needed to maintain insertion order for events with equal time and priority
+    mutable int currentBucket;    // index of the bucket where the search for the first event starts
+    mutable int64_t currentSlot;  // the "day" (arrivalTime/bucketWidth) that corresponds to currentBucket
+    mutable cEvent *firstEvent;   // cached first event in the buckets, or nullptr if not known
+
+    // circular buffer for events scheduled for the current simtime (quite frequent); acts as FIFO
+    cEvent **cb;              // size of the circular buffer
+    int cbsize;               // always power of 2
+    int cbhead, cbtail;       // cbhead is inclusive, cbtail is exclusive
+
+    // for get(k): all events in the buckets, in bucket order (or sorted, after sort())
+    std::vector<cEvent*> flattened;
+    bool flattenedValid;
+
+  private:
+    void copy(const cCalendarQueue& other);
+
+    int cblength() const  {return (cbtail-cbhead) & (cbsize-1);}
+    void cbgrow();
+    void cbInsert(cEvent *event);
+    void flushCb();
+
+    int64_t getSlot(const cEvent *event) const;
+    int getBucketIndex(int64_t slot) const {return (int)(slot & (buckets.size()-1));}
+    void calendarInsert(cEvent *event);
+    void calendarRemove(cEvent *event);
+    cEvent *calendarPeekFirst() const;
+    void resize(int numBuckets);
+    int64_t computeBucketWidth(std::vector<cEvent*>& events) const;
+    void validateFlattened();
+
+  public:
+    /** @name Constructors, destructor, assignment */
+    //@{
+
+    /**
+     * Copy constructor.
+     */
+    cCalendarQueue(const cCalendarQueue& other);
+
+    /**
+     * Constructor.
+     */
+    cCalendarQueue(const char *name=nullptr);
+
+    /**
+     * Destructor.
+     */
+    virtual ~cCalendarQueue();
+
+    /**
+     * Assignment operator. The name member is not copied;
+     * see cOwnedObject's operator=() for more details.
+     */
+    cCalendarQueue& operator=(const cCalendarQueue& other);
+    //@}
+
+    /** @name Redefined cObject member functions. */
+    //@{
+
+    /**
+     * Creates and returns an exact copy of this object.
+     * See cObject for more details.
+     */
+    virtual cCalendarQueue *dup() const override  {return new cCalendarQueue(*this);}
+
+    /**
+     * Produces a one-line description of the object's contents.
+     * See cObject for more details.
+     */
+    virtual std::string str() const override;
+
+    /**
+     * Calls v->visit(this) for each contained object.
+     * See cObject for more details.
+     */
+    virtual void forEachChild(cVisitor *v) override;
+
+    // no parsimPack() and parsimUnpack()
+    //@}
+
+    /** @name Simulation-related operations. */
+    //@{
+    /**
+     * Insert an event into the FES.
+     */
+    virtual void insert(cEvent *event) override;
+
+    /**
+     * Peek the first event in the FES (the one with the smallest timestamp.)
+     * If the FES is empty, it returns nullptr.
+     */
+    virtual cEvent *peekFirst() const override;
+
+    /**
+     * Removes and return the first event in the FES (the one with the
+     * smallest timestamp.) If the FES is empty, it returns nullptr.
+     */
+    virtual cEvent *removeFirst() override;
+
+    /**
+     * Undo for removeFirst(): it puts back an event to the front of the FES.
+     */
+    virtual void putBackFirst(cEvent *event) override;
+
+    /**
+     * Removes and returns the given event in the FES. If the event is
+     * not in the FES, returns nullptr.
+     */
+    virtual cEvent *remove(cEvent *event) override;
+
+    /**
+     * Returns true if the FES is empty.
+     */
+    virtual bool isEmpty() const override {return cbhead==cbtail && calendarLength==0;}
+
+    /**
+     * Deletes all events in the FES.
+     */
+    virtual void clear() override;
+    //@}
+
+    /** @name Random access. */
+    //@{
+
+    /**
+     * Returns the number of events in the FES.
+     */
+    virtual int getLength() const override {return cblength() + calendarLength;}
+
+    /**
+     * Returns the kth event in the FES if 0 <= k < getLength(), and nullptr
+     * otherwise. Note that iteration does not necessarily return events
+     * in increasing timestamp (getArrivalTime()) order unless you called
+     * sort() before.
+     */
+    virtual cEvent *get(int k) override;
+
+    /**
+     * Sorts the contents of the FES. This is only necessary if one wants
+     * to iterate through in the FES in strict timestamp order.
+     */
+    virtual void sort() override;
+    //@}
+
+    /** @name Calendar parameters. */
+    //@{
+    /**
+     * Returns the current number of buckets in the calendar.
+     */
+    int getNumBuckets() const {return buckets.size();}
+
+    /**
+     * Returns the current bucket width, in raw simtime units.
+     */
+    int64_t getBucketWidth() const {return bucketWidth;}
+    //@}
+};
+
+}  // namespace omnetpp
+
+
+#endif
+
@@ -104,6 +104,20 @@ class SIM_API cComponent : public cDefaultOwner //implies noncopyable
     typedef std::vector<SignalListenerList> SignalTable;
     SignalTable *signalTable; // ordered by signalID so we can do binary search
 
+    // growable bit set, indexed by signal bit index (see getSignalBitIndex())
+    struct SignalBits {
+        std::vector<uint64_t> words;
+        bool test(int k) const {size_t w = k >> 6; return w < words.size() && ((words[w] >> (k & 63)) & 1) != 0;}
+        void set(int k, bool value);
+    };
+
+    // for the emit() fast path; allocated on demand, nullptr means all bits are clear
+    struct SignalFlags {
+        SignalBits local;      // bit k set: this component has listeners for the signal with bit index k
+        SignalBits effective;  // bit k set: this component or one of its ancestors has such listeners
+    };
+    SignalFlags *signalFlags;
+
     // string-to-simsignal_t mapping
     static struct SignalNameMapping {
         std::map<std::string,simsignal_t> signalNameToID;
@@ -113,6 +127,8 @@ class SIM_API cComponent : public cDefaultOwner //implies noncopyable
 
     // for hasListeners()/mayHaveListeners()
     static std::vector<int> signalListenerCounts;  // index: signalID, value: number of listeners anywhere
+    static std::vector<int> signalBitIndices;  // index: signalID, value: bit index in SignalFlags, or -1 if not yet assigned
+    static int numSignalBitIndices;  // number of bit indices assigned so far
 
     // stack of listener lists being notified, to detect concurrent modification
     static cIListener **notificationStack[];
@@ -136,6 +152,9 @@ class SIM_API cComponent : public cDefaultOwner //implies noncopyable
     void throwInvalidSignalID(simsignal_t signalID) const;
     void removeListenerList(simsignal_t signalID);
     void checkNotFiring(simsignal_t, cIListener **listenerList);
+    void setLocalSignalFlag(simsignal_t signalID, bool value);
+    void propagateSignalFlag(int bitIndex);
+    void repairSignalFlags();
     template<typename T> void fire(cComponent *src, simsignal_t signalID, T x, cObject *details);
     void fireFinish();
     void releaseLocalListeners();
@@ -189,10 +208,10 @@ class SIM_API cComponent : public cDefaultOwner //implies noncopyable
     // internal: clears signal registrations; to be invoked on exit
     static void clearSignalRegistrations();
 
-    // internal: allocates a signalHasLocalListeners/signalHasAncestorListeners bit index to the
-    // given signal and returns the corresponding mask (1<<index); returns 0 if there are no more
-    // free bit indices. Result is remembered and returned in subsequent calls (until clearSignalState())
-    static uint64_t getSignalMask(simsignal_t signalID);
+    // internal: allocates a bit index in the per-component signal flags to the given signal,
+    // and returns it. Bit indices are only assigned to signals that get subscribed to, and the
+    // result is remembered and returned in subsequent calls (until clearSignalState())
+    static int getSignalBitIndex(simsignal_t signalID);
 
     // internal: controls whether signals should be validated against @signal declarations in NED files
     static void setCheckSignals(bool b) {checkSignals = b;}
@@ -938,15 +957,21 @@ class SIM_API cComponent : public cDefaultOwner //implies noncopyable
     }
 
     /**
-     * Returns true if the given signal has any listeners. In the current
-     * implementation, this involves checking listener lists in ancestor
-     * modules until the first listener is found, or up to the root.
+     * Returns true if the given signal has any listeners in this component
+     * or in any ancestor module. This method has a constant cost (it tests
+     * a flag that is maintained on subscribe/unsubscribe and on changes in
+     * the module hierarchy), and is the same check emit() performs.
      * This method may be useful if producing the data for an emit()
      * call would be expensive compared to a hasListeners() call.
      *
      * @see mayHaveListeners()
      */
-    bool hasListeners(simsignal_t signalID) const;
+    bool hasListeners(simsignal_t signalID) const {
+        if (signalID < 0 || signalID > lastSignalID)
+            throwInvalidSignalID(signalID);
+        int bitIndex = signalBitIndices[signalID];
+        return bitIndex != -1 && signalFlags != nullptr && signalFlags->effective.test(bitIndex);
+    }
     //@}
 
     /** @name Subscribing to simulation signals. */
@@ -128,6 +128,10 @@ class SIM_API cComponentType : public cNoncopyableOwnedObject
     // internal: return the directory of the source file this declaration has been loaded from, or nullptr if not available
     virtual const char *getSourceFileDirectory() const;
 
+    // internal: deletes the shared parameter values (sharedParMap, sharedParSet);
+    // may only be called when no component of this type exists
+    virtual void clearSharedParImpls();
+
     // internal: used by cComponent::emit() methods to validate signals
     virtual void checkSignal(simsignal_t signalID, SimsignalType type, cObject *obj = nullptr);
 
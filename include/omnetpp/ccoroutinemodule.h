@@ -0,0 +1,375 @@
+//==========================================================================
+//  CCOROUTINEMODULE.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_CCOROUTINEMODULE_H
+#define __OMNETPP_CCOROUTINEMODULE_H
+
+// This facility requires C++20 coroutine support in the compiler that
+// compiles the model; when that is not available, this header is empty.
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define OMNETPP_HAS_COROUTINE_MODULE
+
+#include <coroutine>
+#include <exception>
+#include "csimplemodule.h"
+#include "csimulation.h"
+#include "cmessage.h"
+#include "cqueue.h"
+#include "cexception.h"
+#include "ccontextswitcher.h"
+
+namespace omnetpp {
+
+/**
+ * @brief Base class for simple modules whose behavior is written as a
+ * C++20 coroutine, in the style of activity().
+ *
+ * Modules that use activity() need a separate stack each (see cCoroutine),
+ * which limits the number of such modules in a simulation, and every event
+ * requires a full context switch. This class offers an alternative with
+ * the same programming model: the module body is written as a stackless
+ * C++20 coroutine, coActivity(), which can suspend itself with co_await
+ * coReceive(), co_await coWait() and similar calls; these are the
+ * counterparts of receive() and wait() in activity(). Coroutine frames are
+ * allocated on the heap, and their size is determined by the compiler
+ * from the local variables that live across suspension points, which is
+ * typically a few hundred bytes instead of the tens of kilobytes of stack
+ * an activity() module needs.
+ *
+ * For the simulation kernel, such a module is a regular handleMessage()
+ * based simple module; handleMessage() is implemented in this class, and
+ * resumes the coroutine. This means that the coroutine runs on the main
+ * stack and needs no stack size setting, and that this facility coexists
+ * with the activity() support of cSimpleModule (whichever coroutine
+ * library it uses). Only code compiled as C++20 can use this class; the
+ * simulation library itself does not need to be rebuilt.
+ *
+ * Example:
+ *
+ * <pre>
+ * class Generator : public cCoroutineModule
+ * {
+ *   protected:
+ *     virtual Task coActivity() override {
+ *         for (int i = 0; ; i++) {
+ *             co_await coWait(par("interval").doubleValue());
+ *             send(new cMessage("job"), "out");
+ *             cMessage *ack = co_await coReceive(1.0);
+ *             if (!ack)
+ *                 EV << "No ack within 1s\n";
+ *             delete ack;
+ *         }
+ *     }
+ * };
+ * </pre>
+ *
+ * Notes:
+ *  - coActivity() starts at the time the module is started (see
+ *    scheduleStart()), i.e. after initialize(), just like activity().
+ *  - coWait(), coReceive() and coWaitAndEnqueue() must be used with
+ *    co_await. Calling them without co_await has no effect (the compiler
+ *    warns about it). The wait() and receive() methods of cSimpleModule
+ *    cannot be used, because the module does not have its own stack.
+ *  - Receiving a message during coWait() is an error, like with wait() in
+ *    activity(); use coWaitAndEnqueue() if messages may arrive while waiting.
+ *  - The module may delete itself (deleteModule()) from within
+ *    coActivity(); the call does not return, and the module is deleted
+ *    by the simulation kernel. However, deleting a compound module that
+ *    contains the module whose coroutine is running is not allowed.
+ *  - Local variables of the coroutine are destroyed when the module is
+ *    deleted. As with activity(), dynamically allocated objects referenced
+ *    only by local pointers are leaked unless they are deleted in finish()
+ *    or in a destructor.
+ *
+ * @ingroup SimCore
+ */
+class cCoroutineModule : public cSimpleModule
+{
+  public:
+    /**
+     * Return type of coActivity(). It is a move-only handle that owns the
+     * coroutine frame.
+     */
+    class Task
+    {
+      public:
+        struct promise_type {
+            std::exception_ptr exception;
+
+            Task get_return_object() {return Task(std::coroutine_handle<promise_type>::from_promise(*this));}
+            std::suspend_always initial_suspend() noexcept {return {};}
+            std::suspend_always final_suspend() noexcept {return {};}
+            void return_void() {}
+            void unhandled_exception() {exception = std::current_exception();}
+
+            // keep track of frame memory, for getTotalFrameSize()
+            static void *operator new(size_t size) {frameMemory() += size; return ::operator new(size);}
+            static void operator delete(void *p, size_t size) {frameMemory() -= size; ::operator delete(p);}
+        };
+
+      private:
+        std::coroutine_handle<promise_type> handle;
+
+      public:
+        Task() {}
+        explicit Task(std::coroutine_handle<promise_type> h) : handle(h) {}
+        Task(Task&& other) noexcept : handle(other.handle) {other.handle = nullptr;}
+        Task& operator=(Task&& other) noexcept {if (this != &other) {destroy(); handle = other.handle; other.handle = nullptr;} return *this;}
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        ~Task() {destroy();}
+
+        bool isValid() const {return (bool)handle;}
+        bool isDone() const {return !handle || handle.done();}
+        void resume() {
+            handle.resume();
+            if (handle.promise().exception) {
+                std::exception_ptr e = handle.promise().exception;
+                handle.promise().exception = nullptr;
+                std::rethrow_exception(e);
+            }
+        }
+        void destroy() {if (handle) {handle.destroy(); handle = nullptr;}}
+    };
+
+  private:
+    enum State { NOT_STARTED, RUNNING, WAITING, RECEIVING, DONE };
+    State state = NOT_STARTED;
+    bool resuming = false;
+    Task task;
+    cMessage *timerMessage = nullptr;   // starter message, then timeout message for coWait() and coReceive()
+    cMessage *receivedMessage = nullptr; // for passing the message to coReceive()
+    cQueue *waitQueue = nullptr;         // for coWaitAndEnqueue()
+
+    static size_t& frameMemory() {static size_t bytes = 0; return bytes;}
+
+    void resumeTask() {
+        resuming = true;
+        try {
+            task.resume();
+        }
+        catch (...) {
+            resuming = false;
+            state = DONE;
+            throw;
+        }
+        resuming = false;
+        if (task.isDone())
+            state = DONE;
+    }
+
+  protected:
+    /**
+     * Awaitable returned by coWait() and coWaitAndEnqueue().
+     */
+    struct [[nodiscard]] WaitAwaiter {
+        cCoroutineModule *module;
+        simtime_t delay;
+        cQueue *queue;
+        bool await_ready() const noexcept {return false;}
+        void await_suspend(std::coroutine_handle<>) {
+            module->waitQueue = queue;
+            module->scheduleAfter(delay, module->timerMessage);
+            module->state = WAITING;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * Awaitable returned by coReceive(). co_await yields the received message,
+     * or nullptr on timeout.
+     */
+    struct [[nodiscard]] ReceiveAwaiter {
+        cCoroutineModule *module;
+        simtime_t timeout;  // negative: no timeout
+        bool await_ready() const noexcept {return false;}
+        void await_suspend(std::coroutine_handle<>) {
+            if (timeout >= SIMTIME_ZERO)
+                module->scheduleAfter(timeout, module->timerMessage);
+            module->state = RECEIVING;
+        }
+        cMessage *await_resume() noexcept {
+            cMessage *msg = module->receivedMessage;
+            module->receivedMessage = nullptr;
+            return msg;
+        }
+    };
+
+    /** @name Coroutine body and awaitable operations. */
+    //@{
+    /**
+     * The module body, to be redefined as a coroutine. It is started when
+     * the module's starter message arrives, and the module behaves as
+     * terminated when it returns.
+     */
+    virtual Task coActivity() = 0;
+
+    /**
+     * Suspends the coroutine for the given interval of simulation time.
+     * The interval may be zero. Receiving a message during the wait is
+     * an error.
+     */
+    WaitAwaiter coWait(simtime_t delay) {
+        if (delay < SIMTIME_ZERO)
+            throw cRuntimeError(this, "coWait(): Negative delay");
+        return WaitAwaiter{this, delay, nullptr};
+    }
+
+    /**
+     * Like coWait(), but messages that arrive during the wait are inserted
+     * into the given queue.
+     */
+    WaitAwaiter coWaitAndEnqueue(simtime_t delay, cQueue *queue) {
+        if (delay < SIMTIME_ZERO)
+            throw cRuntimeError(this, "coWaitAndEnqueue(): Negative delay");
+        if (!queue)
+            throw cRuntimeError(this, "coWaitAndEnqueue(): Queue pointer is nullptr");
+        return WaitAwaiter{this, delay, queue};
+    }
+
+    /**
+     * Suspends the coroutine until a message arrives; co_await returns
+     * the message.
+     */
+    ReceiveAwaiter coReceive() {return ReceiveAwaiter{this, -1};}
+
+    /**
+     * Suspends the coroutine until a message arrives or the timeout
+     * expires; co_await returns the message, or nullptr on timeout.
+     */
+    ReceiveAwaiter coReceive(simtime_t timeout) {
+        if (timeout < SIMTIME_ZERO)
+            throw cRuntimeError(this, "coReceive(): Negative timeout");
+        return ReceiveAwaiter{this, timeout};
+    }
+    //@}
+
+    /**
+     * Resumes the coroutine with the given message. Should not be redefined.
+     */
+    virtual void handleMessage(cMessage *msg) override {
+        if (msg == timerMessage) {
+            switch (state) {
+                case NOT_STARTED:
+                    timerMessage->setName("timeout");
+                    state = RUNNING;
+                    task = coActivity();
+                    resumeTask();
+                    break;
+                case WAITING:
+                    state = RUNNING;
+                    resumeTask();
+                    break;
+                case RECEIVING:
+                    state = RUNNING;
+                    receivedMessage = nullptr;
+                    resumeTask();
+                    break;
+                default:
+                    throw cRuntimeError(this, "Internal error: Unexpected timer message");
+            }
+        }
+        else {
+            switch (state) {
+                case WAITING:
+                    if (!waitQueue)
+                        throw cRuntimeError(this, "Message arrived during coWait() call ((%s)%s); if this "
+                                                  "should be allowed, use coWaitAndEnqueue() instead of coWait()",
+                                                  msg->getClassName(), msg->getFullName());
+                    waitQueue->insert(msg);
+                    break;
+                case RECEIVING:
+                    cancelEvent(timerMessage);
+                    state = RUNNING;
+                    receivedMessage = msg;
+                    resumeTask();
+                    break;
+                case DONE:
+                    throw cRuntimeError(this, "Message (%s)%s arrived after the module's coroutine body has ended",
+                                              msg->getClassName(), msg->getFullName());
+                default:
+                    throw cRuntimeError(this, "Message (%s)%s arrived before the module's coroutine body was started",
+                                              msg->getClassName(), msg->getFullName());
+            }
+        }
+    }
+
+  public:
+    /** @name Constructor, destructor. */
+    //@{
+    /**
+     * Constructor.
+     */
+    cCoroutineModule() : cSimpleModule(0) {}
+
+    /**
+     * Destructor. Destroys the coroutine frame.
+     */
+    virtual ~cCoroutineModule() {
+        task.destroy();
+        cancelAndDelete(timerMessage);
+    }
+    //@}
+
+    /** @name Redefined cModule functions. */
+    //@{
+    /**
+     * Creates the starter message that will start coActivity().
+     */
+    virtual void scheduleStart(simtime_t t) override {
+        if (timerMessage != nullptr)
+            throw cRuntimeError(this, "scheduleStart(): Module already started");
+        cSimpleModule::scheduleStart(t);
+        Enter_Method_Silent("scheduleStart()");
+        timerMessage = new cMessage("starter");
+        scheduleAt(t, timerMessage);
+    }
+
+    /**
+     * When invoked from within the coroutine body, throws a
+     * cDeleteModuleException so that the module gets deleted by the
+     * simulation kernel once the coroutine is no longer executing.
+     */
+    virtual void deleteModule() override {
+        if (resuming)
+            throw cDeleteModuleException(this);
+        cSimpleModule::deleteModule();
+    }
+    //@}
+
+    /** @name Statistics. */
+    //@{
+    /**
+     * Returns true if the coroutine body has ended.
+     */
+    bool isCoroutineDone() const {return state == DONE;}
+
+    /**
+     * Returns the total size of the coroutine frames currently allocated
+     * by all cCoroutineModule instances in the program. This corresponds
+     * to the stack memory of activity() modules.
+     */
+    static size_t getTotalFrameSize() {return frameMemory();}
+    //@}
+};
+
+}  // namespace omnetpp
+
+#endif
+#endif
+
+#endif
+
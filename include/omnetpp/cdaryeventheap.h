@@ -0,0 +1,201 @@
+//==========================================================================
+//  CDARYEVENTHEAP.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_CDARYEVENTHEAP_H
+#define __OMNETPP_CDARYEVENTHEAP_H
+
+#include "cfutureeventset.h"
+
+namespace omnetpp {
+
+/**
+ * @brief A cache-friendly, 4-ary heap based implementation of the future
+ * event set.
+ *
+ * This class is a variant of cEventHeap with two differences in the
+ * underlying data structure. First, the heap array stores the sort keys
+ * (arrival time, scheduling priority and insertion order) next to the
+ * event pointers, so comparisons during sift operations only touch the
+ * contiguous heap array, and never dereference the event objects. Second,
+ * the heap is 4-ary instead of binary, which halves the height of the tree,
+ * and the children of a node are adjacent in memory.
+ *
+ * Events are served in exactly the same order as with cEventHeap, so
+ * simulation results and fingerprints do not depend on the choice of the
+ * FES class. Like cEventHeap, this class employs a circular buffer for
+ * events inserted for the current simulation time with zero priority.
+ * To use it, add the following line to the ini file:
+ *
+ * <pre>
+ * futureeventset-class = omnetpp::cDaryEventHeap
+ * </pre>
+ *
+ * @ingroup SimSupport
+ */
+class SIM_API cDaryEventHeap : public cFutureEventSet
+{
+  private:
+    struct Entry {
+        int64_t time;    // arrival time (raw)
+        uint64_t order;  // scheduling priority in the upper 16 bits, insertion order in the rest
+        cEvent *event;
+        bool operator<(const Entry& other) const {return time < other.time || (time == other.time && order < other.order);}
+    };
+
+    // heap data structure
+    Entry *heap;              // heap array (0-based)
+    int heapLength;           // number of elements on the heap
+    int heapCapacity;         // allocated size of the heap[] array
+    eventnumber_t insertCount; // counts insertions; needed because heap's insert is not stable (does not keep order)
+
+    // circular buffer for events scheduled for the current simtime (quite frequent); acts as FIFO
+    cEvent **cb;              // size of the circular buffer
+    int cbsize;               // always power of 2
+    int cbhead, cbtail;       // cbhead is inclusive, cbtail is exclusive
+
+  private:
+    void copy(const cDaryEventHeap& other);
+
+    int cblength() const  {return (cbtail-cbhead) & (cbsize-1);}
+    void cbgrow();
+    void cbInsert(cEvent *event);
+    void flushCb();
+
+    Entry makeEntry(cEvent *event) const;
+    void heapInsert(cEvent *event);
+    void siftUp(int pos, const Entry& entry);
+    void siftDown(int pos, const Entry& entry);
+    void renumber();
+
+  public:
+    /** @name Constructors, destructor, assignment */
+    //@{
+
+    /**
+     * Copy constructor.
+     */
+    cDaryEventHeap(const cDaryEventHeap& other);
+
+    /**
+     * Constructor.
+     */
+    cDaryEventHeap(const char *name=nullptr, int initialCapacity=128);
+
+    /**
+     * Destructor.
+     */
+    virtual ~cDaryEventHeap();
+
+    /**
+     * Assignment operator. The name member is not copied;
+     * see cOwnedObject's operator=() for more details.
+     */
+    cDaryEventHeap& operator=(const cDaryEventHeap& other);
+    //@}
+
+    /** @name Redefined cObject member functions. */
+    //@{
+
+    /**
+     * Creates and returns an exact copy of this object.
+     * See cObject for more details.
+     */
+    virtual cDaryEventHeap *dup() const override  {return new cDaryEventHeap(*this);}
+
+    /**
+     * Produces a one-line description of the object's contents.
+     * See cObject for more details.
+     */
+    virtual std::string str() const override;
+
+    /**
+     * Calls v->visit(this) for each contained object.
+     * See cObject for more details.
+     */
+    virtual void forEachChild(cVisitor *v) override;
+
+    // no parsimPack() and parsimUnpack()
+    //@}
+
+    /** @name Simulation-related operations. */
+    //@{
+    /**
+     * Insert an event into the FES.
+     */
+    virtual void insert(cEvent *event) override;
+
+    /**
+     * Peek the first event in the FES (the one with the smallest timestamp.)
+     * If the FES is empty, it returns nullptr.
+     */
+    virtual cEvent *peekFirst() const override;
+
+    /**
+     * Removes and return the first event in the FES (the one with the
+     * smallest timestamp.) If the FES is empty, it returns nullptr.
+     */
+    virtual cEvent *removeFirst() override;
+
+    /**
+     * Undo for removeFirst(): it puts back an event to the front of the FES.
+     */
+    virtual void putBackFirst(cEvent *event) override;
+
+    /**
+     * Removes and returns the given event in the FES. If the event is
+     * not in the FES, returns nullptr.
+     */
+    virtual cEvent *remove(cEvent *event) override;
+
+    /**
+     * Returns true if the FES is empty.
+     */
+    virtual bool isEmpty() const override {return cbhead==cbtail && heapLength==0;}
+
+    /**
+     * Deletes all events in the FES.
+     */
+    virtual void clear() override;
+    //@}
+
+    /** @name Random access. */
+    //@{
+
+    /**
+     * Returns the number of events in the FES.
+     */
+    virtual int getLength() const override {return cblength() + heapLength;}
+
+    /**
+     * Returns the kth event in the FES if 0 <= k < getLength(), and nullptr
+     * otherwise. Note that iteration does not necessarily return events
+     * in increasing timestamp (getArrivalTime()) order unless you called
+     * sort() before.
+     */
+    virtual cEvent *get(int k) override;
+
+    /**
+     * Sorts the contents of the FES. This is only necessary if one wants
+     * to iterate through in the FES in strict timestamp order.
+     */
+    virtual void sort() override;
+    //@}
+};
+
+}  // namespace omnetpp
+
+
+#endif
+
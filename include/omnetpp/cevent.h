@@ -23,6 +23,8 @@ namespace omnetpp {
 class cMessage;
 class cPacket;
 class cEventHeap;
+class cCalendarQueue;
+class cDaryEventHeap;
 
 /**
  * @brief Represents an event in the discrete event simulator.
@@ -45,8 +47,10 @@ class cEventHeap;
  */
 class SIM_API cEvent : public cOwnedObject
 {
-    friend class cMessage;     // getArrivalTime()
-    friend class cEventHeap;   // heapIndex
+    friend class cMessage;       // getArrivalTime()
+    friend class cEventHeap;     // heapIndex
+    friend class cCalendarQueue; // heapIndex
+    friend class cDaryEventHeap; // heapIndex
   private:
     simtime_t arrivalTime;     // time of delivery -- set internally
     short priority;            // priority -- used for scheduling events with equal arrival times
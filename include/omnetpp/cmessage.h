@@ -121,6 +121,9 @@ class SIM_API cMessage : public cEvent
     static long totalMsgCount;
     static long liveMsgCount;
 
+    // message pooling
+    static bool poolingEnabled;
+
   private:
     // internal: create parlist
     void _createparlist();
@@ -635,9 +638,60 @@ class SIM_API cMessage : public cEvent
     static long getLiveMessageCount() {return liveMsgCount;}
 
     /**
-     * Reset counters used by getTotalMessageCount() and getLiveMessageCount().
+     * Reset counters used by getTotalMessageCount() and getLiveMessageCount(),
+     * and the message pool statistics.
+     */
+    static void resetMessageCounters();
+    //@}
+
+    /** @name Memory pooling. */
+    //@{
+    /**
+     * Allocation function for message classes that use pooling. Pooling is
+     * opt-in: classes generated from .msg files request it with the
+     * <tt>@pooled</tt> class property, which makes the generated operator new()
+     * call this function; cMessage and cPacket themselves are not pooled.
+     * When pooling is enabled, memory blocks released by deleted messages
+     * are kept on per-size free lists, and are reused for new messages of
+     * the same size instead of going through the global allocator. Messages
+     * created from recycled memory are constructed normally, i.e. they
+     * receive a new, unique message ID.
+     */
+    static void *allocateFromPool(size_t size);
+
+    /**
+     * Deallocation function for pooled message classes, the counterpart of
+     * allocateFromPool(). The size must be that of the object's dynamic type,
+     * as passed to a sized class-specific operator delete().
+     */
+    static void releaseToPool(void *p, size_t size);
+
+    /**
+     * Enables or disables message pooling. Pooling is off by default;
+     * it is normally turned on via the <tt>message-pooling</tt> configuration
+     * option. The setting can be changed at any time, because blocks are
+     * interchangeable between the pool and the global allocator.
+     */
+    static void setPoolingEnabled(bool enabled) {poolingEnabled = enabled;}
+
+    /**
+     * Returns true if message pooling is enabled.
+     */
+    static bool isPoolingEnabled() {return poolingEnabled;}
+
+    /**
+     * Returns the number of message allocations that were made with pooling
+     * enabled since the last reset (see resetMessageCounters()).
+     */
+    static int64_t getPoolAllocationCount();
+
+    /**
+     * Returns the number of message allocations that could be served from
+     * the pool (i.e. reused the memory of a previously deleted message) since
+     * the last reset. Divided by getPoolAllocationCount(), it gives the hit
+     * rate of the pool.
      */
-    static void resetMessageCounters()  {totalMsgCount=liveMsgCount=0;}
+    static int64_t getPoolHitCount();
     //@}
 };
 
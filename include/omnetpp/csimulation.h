@@ -67,10 +67,11 @@ class SIM_API cSimulation : public cNamedObject, noncopyable
     static cSimulation *activeSimulation;
     static cEnvir *activeEnvir;
     static cEnvir *staticEnvir; // the environment to activate when activeSimulation becomes nullptr
+    static int numNetworks;     // number of simulation instances that currently have a system module
 
     // variables of the module vector
     int size;                 // size of componentv[]
-    int delta;                // if needed, grows by delta
+    int delta;                // if needed, grows by at least delta (doubles otherwise)
     cComponent **componentv;  // vector of modules/channels, componentv[0] is not used
     int lastComponentId;      // index of last used pos. in componentv[]
 #ifdef USE_OMNETPP4x_FINGERPRINTS
@@ -18,6 +18,7 @@
 #ifndef __OMNETPP_CSTATISTICBUILDER_H
 #define __OMNETPP_CSTATISTICBUILDER_H
 
+#include <map>
 #include "omnetpp/clistener.h"
 #include "omnetpp/cproperty.h"
 
@@ -28,6 +29,7 @@ extern const char *PROPKEY_STATISTIC_RECORD;
 extern const char *PROPKEY_STATISTIC_CHECKSIGNALS;
 
 class cConfiguration;
+class cResultRecorderType;
 struct SignalSource;
 
 /**
@@ -39,6 +41,18 @@ class SIM_API cStatisticBuilder
         enum TristateBool {TRISTATE_TRUE=1, TRISTATE_FALSE=0, TRISTATE_DEFAULT=-1};  // for internal use only
 
     private:
+        // The parts of the recording setup that only depend on the @statistic
+        // property and the configured result-recording-modes value, cached
+        // so that components of the same type only need to instantiate them
+        struct Plan {
+            TristateBool checkSignalDecl = TRISTATE_DEFAULT;
+            TristateBool warmupAttr = TRISTATE_DEFAULT;
+            std::vector<std::string> modes;
+            std::vector<cResultRecorderType*> recorderTypes; // per mode; nullptr for expressions
+        };
+        typedef std::pair<cProperty*,std::string> PlanKey;
+        static std::map<PlanKey,Plan> plans;
+
         cConfiguration *config;
 
     public:
@@ -56,6 +70,13 @@ class SIM_API cStatisticBuilder
          */
         void addResultRecorders(cComponent *component, simsignal_t signal, const char *statisticName, cProperty *statisticTemplateProperty);
 
+        /**
+         * Discards the cached recording plans. Plans are keyed by the
+         * component's @statistic property, which is kept alive by its NED
+         * declaration, so this is only needed on shutdown.
+         */
+        static void clearPlans();
+
     protected:
         // Utility function: adds result recording listeners for the given signal (if it's non-null) or for the given @statistic property.
         // If signal is specified, it will override the source= key in statisticProperty.
@@ -63,9 +84,11 @@ class SIM_API cStatisticBuilder
         void doAddResultRecorders(cComponent *component, std::string& componentFullPath, const char *statisticName, cProperty *statisticProperty, simsignal_t signal=SIMSIGNAL_NULL);
 
         // Utility functions for addResultRecorders()
+        const Plan& getPlan(cProperty *statisticProperty, const std::string& modesOption);
+        Plan makePlan(cProperty *statisticProperty, const std::string& modesOption);
         std::vector<std::string> extractRecorderList(const char *modesOption, cProperty *statisticProperty);
         SignalSource doStatisticSource(cComponent *component, cProperty *statisticProperty, const char *statisticName, const char *sourceSpec, TristateBool checkSignalDecl, bool needWarmupFilter);
-        void doResultRecorder(const SignalSource& source, const char *mode, cComponent *component, const char *statisticName, cProperty *attrsProperty);
+        void doResultRecorder(const SignalSource& source, const char *mode, cResultRecorderType *recorderType, cComponent *component, const char *statisticName, cProperty *attrsProperty);
         TristateBool parseTristateBool(const char *s, const char *what);
 };
 
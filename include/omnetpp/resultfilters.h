@@ -388,6 +388,110 @@ class SIM_API SumPerDurationFilter : public cNumericResultFilter
         virtual std::string str() const override;
 };
 
+/**
+ * @brief Base class for result filters that divide simulation time into
+ * intervals of equal length (buckets), and output one value per non-empty
+ * bucket, computed from the values that fall into it. The output is
+ * timestamped with the start time of the bucket, and is emitted when the
+ * first value of a later bucket arrives, or at finish() for the last bucket.
+ * NaN values in the input are ignored.
+ *
+ * The bucket length is taken from the `bucketInterval` attribute of the
+ * @statistic property (e.g. `bucketInterval=1s`), which can be overridden
+ * with the `result-bucket-interval` per-statistic configuration option.
+ */
+class SIM_API TimeBucketFilter : public cNumericResultFilter
+{
+    protected:
+        simtime_t bucketInterval;
+        int64_t bucketIndex = -1;  // index of the current bucket; -1 before the first value
+        intval_t count = 0;
+        double sum = 0;
+        double min = INFINITY;
+        double max = -INFINITY;
+    protected:
+        virtual bool process(simtime_t& t, double& value, cObject *details) override;
+        virtual void finish(cResultFilter *prev) override;
+        virtual double getBucketValue() const = 0;
+        void collect(double value);
+        simtime_t getBucketStartTime() const {return bucketInterval * bucketIndex;}
+    public:
+        virtual void init(cComponent *component, cProperty *attrsProperty) override;
+        simtime_t_cref getBucketInterval() const {return bucketInterval;}
+        virtual std::string str() const override;
+};
+
+/**
+ * @brief Time bucket filter that outputs the number of values in each bucket.
+ */
+class SIM_API BucketCountFilter : public TimeBucketFilter
+{
+    protected:
+        virtual double getBucketValue() const override {return count;}
+};
+
+/**
+ * @brief Time bucket filter that outputs the minimum of the values in each bucket.
+ */
+class SIM_API BucketMinFilter : public TimeBucketFilter
+{
+    protected:
+        virtual double getBucketValue() const override {return min;}
+};
+
+/**
+ * @brief Time bucket filter that outputs the maximum of the values in each bucket.
+ */
+class SIM_API BucketMaxFilter : public TimeBucketFilter
+{
+    protected:
+        virtual double getBucketValue() const override {return max;}
+};
+
+/**
+ * @brief Time bucket filter that outputs the arithmetic mean of the values
+ * in each bucket.
+ */
+class SIM_API BucketMeanFilter : public TimeBucketFilter
+{
+    protected:
+        virtual double getBucketValue() const override {return sum / count;}
+};
+
+/**
+ * @brief Filter that downsamples its input with the Largest-Triangle-Three-Buckets
+ * (LTTB) algorithm, so that a line plot of the output looks nearly the same
+ * as that of the input. Simulation time is divided into buckets like with
+ * TimeBucketFilter, and one input value (with its original timestamp) is
+ * let through from every non-empty bucket: the one that forms the largest
+ * triangle with the previously selected value and the average of the next
+ * non-empty bucket. The first and the last values are always let through.
+ * Values are delayed by up to two bucket lengths, and the values of two
+ * buckets are kept in memory. NaN values in the input are ignored.
+ */
+class SIM_API LttbFilter : public cNumericResultFilter
+{
+    protected:
+        struct Point {
+            simtime_t t;
+            double value;
+        };
+        simtime_t bucketInterval;
+        int64_t bucketIndex = -1;      // index of the bucket being filled; -1 before the first value
+        bool hasSelected = false;
+        Point lastSelected;            // the value let through most recently
+        std::vector<Point> pendingBucket; // complete bucket, waiting for the next one to fill up
+        std::vector<Point> currentBucket; // bucket being filled, except the very first value
+    protected:
+        virtual bool process(simtime_t& t, double& value, cObject *details) override;
+        virtual void finish(cResultFilter *prev) override;
+        const Point& selectFromPendingBucket() const;
+    public:
+        virtual void init(cComponent *component, cProperty *attrsProperty) override;
+        simtime_t_cref getBucketInterval() const {return bucketInterval;}
+        virtual std::string str() const override;
+};
+
 }  // namespace omnetpp
 
 #endif
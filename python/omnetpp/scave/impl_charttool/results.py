@@ -13,6 +13,16 @@ using the opp_scavetool program to load the .sca and .vec files.
 # TODO: document
 inputfiles = list()
 
+# number of threads opp_scavetool may use for loading the input files; 0 means one per CPU core.
+# The default is 1 like in opp_scavetool, as chart scripts may run in parallel themselves.
+num_jobs = 1
+
+# whether opp_scavetool should use (and create) binary cache files next to the result files
+use_cache = False
+
+def _load_options():
+    return ["-J", str(num_jobs)] + (["--cache"] if use_cache else [])
+
 
 def _parse_int(s):
     return int(s) if s else None
@@ -39,7 +49,7 @@ def _get_results(filter_expression, file_extensions, result_type, *additional_ar
     filelist = [i for i in inputfiles if any([i.endswith(e) for e in file_extensions])]
     type_filter = ['-T', result_type] if result_type else []
 
-    command = ["opp_scavetool", "x", *filelist, *type_filter, '-f',
+    command = ["opp_scavetool", "x", *_load_options(), *filelist, *type_filter, '-f',
                 filter_expression, "-F", "CSV-R", "-o", "-", *additional_args]
 
     output = subprocess.check_output(command)
@@ -151,7 +161,7 @@ def _get_metadata(filter_expression="", include_runattrs=False, include_itervars
     pass
 
 def get_runs(filter_expression="", include_runattrs=False, include_itervars=False, include_param_assignments=False, include_config_entries=False):
-    command = ["opp_scavetool", "q", *inputfiles, "-r", '-f',
+    command = ["opp_scavetool", "q", *_load_options(), *inputfiles, "-r", '-f',
                 filter_expression, "-g"]
 
     output = subprocess.check_output(command)
@@ -188,7 +198,7 @@ def get_runs(filter_expression="", include_runattrs=False, include_itervars=Fals
     return df
 
 def get_runattrs(filter_expression="", include_runattrs=False, include_itervars=False, include_param_assignments=False, include_config_entries=False):
-    command = ["opp_scavetool", "q", *inputfiles, "-a", "-g", "--tabs"]
+    command = ["opp_scavetool", "q", *_load_options(), *inputfiles, "-a", "-g", "--tabs"]
 
     output = subprocess.check_output(command)
 
@@ -217,7 +227,7 @@ def get_runattrs(filter_expression="", include_runattrs=False, include_itervars=
 
 
 def get_itervars(filter_expression="", include_runattrs=False, include_itervars=False, include_param_assignments=False, include_config_entries=False, as_numeric=False):
-    command = ["opp_scavetool", "q", *inputfiles, "-i", "-g", "--tabs"]
+    command = ["opp_scavetool", "q", *_load_options(), *inputfiles, "-i", "-g", "--tabs"]
 
     output = subprocess.check_output(command)
 
@@ -245,7 +255,7 @@ def get_itervars(filter_expression="", include_runattrs=False, include_itervars=
     return df
 
 def get_config_entries(filter_expression, include_runattrs=False, include_itervars=False, include_param_assignments=False, include_config_entries=False):
-    command = ["opp_scavetool", "q", *inputfiles, "-j", "-g", "--tabs"]
+    command = ["opp_scavetool", "q", *_load_options(), *inputfiles, "-j", "-g", "--tabs"]
 
     output = subprocess.check_output(command)
 
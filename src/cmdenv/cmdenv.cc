@@ -502,6 +502,14 @@ void Cmdenv::doStatusUpdate(Speedometer& speedometer)
         out << "     Messages:  created: " << cMessage::getTotalMessageCount()
             << "   present: " << cMessage::getLiveMessageCount()
             << "   in FES: " << getSimulation()->getFES()->getLength() << endl;
+
+        if (cMessage::isPoolingEnabled()) {
+            int64_t allocations = cMessage::getPoolAllocationCount();
+            int64_t hits = cMessage::getPoolHitCount();
+            out << "     Pool:      allocations: " << allocations
+                << "   reused: " << hits
+                << "   hit rate: " << (allocations == 0 ? 0 : (int)(100.0 * hits / allocations)) << "%" << endl;
+        }
     }
     else {
         out << "** Event #" << getSimulation()->getEventNumber() << "   t=" << getSimulation()->getSimTime()
@@ -0,0 +1,151 @@
+//==========================================================================
+//  BACKGROUNDWORKER.CC - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <system_error>
+#include "exception.h"
+#include "backgroundworker.h"
+
+namespace omnetpp {
+namespace common {
+
+// Sleeping and waking up uses the usual flag protocol: the sleeping side sets
+// its flag and then re-checks the queue state, the other side updates the queue
+// state and then checks the flag (all sequentially consistent), so at least one
+// of them sees the other's write. Notification happens under the mutex, so it
+// cannot slip in between the predicate check and the wait.
+
+BackgroundWorker::BackgroundWorker(size_t queueLength, size_t costLimit) :
+    costLimit(costLimit), head(0), tail(0), queuedCost(0),
+    workerSleeping(false), producerSleeping(false), stopRequested(false), failed(false)
+{
+    size_t capacity = 2;
+    while (capacity < queueLength)
+        capacity *= 2;
+    ring.resize(capacity);
+    mask = capacity - 1;
+
+    try {
+        thread = std::thread(&BackgroundWorker::run, this);
+    }
+    catch (std::system_error& e) {
+        throw opp_runtime_error("Cannot start background thread: %s", e.what());
+    }
+}
+
+BackgroundWorker::~BackgroundWorker()
+{
+    stopRequested.store(true);
+    wakeWorker();
+    thread.join();
+}
+
+void BackgroundWorker::run()
+{
+    for (;;) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load()) {
+            // the producer sets stopRequested after its last submit, so check it first
+            if (stopRequested.load() && h == tail.load())
+                break;
+            std::unique_lock<std::mutex> lock(mutex);
+            workerSleeping.store(true);
+            workerWakeup.wait(lock, [&] {return h != tail.load() || stopRequested.load();});
+            workerSleeping.store(false);
+            continue;
+        }
+
+        Slot& slot = ring[h & mask];
+        Task task = std::move(slot.task);
+        slot.task = nullptr;
+        size_t cost = slot.cost;
+        if (!failed.load(std::memory_order_relaxed)) {
+            try {
+                task();
+            }
+            catch (...) {
+                error = std::current_exception();
+                failed.store(true);
+            }
+        }
+        task = nullptr;  // release the data held by the task before accounting for it
+
+        queuedCost.fetch_sub(cost);
+        head.store(h + 1);
+        if (producerSleeping.load())
+            wakeProducer();
+    }
+}
+
+void BackgroundWorker::wakeWorker()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    workerWakeup.notify_one();
+}
+
+void BackgroundWorker::wakeProducer()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    producerWakeup.notify_one();
+}
+
+void BackgroundWorker::waitUntil(const std::function<bool()>& condition)
+{
+    if (condition())
+        return;
+    std::unique_lock<std::mutex> lock(mutex);
+    producerSleeping.store(true);
+    producerWakeup.wait(lock, condition);
+    producerSleeping.store(false);
+}
+
+void BackgroundWorker::submit(size_t cost, Task task)
+{
+    checkError();
+    if (failed.load())
+        return;  // error already reported; the task would be discarded anyway
+
+    size_t t = tail.load(std::memory_order_relaxed);
+    waitUntil([&] {
+        size_t h = head.load();
+        return h == t || (t - h <= mask && queuedCost.load() + cost <= costLimit);
+    });
+
+    Slot& slot = ring[t & mask];
+    slot.task = std::move(task);
+    slot.cost = cost;
+    queuedCost.fetch_add(cost);
+    tail.store(t + 1);
+    if (workerSleeping.load())
+        wakeWorker();
+}
+
+void BackgroundWorker::flush()
+{
+    size_t t = tail.load(std::memory_order_relaxed);
+    waitUntil([&] {return head.load() == t;});
+    checkError();
+}
+
+void BackgroundWorker::checkError()
+{
+    if (failed.load() && error) {
+        std::exception_ptr e = error;
+        error = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+}  // namespace common
+}  // namespace omnetpp
+
@@ -0,0 +1,128 @@
+//==========================================================================
+//  BACKGROUNDWORKER.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_COMMON_BACKGROUNDWORKER_H
+#define __OMNETPP_COMMON_BACKGROUNDWORKER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "commondefs.h"
+
+namespace omnetpp {
+namespace common {
+
+/**
+ * Executes tasks in a background thread, in the order they were submitted.
+ * It is meant for moving expensive output operations (formatting,
+ * compression, file writes) off the simulation thread.
+ *
+ * Tasks are passed to the thread via a bounded single-producer single-consumer
+ * lock-free ring buffer, so submit() must always be called from the same
+ * thread. Each task has a cost (typically the number of bytes of data it
+ * holds); when the total cost of the queued tasks would exceed the limit, or
+ * the ring buffer is full, submit() blocks until the thread catches up.
+ * Threads only sleep on a condition variable when there is nothing to do.
+ *
+ * If a task throws, the exception is rethrown in the submitting thread by the
+ * next submit(), flush() or checkError() call, and the remaining tasks
+ * (including ones submitted later) are discarded.
+ */
+class COMMON_API BackgroundWorker
+{
+  public:
+    typedef std::function<void()> Task;
+
+  protected:
+    struct Slot {
+        Task task;
+        size_t cost = 0;
+    };
+
+    std::vector<Slot> ring;  // size is a power of two
+    size_t mask;
+    size_t costLimit;
+
+    // head: the next task to execute (written by the worker); tail: the next
+    // free slot (written by the producer); both increase monotonically
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+    std::atomic<size_t> queuedCost;
+
+    std::atomic<bool> workerSleeping;
+    std::atomic<bool> producerSleeping;
+    std::atomic<bool> stopRequested;
+    std::atomic<bool> failed;
+    std::exception_ptr error;  // written by the worker before setting 'failed'
+    std::mutex mutex;
+    std::condition_variable workerWakeup;
+    std::condition_variable producerWakeup;
+
+    std::thread thread;
+
+  protected:
+    void run();
+    void wakeWorker();
+    void wakeProducer();
+    void waitUntil(const std::function<bool()>& condition);
+
+  public:
+    /**
+     * Starts the thread. queueLength is the maximum number of queued tasks
+     * (rounded up to a power of two), costLimit the maximum total cost of
+     * the queued tasks. A single task is always accepted into an empty
+     * queue, regardless of its cost.
+     */
+    BackgroundWorker(size_t queueLength, size_t costLimit);
+
+    /**
+     * Executes the remaining tasks, and stops the thread. Errors are ignored.
+     */
+    virtual ~BackgroundWorker();
+
+    /**
+     * Appends a task to the queue, blocking while the queue is full.
+     */
+    void submit(size_t cost, Task task);
+
+    /**
+     * Waits until all submitted tasks have been executed.
+     */
+    void flush();
+
+    /**
+     * Rethrows the exception thrown by a task, if there was one.
+     * The exception is only reported once.
+     */
+    void checkError();
+
+    /**
+     * Returns true if a task has thrown an exception.
+     */
+    bool hasFailed() const {return failed.load();}
+
+    /**
+     * Returns the total cost of the tasks not yet executed.
+     */
+    size_t getQueuedCost() const {return queuedCost.load();}
+};
+
+}  // namespace common
+}  // namespace omnetpp
+
+#endif
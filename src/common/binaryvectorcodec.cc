@@ -0,0 +1,216 @@
+//==========================================================================
+//  BINARYVECTORCODEC.CC - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include "exception.h"
+#include "lz4codec.h"
+#include "binaryvectorcodec.h"
+
+namespace omnetpp {
+namespace common {
+
+#define MAX_VARINT_LENGTH    10
+#define MAX_HEADER_LENGTH    256
+
+static inline char *writeVarint(char *p, uint64_t x)
+{
+    while (x >= 0x80) {
+        *p++ = (char)(x | 0x80);
+        x >>= 7;
+    }
+    *p++ = (char)x;
+    return p;
+}
+
+static inline const char *readVarint(const char *p, const char *end, uint64_t& x)
+{
+    x = 0;
+    for (int shift = 0; p < end && shift < 7 * MAX_VARINT_LENGTH; shift += 7) {
+        uint8_t b = *p++;
+        x |= (uint64_t)(b & 0x7f) << shift;
+        if ((b & 0x80) == 0)
+            return p;
+    }
+    return nullptr;
+}
+
+// zigzag encoding maps small negative differences to small unsigned numbers as well
+static inline uint64_t zigzag(uint64_t x) { return (x << 1) ^ (uint64_t)((int64_t)x >> 63); }
+static inline uint64_t unzigzag(uint64_t x) { return (x >> 1) ^ (~(x & 1) + 1); }
+
+// store the bytes of n 8-byte elements transposed: byte k of element i goes to dest[k*n+i]
+static void shuffle(char *dest, const void *src, int n)
+{
+    const char *s = (const char *)src;
+    for (int i = 0; i < n; i++)
+        for (int k = 0; k < 8; k++)
+            dest[k*n + i] = s[i*8 + k];
+}
+
+static void unshuffle(void *dest, const char *src, int n)
+{
+    char *d = (char *)dest;
+    for (int k = 0; k < 8; k++)
+        for (int i = 0; i < n; i++)
+            d[i*8 + k] = src[k*n + i];
+}
+
+void BinaryVectorCodec::encodePayload(char *dest, size_t& length, int count, const int64_t *eventNumbers, const int64_t *rawTimes, const double *values, bool shuffled)
+{
+    char *p = dest;
+    if (eventNumbers) {
+        uint64_t prev = 0;
+        for (int i = 0; i < count; i++) {
+            p = writeVarint(p, zigzag((uint64_t)eventNumbers[i] - prev));
+            prev = eventNumbers[i];
+        }
+    }
+    size_t columnLength = (size_t)count * 8;
+    if (shuffled) {
+        shuffle(p, rawTimes, count);
+        shuffle(p + columnLength, values, count);
+    }
+    else {
+        memcpy(p, rawTimes, columnLength);
+        memcpy(p + columnLength, values, columnLength);
+    }
+    length = (p - dest) + 2 * columnLength;
+}
+
+const std::string& BinaryVectorCodec::encodeBlock(int vectorId, int simtimeScaleExp, int count, const int64_t *eventNumbers, const int64_t *rawTimes, const double *values, bool compress)
+{
+    rawBuffer.resize((size_t)count * ((eventNumbers ? MAX_VARINT_LENGTH : 0) + 16));
+    size_t rawLength;
+    encodePayload(rawBuffer.data(), rawLength, count, eventNumbers, rawTimes, values, compress);
+
+    const char *payload = rawBuffer.data();
+    size_t payloadLength = rawLength;
+    bool compressed = false;
+    if (compress) {
+        packedBuffer.resize(lz4CompressBound(rawLength));
+        size_t packedLength = lz4Compress(rawBuffer.data(), rawLength, packedBuffer.data());
+        if (packedLength < rawLength) {
+            payload = packedBuffer.data();
+            payloadLength = packedLength;
+            compressed = true;
+        }
+        else {
+            // incompressible data: store it raw (i.e. not shuffled either)
+            encodePayload(rawBuffer.data(), rawLength, count, eventNumbers, rawTimes, values, false);
+        }
+    }
+
+    char header[MAX_HEADER_LENGTH];
+    int headerLength = snprintf(header, sizeof(header), "block %d %s %d %d %s %" PRIu64 " %" PRIu64 "\n",
+            vectorId, eventNumbers ? "ETV" : "TV", count, simtimeScaleExp, compressed ? "lz4" : "raw",
+            (uint64_t)rawLength, (uint64_t)payloadLength);
+    block.assign(header, headerLength);
+    block.append(payload, payloadLength);
+    block.push_back('\n');
+    return block;
+}
+
+bool BinaryVectorCodec::parseBlockHeader(const char *line, size_t length, BlockHeader& header)
+{
+    if (length < 6 || strncmp(line, "block ", 6) != 0)
+        return false;
+    const char *eol = (const char *)memchr(line, '\n', std::min(length, (size_t)MAX_HEADER_LENGTH));
+    if (!eol)
+        return false;
+
+    char buf[MAX_HEADER_LENGTH];
+    size_t lineLength = eol - line;
+    memcpy(buf, line, lineLength);
+    buf[lineLength] = '\0';
+    if (lineLength > 0 && buf[lineLength-1] == '\r')
+        buf[--lineLength] = '\0';
+
+    char columns[8], encoding[8];
+    uint64_t rawLength, payloadLength;
+    int consumed = -1;
+    if (sscanf(buf, "block %d %7s %d %d %7s %" SCNu64 " %" SCNu64 "%n", &header.vectorId, columns, &header.count,
+            &header.simtimeScaleExp, encoding, &rawLength, &payloadLength, &consumed) != 7 || consumed != (int)lineLength)
+        return false;
+    if (header.vectorId < 0 || header.count < 0 || header.simtimeScaleExp < -18 || header.simtimeScaleExp > 0)
+        return false;
+
+    if (strcmp(columns, "ETV") == 0)
+        header.hasEventNumbers = true;
+    else if (strcmp(columns, "TV") == 0)
+        header.hasEventNumbers = false;
+    else
+        return false;
+
+    if (strcmp(encoding, "lz4") == 0)
+        header.compressed = true;
+    else if (strcmp(encoding, "raw") == 0)
+        header.compressed = false;
+    else
+        return false;
+
+    header.rawLength = rawLength;
+    header.payloadLength = payloadLength;
+    header.headerLength = (eol - line) + 1;
+    return true;
+}
+
+void BinaryVectorCodec::decodePayload(const BlockHeader& header, const char *payload, int64_t *eventNumbers, int64_t *rawTimes, double *values)
+{
+    if (header.rawLength > (size_t)header.count * (MAX_VARINT_LENGTH + 16))
+        throw opp_runtime_error("Invalid length in block header of vector %d", header.vectorId);
+
+    const char *data = payload;
+    if (header.compressed) {
+        rawBuffer.resize(header.rawLength);
+        if (!lz4Decompress(payload, header.payloadLength, rawBuffer.data(), header.rawLength))
+            throw opp_runtime_error("Corrupt compressed data in block of vector %d", header.vectorId);
+        data = rawBuffer.data();
+    }
+    else if (header.payloadLength != header.rawLength)
+        throw opp_runtime_error("Inconsistent payload length in block of vector %d", header.vectorId);
+
+    const char *p = data;
+    const char *end = data + header.rawLength;
+    int count = header.count;
+    if (header.hasEventNumbers) {
+        uint64_t prev = 0;
+        for (int i = 0; i < count; i++) {
+            uint64_t x;
+            if ((p = readVarint(p, end, x)) == nullptr)
+                throw opp_runtime_error("Truncated event number column in block of vector %d", header.vectorId);
+            prev += unzigzag(x);
+            if (eventNumbers)
+                eventNumbers[i] = (int64_t)prev;
+        }
+    }
+
+    size_t columnLength = (size_t)count * 8;
+    if ((size_t)(end - p) != 2 * columnLength)
+        throw opp_runtime_error("Wrong payload length in block of vector %d", header.vectorId);
+    if (header.compressed) {
+        unshuffle(rawTimes, p, count);
+        unshuffle(values, p + columnLength, count);
+    }
+    else {
+        memcpy(rawTimes, p, columnLength);
+        memcpy(values, p + columnLength, columnLength);
+    }
+}
+
+}  // namespace common
+}  // namespace omnetpp
+
@@ -0,0 +1,104 @@
+//==========================================================================
+//  BINARYVECTORCODEC.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_COMMON_BINARYVECTORCODEC_H
+#define __OMNETPP_COMMON_BINARYVECTORCODEC_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "commondefs.h"
+
+namespace omnetpp {
+namespace common {
+
+/**
+ * Encodes and decodes the data blocks of binary output vector files
+ * ("version 4" .vec files). Such files are identical to text vector files
+ * (see OmnetppVectorFileWriter) except that each block of vector data
+ * is stored in the following form:
+ *
+ * <pre>
+ * block <vectorId> <columns> <count> <simtimeScaleExp> <encoding> <rawLength> <payloadLength>
+ * <payloadLength bytes of payload>
+ * </pre>
+ *
+ * The header line and the payload are both terminated by a newline, so
+ * line-oriented readers can skip the payload after parsing the header.
+ * The (uncompressed) payload consists of the columns one after another:
+ * event numbers (only if columns is "ETV") as zigzag varints of the
+ * difference from the previous event number, then the raw simulation
+ * times as int64s, then the values as doubles, the latter two in host
+ * byte order (little endian on all supported platforms).
+ *
+ * Encoding is either "raw" (payload as above) or "lz4" (payload is the
+ * LZ4 compressed form of the above, where the bytes of the simtime and
+ * value columns are also transposed, i.e. the first bytes of all elements
+ * come first, then the second bytes, etc. This makes the slowly changing
+ * high-order bytes compress well.) rawLength is the uncompressed length.
+ *
+ * A codec object holds scratch buffers that are reused between calls;
+ * it is not thread-safe.
+ */
+class COMMON_API BinaryVectorCodec
+{
+  public:
+    struct BlockHeader {
+        int vectorId;
+        bool hasEventNumbers;
+        int count;
+        int simtimeScaleExp;
+        bool compressed;
+        size_t rawLength;
+        size_t payloadLength;
+        size_t headerLength;  // length of the header line including the newline
+        size_t getBlockLength() const {return headerLength + payloadLength + 1;}
+    };
+
+  protected:
+    std::string block;
+    std::vector<char> rawBuffer;
+    std::vector<char> packedBuffer;
+
+  protected:
+    void encodePayload(char *dest, size_t& length, int count, const int64_t *eventNumbers, const int64_t *rawTimes, const double *values, bool shuffled);
+
+  public:
+    /**
+     * Encodes the given samples as a complete block (header line, payload,
+     * and trailing newline), and returns it. eventNumbers may be nullptr.
+     * If compression does not make the block smaller, it is stored raw.
+     * The returned reference is valid until the next call.
+     */
+    const std::string& encodeBlock(int vectorId, int simtimeScaleExp, int count, const int64_t *eventNumbers, const int64_t *rawTimes, const double *values, bool compress);
+
+    /**
+     * Parses a block header line, which need not be null-terminated. Returns
+     * false if the buffer does not start with a valid block header line.
+     */
+    static bool parseBlockHeader(const char *line, size_t length, BlockHeader& header);
+
+    /**
+     * Decodes the payload of a block into the given arrays, each of which
+     * must have room for header.count elements. eventNumbers may be nullptr,
+     * and it is not touched if the block has no event numbers. Throws
+     * an exception if the payload is malformed.
+     */
+    void decodePayload(const BlockHeader& header, const char *payload, int64_t *eventNumbers, int64_t *rawTimes, double *values);
+};
+
+}  // namespace common
+}  // namespace omnetpp
+
+#endif
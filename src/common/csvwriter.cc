@@ -18,6 +18,7 @@
 #include "commonutil.h"
 #include "bigdecimal.h"
 #include "opp_ctype.h"
+#include "numberformat.h"
 #include "csvwriter.h"
 
 namespace omnetpp {
@@ -56,7 +57,8 @@ void CsvWriter::writeInt(int64_t value)
 {
     Assert(!insideRaw);
     writeSep();
-    out() << value;
+    char buf[32];
+    out().write(buf, opp_formati64(buf, value) - buf);
     columnNumber++;
 }
 
@@ -102,7 +104,7 @@ void CsvWriter::writeBlank()
 void CsvWriter::writeNewLine()
 {
     Assert(!insideRaw);
-    out() << std::endl;
+    out() << '\n';  // not std::endl, flushing after each line would be slow
     lineNumber++;
     columnNumber = 0;
 }
@@ -142,8 +144,14 @@ void CsvWriter::writeSep()
 
 void CsvWriter::doWriteDouble(double value)
 {
-    if (std::isfinite(value))
-        out() << std::setprecision(prec) << value;
+    if (std::isfinite(value)) {
+        // same as "out() << std::setprecision(prec) << value", only faster
+        char buf[64];
+        if (opp_formatdouble_bufsize(prec) <= (int)sizeof(buf))
+            out().write(buf, opp_formatdouble(buf, value, prec) - buf);
+        else
+            out() << std::setprecision(prec) << value;
+    }
     else if (isPositiveInfinity(value))
         out() << "Inf";
     else if (isNegativeInfinity(value))
@@ -17,6 +17,7 @@
 #define __OMNETPP_COMMON_EXPRVALUE_H
 
 #include <string>
+#include <utility>
 #include "commondefs.h"
 #include "intutil.h"
 #include "stringutil.h"
@@ -99,7 +100,7 @@ class COMMON_API ExprValue
     //@{
     ExprValue() {}
     ExprValue(const ExprValue& other) {operator=(other);}
-    ExprValue(ExprValue&& other) {operator=(other);}
+    ExprValue(ExprValue&& other) {operator=(std::move(other));}
     ExprValue(bool b)  {operator=(b);}
     ExprValue(intval_t l)  {operator=(l);}
     ExprValue(intval_t l, const char *unit)  {setQuantity(l, unit);}
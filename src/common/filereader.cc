@@ -16,6 +16,13 @@
 
 
 #include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define USE_SSE2
+#endif
 #include <sstream>
 #include <cstdio>
 #include <cstdarg>
@@ -32,6 +39,46 @@ namespace common {
 
 // #define TRACE_FILEREADER
 
+/**
+ * Returns a pointer to the first CR or LF in [s,end), or end if there is none.
+ */
+static inline char *findLineEnd(char *s, char *end)
+{
+#ifdef USE_SSE2
+    const __m128i cr = _mm_set1_epi8('\r'), lf = _mm_set1_epi8('\n');
+    while (end - s >= 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)s);
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, cr), _mm_cmpeq_epi8(chunk, lf)));
+        if (mask != 0)
+            return s + __builtin_ctz(mask);
+        s += 16;
+    }
+#endif
+    while (s < end && *s != '\r' && *s != '\n')
+        s++;
+    return s;
+}
+
+/**
+ * Returns a pointer just after the last CR or LF in [begin,s), or begin if there is none.
+ */
+static inline char *findLineStartBackward(char *begin, char *s)
+{
+#ifdef USE_SSE2
+    const __m128i cr = _mm_set1_epi8('\r'), lf = _mm_set1_epi8('\n');
+    while (s - begin >= 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(s - 16));
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, cr), _mm_cmpeq_epi8(chunk, lf)));
+        if (mask != 0)
+            return s - 16 + (32 - __builtin_clz(mask));
+        s -= 16;
+    }
+#endif
+    while (s > begin && s[-1] != '\r' && s[-1] != '\n')
+        s--;
+    return s;
+}
+
 FileChangedError::FileChangedError(FileReader::FileChangedState change, const char *messagefmt, ...) : opp_runtime_error(""), change(change)
 {
     char buf[1024];
@@ -41,7 +88,8 @@ FileChangedError::FileChangedError(FileReader::FileChangedState change, const ch
 
 FileReader::FileReader(const char *fileName, size_t bufferSize)
     : fileName(fileName), bufferSize(bufferSize),
-    bufferBegin(new char[bufferSize]),
+    allocatedBuffer(new char[bufferSize]),
+    bufferBegin(allocatedBuffer),
     bufferEnd(bufferBegin + bufferSize),
     maxLineSize(bufferSize / 2),
     lastSavedBufferBegin(new char[bufferSize])
@@ -55,6 +103,8 @@ FileReader::FileReader(const char *fileName, size_t bufferSize)
     bufferFileOffset = -1;
     enableCheckFileForChanges = true;
     enableIgnoreAppendChanges = true;
+    enableMemoryMapping = false;
+    isMapped = false;
     numReadLines = 0;
     numReadBytes = 0;
     dataBegin = nullptr;
@@ -69,11 +119,19 @@ FileReader::~FileReader()
 #ifdef TRACE_FILEREADER
     TRACE_CALL("FileReader::~FileReader(%s)", fileName.c_str());
 #endif
-    delete[] bufferBegin;
+    unmapFile();
+    delete[] allocatedBuffer;
     delete[] lastSavedBufferBegin;
     ensureFileClosed();
 }
 
+void FileReader::setUseMemoryMapping(bool value)
+{
+    if (file)
+        throw opp_runtime_error("FileReader: Memory mapping must be configured before the file is opened");
+    enableMemoryMapping = value;
+}
+
 void FileReader::ensureFileOpenInternal()
 {
     if (!file) {
@@ -107,7 +165,57 @@ void FileReader::ensureFileOpen()
         ensureFileOpenInternal();
         fileSize = getFileSizeInternal();
         lastSavedSize = readFileEnd(lastSavedBufferBegin);
+        if (enableMemoryMapping)
+            mapFile();
+    }
+}
+
+void FileReader::mapFile()
+{
+    if (isMapped && bufferEnd - bufferBegin == fileSize)
+        return;
+
+    // the current position must survive remapping
+    file_offset_t currentOffset = currentDataPointer ? std::min((int64_t)(currentDataPointer - bufferBegin + bufferFileOffset), fileSize) : 0;
+    bool wasMapped = isMapped;
+    int64_t oldMappedSize = isMapped ? bufferEnd - bufferBegin : 0;
+    unmapFile();
+
+#ifndef _WIN32
+    if (fileSize > 0 && (uint64_t)fileSize <= SIZE_MAX) {
+        void *data = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(file), 0);
+        if (data != MAP_FAILED) {
+            isMapped = true;
+            bufferBegin = (const char *)data;
+            bufferEnd = bufferBegin + fileSize;
+            bufferFileOffset = 0;
+            dataBegin = (char *)bufferBegin;
+            dataEnd = (char *)bufferEnd;
+            setCurrentDataPointer(dataBegin + currentOffset);
+            numReadBytes += fileSize - oldMappedSize;  // as if it was read in
+            return;
+        }
     }
+#endif
+
+    // fall back to buffered mode
+    if (wasMapped) {
+        bufferFileOffset = -1;
+        dataBegin = dataEnd = currentDataPointer = nullptr;
+        seekTo(currentOffset);
+    }
+}
+
+void FileReader::unmapFile()
+{
+#ifndef _WIN32
+    if (isMapped) {
+        munmap((void *)bufferBegin, bufferEnd - bufferBegin);
+        isMapped = false;
+        bufferBegin = allocatedBuffer;
+        bufferEnd = bufferBegin + bufferSize;
+    }
+#endif
 }
 
 void FileReader::ensureFileClosed()
@@ -128,7 +236,7 @@ file_offset_t FileReader::pointerToFileOffset(char *pointer) const
 
 void FileReader::checkConsistency(bool checkDataPointer) const
 {
-    bool ok = (size_t)(bufferEnd - bufferBegin) == bufferSize &&
+    bool ok = (isMapped || (size_t)(bufferEnd - bufferBegin) == bufferSize) &&
         ((!dataBegin && !dataEnd) ||
          (dataBegin <= dataEnd && bufferBegin <= dataBegin && dataEnd <= bufferEnd &&
           (!checkDataPointer || (dataBegin <= currentDataPointer && currentDataPointer <= dataEnd))));
@@ -146,10 +254,10 @@ FileReader::FileChangedState FileReader::checkFileForChanges()
 #ifdef TRACE_FILEREADER
         int readBytes =
 #endif
-            readFileEnd((void *)bufferBegin);
+            readFileEnd(allocatedBuffer);
         dataBegin = dataEnd = nullptr;
         FileChangedState change;
-        if (newFileSize > fileSize && !memcmp(bufferBegin, lastSavedBufferBegin, lastSavedSize))
+        if (newFileSize > fileSize && !memcmp(allocatedBuffer, lastSavedBufferBegin, lastSavedSize))
             change = APPENDED;
         else
             change = OVERWRITTEN;
@@ -158,6 +266,8 @@ FileReader::FileChangedState FileReader::checkFileForChanges()
 #endif
         fileSize = newFileSize;
         lastSavedSize = readFileEnd(lastSavedBufferBegin);
+        if (isMapped)
+            mapFile();
         return change;
     }
 }
@@ -195,6 +305,9 @@ void FileReader::fillBuffer(bool forward)
     TRACE_CALL("FileReader::fillBuffer %s", forward ? "forward" : "backward");
 #endif
 
+    if (isMapped)
+        return;  // the whole file is available
+
     char *dataPointer;
     int dataLength;
 
@@ -315,8 +428,7 @@ char *FileReader::findNextLineStart(char *start, bool bufferFilled)
     char *s = start;
 
     // find next CR/LF (fast path)
-    while (s < dataEnd && *s != '\r' && *s != '\n')
-        s++;
+    s = findLineEnd(s, dataEnd);
 
     if (s < dataEnd && *s == '\r')
         s++;
@@ -336,6 +448,8 @@ char *FileReader::findNextLineStart(char *start, bool bufferFilled)
             ;  // void
         else if (fileOffset == getFileSize())  // searching from the end of the file
             return nullptr;
+        else if (isMapped)  // incomplete last line
+            return nullptr;
         else if (!bufferFilled) {  // refill buffer
             seekTo(fileOffset, maxLineSize);
 
@@ -374,10 +488,7 @@ char *FileReader::findPreviousLineStart(char *start, bool bufferFilled)
         s--;
 
     // find previous CR/LF (fast path)
-    while (s >= dataBegin && *s != '\r' && *s != '\n')
-        s--;
-
-    s++;
+    s = findLineStartBackward(dataBegin, s + 1);
 
     Assert(s >= dataBegin);
     if (s == dataBegin) {  // did we reach the beginning of the data in the buffer? (slow path)
@@ -524,6 +635,44 @@ char *FileReader::getLastLineBufferPointer()
     return getPreviousLineBufferPointer();
 }
 
+void FileReader::readLines(file_offset_t beginOffset, file_offset_t endOffset, const std::function<bool(char *line, int length)>& fn)
+{
+    seekTo(beginOffset);
+
+    // the current position is known to be a line start if it is where the previous line ended with LF
+    file_offset_t lineStartOffset = -1;
+    while (true) {
+        char *line = currentDataPointer;
+        char *lineEnd;
+        if (lineStartOffset != -1 && line >= dataBegin && line < dataEnd && pointerToFileOffset(line) == lineStartOffset &&
+            (lineEnd = findLineEnd(line, dataEnd)) < dataEnd - 1)
+        {
+            // fast path: the complete line including CR/LF is in the buffer
+            char *nextLine = lineEnd + 1;
+            if (*lineEnd == '\r' && *nextLine == '\n')
+                nextLine++;
+            numReadLines++;
+            currentLineStartOffset = lineStartOffset;
+            currentLineEndOffset = lineStartOffset + (nextLine - line);
+            currentDataPointer = nextLine;
+        }
+        else if ((line = getNextLineBufferPointer()) == nullptr)
+            break;
+
+        if (endOffset != -1 && currentLineStartOffset >= endOffset) {
+            // not in the range, unread it
+            numReadLines--;
+            setCurrentDataPointer(fileOffsetToPointer(currentLineStartOffset));
+            break;
+        }
+
+        int length = currentLineEndOffset - currentLineStartOffset;
+        lineStartOffset = line[length-1] == '\n' ? currentLineEndOffset : -1;  // see isLineStart()
+        if (!fn(line, length))
+            break;
+    }
+}
+
 char *FileReader::findNextLineBufferPointer(const char *search, bool caseSensitive)
 {
     char *line;
@@ -583,6 +732,11 @@ void FileReader::seekTo(file_offset_t fileOffset, unsigned int ensureBufferSizeA
 
     ensureFileOpen();
 
+    if (isMapped) {
+        setCurrentDataPointer(fileOffsetToPointer(fileOffset));
+        return;
+    }
+
     // check if requested offset is already in memory
     if (bufferFileOffset != -1 &&
         bufferFileOffset + ensureBufferSizeAround <= fileOffset &&
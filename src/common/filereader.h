@@ -20,6 +20,7 @@
 #include <vector>
 #include <string>
 #include <cstdint>
+#include <functional>
 #include "omnetpp/platdep/platmisc.h"
 #include "exception.h"
 #include "commondefs.h"
@@ -39,6 +40,11 @@ namespace common {
  * the file in both directions from both ends. Automatically follows file
  * content when appended, but overwriting the file causes an exception to be thrown.
  *
+ * Optionally, the whole file can be memory-mapped instead of being read in
+ * chunks (see setUseMemoryMapping()); then there is no limit on line length,
+ * and no data is copied at all. This mode is meant for files that are not
+ * overwritten or truncated while being read.
+ *
  * All functions throw class opp_runtime_error on error.
  */
 class COMMON_API FileReader
@@ -50,11 +56,14 @@ class COMMON_API FileReader
     bool enableCheckFileForChanges;
     bool enableIgnoreAppendChanges;
 
-    // the buffer
+    // the buffer; in memory-mapped mode, bufferBegin/bufferEnd delimit the mapping of the whole file
     const size_t bufferSize;
+    char *allocatedBuffer; // of bufferSize; only used for checking file changes in memory-mapped mode
     const char *bufferBegin;
     const char *bufferEnd; // = buffer + bufferSize
     const size_t maxLineSize;
+    bool enableMemoryMapping;
+    bool isMapped;
 
     // file positions and size
     file_offset_t bufferFileOffset;
@@ -96,6 +105,8 @@ class COMMON_API FileReader
      */
     void fillBuffer(bool forward);
     int readFileEnd(void *dataPointer);
+    void mapFile();
+    void unmapFile();
     void ensureFileOpenInternal();
     int64_t getFileSizeInternal();
     void checkConsistency(bool checkDataPointer = false) const;
@@ -139,6 +150,21 @@ class COMMON_API FileReader
      */
     void setIgnoreAppendChanges(bool value) { enableIgnoreAppendChanges = value; }
 
+    /**
+     * Controls whether the whole file is memory-mapped instead of being read in
+     * chunks into the buffer. It must be called before the file gets opened.
+     * If the file cannot be mapped (e.g. it is empty, or the platform does not
+     * support it), the normal buffered mode is used. The mapping is private
+     * (copy-on-write), so callers may modify the returned lines the same way
+     * as in buffered mode; the changes are not written back to the file.
+     */
+    void setUseMemoryMapping(bool value);
+
+    /**
+     * Returns true if the file is currently accessed via memory mapping.
+     */
+    bool isMemoryMapped() const { return isMapped; }
+
     /**
      * Returns true if the file is open, otherwise returns false.
      */
@@ -181,6 +207,16 @@ class COMMON_API FileReader
      */
     char *getPreviousLineBufferPointer();
 
+    /**
+     * Reads the lines starting between the given file offsets (endOffset=-1 means the end of the file),
+     * and calls the given function with each line and its length including CR/LF. If beginOffset points
+     * into the middle of a line, that line is skipped. The current position, line offsets and the number
+     * of read lines are updated as if getNextLineBufferPointer() was called; the function may also call
+     * seekTo() to skip data. The iteration stops when the function returns false. This is considerably
+     * faster than calling getNextLineBufferPointer() in a loop, especially in memory-mapped mode.
+     */
+    void readLines(file_offset_t beginOffset, file_offset_t endOffset, const std::function<bool(char *line, int length)>& fn);
+
     /**
      * Searches through the file from the current position for the given text and returns the first matching line.
      */
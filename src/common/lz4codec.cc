@@ -0,0 +1,199 @@
+//==========================================================================
+//  LZ4CODEC.CC - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cstdint>
+#include <cstring>
+#include "lz4codec.h"
+
+namespace omnetpp {
+namespace common {
+
+// Format constants, see the LZ4 block format description
+#define MIN_MATCH        4    // shortest match that can be encoded
+#define LAST_LITERALS    5    // the last 5 bytes are always literals
+#define MFLIMIT          12   // the last match must start at least 12 bytes before the end
+#define MAX_OFFSET       65535
+#define RUN_MASK         15   // a 4-bit length field of 15 means "more length bytes follow"
+
+#define HASH_LOG         12
+#define SKIP_TRIGGER     6    // after 2^SKIP_TRIGGER failed lookups, start skipping ahead faster
+
+static inline uint32_t read32(const uint8_t *p)
+{
+    uint32_t x;
+    memcpy(&x, p, sizeof(x));
+    return x;
+}
+
+static inline uint32_t hash32(uint32_t sequence)
+{
+    return (sequence * 2654435761U) >> (32 - HASH_LOG);
+}
+
+static inline uint8_t *writeLength(uint8_t *op, size_t length)
+{
+    // remainder of a length whose 4-bit field in the token was saturated
+    while (length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = (uint8_t)length;
+    return op;
+}
+
+static inline uint8_t *writeLiterals(uint8_t *op, uint8_t *token, const uint8_t *literals, size_t length)
+{
+    if (length >= RUN_MASK) {
+        *token = RUN_MASK << 4;
+        op = writeLength(op, length - RUN_MASK);
+    }
+    else
+        *token = (uint8_t)(length << 4);
+    memcpy(op, literals, length);
+    return op + length;
+}
+
+size_t lz4CompressBound(size_t srcSize)
+{
+    return srcSize + srcSize / 255 + 16;
+}
+
+size_t lz4Compress(const char *src, size_t srcSize, char *dest)
+{
+    const uint8_t *base = (const uint8_t *)src;
+    const uint8_t *end = base + srcSize;
+    const uint8_t *ip = base;
+    const uint8_t *anchor = base;  // start of pending literals
+    uint8_t *op = (uint8_t *)dest;
+
+    if (srcSize > MFLIMIT) {
+        const uint8_t *matchLimit = end - LAST_LITERALS;
+        const uint8_t *mfLimit = end - MFLIMIT;
+        uint32_t table[1 << HASH_LOG];  // positions relative to base
+        memset(table, 0, sizeof(table));
+        unsigned searches = 1 << SKIP_TRIGGER;
+
+        while (ip < mfLimit) {
+            uint32_t sequence = read32(ip);
+            uint32_t h = hash32(sequence);
+            const uint8_t *ref = base + table[h];
+            table[h] = (uint32_t)(ip - base);
+            if (ref >= ip || ip - ref > MAX_OFFSET || read32(ref) != sequence) {
+                ip += searches++ >> SKIP_TRIGGER;
+                continue;
+            }
+            searches = 1 << SKIP_TRIGGER;
+
+            // extend the match backwards over pending literals, then forwards
+            while (ip > anchor && ref > base && ip[-1] == ref[-1]) {
+                ip--;
+                ref--;
+            }
+            const uint8_t *matchEnd = ip + MIN_MATCH;
+            const uint8_t *refEnd = ref + MIN_MATCH;
+            while (matchEnd < matchLimit && *matchEnd == *refEnd) {
+                matchEnd++;
+                refEnd++;
+            }
+
+            // emit sequence: token, literals, offset, match length
+            uint8_t *token = op++;
+            op = writeLiterals(op, token, anchor, ip - anchor);
+            size_t offset = ip - ref;
+            *op++ = (uint8_t)offset;
+            *op++ = (uint8_t)(offset >> 8);
+            size_t matchLength = (matchEnd - ip) - MIN_MATCH;
+            if (matchLength >= RUN_MASK) {
+                *token |= RUN_MASK;
+                op = writeLength(op, matchLength - RUN_MASK);
+            }
+            else
+                *token |= (uint8_t)matchLength;
+
+            ip = anchor = matchEnd;
+        }
+    }
+
+    // last sequence: literals only
+    uint8_t *token = op++;
+    op = writeLiterals(op, token, anchor, end - anchor);
+    return op - (uint8_t *)dest;
+}
+
+bool lz4Decompress(const char *src, size_t srcSize, char *dest, size_t destSize)
+{
+    const uint8_t *ip = (const uint8_t *)src;
+    const uint8_t *iend = ip + srcSize;
+    uint8_t *op = (uint8_t *)dest;
+    uint8_t *oend = op + destSize;
+
+    if (srcSize == 0)
+        return false;  // a block has at least one sequence, even if the data is empty
+
+    while (ip < iend) {
+        unsigned token = *ip++;
+
+        // literals
+        size_t length = token >> 4;
+        if (length == RUN_MASK) {
+            uint8_t b;
+            do {
+                if (ip == iend)
+                    return false;
+                b = *ip++;
+                length += b;
+            } while (b == 255);
+        }
+        if (length > (size_t)(iend - ip) || length > (size_t)(oend - op))
+            return false;
+        memcpy(op, ip, length);
+        ip += length;
+        op += length;
+        if (ip == iend)
+            break;  // last sequence has no match part
+
+        // match
+        if (iend - ip < 2)
+            return false;
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - (uint8_t *)dest))
+            return false;
+        length = token & RUN_MASK;
+        if (length == RUN_MASK) {
+            uint8_t b;
+            do {
+                if (ip == iend)
+                    return false;
+                b = *ip++;
+                length += b;
+            } while (b == 255);
+        }
+        length += MIN_MATCH;
+        if (length > (size_t)(oend - op))
+            return false;
+        const uint8_t *match = op - offset;
+        if (offset >= length)
+            memcpy(op, match, length);
+        else
+            for (size_t i = 0; i < length; i++)  // overlapping copy repeats the pattern
+                op[i] = match[i];
+        op += length;
+    }
+    return op == oend;
+}
+
+}  // namespace common
+}  // namespace omnetpp
+
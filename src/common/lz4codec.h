@@ -0,0 +1,54 @@
+//==========================================================================
+//  LZ4CODEC.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_COMMON_LZ4CODEC_H
+#define __OMNETPP_COMMON_LZ4CODEC_H
+
+#include <cstddef>
+#include "commondefs.h"
+
+namespace omnetpp {
+namespace common {
+
+/**
+ * Self-contained implementation of the LZ4 block format (no frame format).
+ * Compression is a fast greedy single-pass match finder; it trades
+ * compression ratio for speed, which is what we need for writing large
+ * result files. The output can be decoded by any LZ4 block decompressor,
+ * and vice versa.
+ */
+
+/**
+ * Returns the maximum size of the compressed form of srcSize bytes.
+ */
+COMMON_API size_t lz4CompressBound(size_t srcSize);
+
+/**
+ * Compresses srcSize bytes from src into dest, and returns the compressed
+ * size. dest must have room for at least lz4CompressBound(srcSize) bytes.
+ */
+COMMON_API size_t lz4Compress(const char *src, size_t srcSize, char *dest);
+
+/**
+ * Decompresses srcSize bytes from src into dest, which must be exactly
+ * destSize (i.e. the original size) long. Returns false if the input is
+ * malformed or does not decompress to exactly destSize bytes; it never
+ * reads or writes outside the given buffers.
+ */
+COMMON_API bool lz4Decompress(const char *src, size_t srcSize, char *dest, size_t destSize);
+
+}  // namespace common
+}  // namespace omnetpp
+
+#endif
@@ -0,0 +1,295 @@
+//==========================================================================
+//  NUMBERFORMAT.CC - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "numberformat.h"
+
+namespace omnetpp {
+namespace common {
+
+#define MAX_FAST_PRECISION  17   // 10^prec must fit into 64 bits
+#define MAX_POW5            27   // largest k with 5^k < 2^64
+
+static const uint64_t pow5[MAX_POW5+1] = {
+    1ULL, 5ULL, 25ULL, 125ULL, 625ULL, 3125ULL, 15625ULL, 78125ULL, 390625ULL,
+    1953125ULL, 9765625ULL, 48828125ULL, 244140625ULL, 1220703125ULL,
+    6103515625ULL, 30517578125ULL, 152587890625ULL, 762939453125ULL,
+    3814697265625ULL, 19073486328125ULL, 95367431640625ULL, 476837158203125ULL,
+    2384185791015625ULL, 11920928955078125ULL, 59604644775390625ULL,
+    298023223876953125ULL, 1490116119384765625ULL, 7450580596923828125ULL
+};
+
+static const uint64_t pow10[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL,
+    1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+    1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL
+};
+
+static const char digitPairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// full 128-bit product of two 64-bit numbers, portably
+static inline void mul64(uint64_t a, uint64_t b, uint64_t& hi, uint64_t& lo)
+{
+    uint64_t aLo = (uint32_t)a, aHi = a >> 32;
+    uint64_t bLo = (uint32_t)b, bHi = b >> 32;
+    uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+    uint64_t mid = (ll >> 32) + (uint32_t)lh + (uint32_t)hl;
+    lo = (mid << 32) | (uint32_t)ll;
+    hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+}
+
+// Computes y = f * 2^e * 10^k exactly: q = floor(y), and the sign of
+// (frac(y) - 1/2) in cmpHalf. Returns false if that cannot be done with
+// 64-bit and 128-bit integers (very large or small numbers).
+static bool scale(uint64_t f, int e, int k, uint64_t& q, int& cmpHalf)
+{
+    if (k >= 0) {
+        // y = f * 5^k * 2^(e+k)
+        if (k > MAX_POW5)
+            return false;
+        uint64_t hi, lo;
+        mul64(f, pow5[k], hi, lo);
+        int s = e + k;
+        if (s >= 0) {
+            if (hi != 0 || s >= 64 || (s > 0 && (lo >> (64 - s)) != 0))
+                return false;
+            q = lo << s;
+            cmpHalf = -1;
+            return true;
+        }
+        int sh = -s;
+        if (sh >= 128)
+            return false;
+        if (sh >= 64) {
+            q = sh == 64 ? hi : hi >> (sh - 64);
+            // remainder: all of lo and the low (sh-64) bits of hi; half: bit (sh-1)
+            uint64_t remHi = sh == 64 ? 0 : hi & ((1ULL << (sh - 64)) - 1);
+            uint64_t halfHi = sh == 64 ? 0 : 1ULL << (sh - 65);
+            if (sh == 64)
+                cmpHalf = lo > (1ULL << 63) ? 1 : lo < (1ULL << 63) ? -1 : 0;
+            else
+                cmpHalf = remHi > halfHi ? 1 : remHi < halfHi ? -1 : lo != 0 ? 1 : 0;
+            return true;
+        }
+        if ((hi >> sh) != 0)
+            return false;  // q would not fit into 64 bits
+        q = (lo >> sh) | (hi << (64 - sh));
+        uint64_t rem = lo & ((1ULL << sh) - 1);
+        uint64_t half = 1ULL << (sh - 1);
+        cmpHalf = rem > half ? 1 : rem < half ? -1 : 0;
+        return true;
+    }
+    else {
+        // y = (f * 2^11 / 5^m) * 2^(e - 11 - m), where m = -k
+        int m = -k;
+        if (m > MAX_POW5)
+            return false;
+        uint64_t F = f << 11;
+        uint64_t q1 = F / pow5[m];
+        uint64_t r1 = F % pow5[m];
+        int s = e - 11 - m;
+        if (s > 0)
+            return false;
+        if (s == 0) {
+            q = q1;
+            uint64_t twice = 2 * r1;  // cannot overflow, as 5^m < 2^63
+            cmpHalf = twice > pow5[m] ? 1 : twice < pow5[m] ? -1 : 0;
+            return true;
+        }
+        int sh = -s;
+        if (sh >= 64)
+            return false;
+        q = q1 >> sh;
+        uint64_t low = q1 & ((1ULL << sh) - 1);
+        uint64_t half = 1ULL << (sh - 1);
+        cmpHalf = low > half ? 1 : low < half ? -1 : r1 != 0 ? 1 : 0;
+        return true;
+    }
+}
+
+// Computes the prec (1..17) significant decimal digits of d>0, correctly
+// rounded with ties to even, and the decimal exponent of the first digit.
+static bool toDecimal(double d, int prec, uint64_t& digits, int& exp10)
+{
+    // decompose into d = f * 2^e, where f has its highest bit at position 52
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    uint64_t f = bits & ((1ULL << 52) - 1);
+    int biasedExp = (int)(bits >> 52) & 0x7ff;
+    int e;
+    if (biasedExp != 0) {
+        f |= 1ULL << 52;
+        e = biasedExp - 1075;
+    }
+    else {
+        e = -1074;  // subnormal
+        while ((f & (1ULL << 52)) == 0) {
+            f <<= 1;
+            e--;
+        }
+    }
+
+    // floor(log10(d)) is either this or one more (78913 / 2^18 ~ log10(2))
+    int e10 = ((e + 52) * 78913) >> 18;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        uint64_t q;
+        int cmpHalf;
+        if (!scale(f, e, prec - 1 - e10, q, cmpHalf))
+            return false;
+        if (q >= pow10[prec]) {
+            e10++;
+            continue;
+        }
+        if (q < pow10[prec-1])
+            return false;  // cannot happen
+        if (cmpHalf > 0 || (cmpHalf == 0 && (q & 1) != 0))
+            q++;
+        if (q == pow10[prec]) {
+            q = pow10[prec-1];
+            e10++;
+        }
+        digits = q;
+        exp10 = e10;
+        return true;
+    }
+    return false;
+}
+
+static inline char *writeDigits(char *end, uint64_t x, int n)
+{
+    // writes exactly n digits of x ending at end, right to left
+    char *p = end;
+    while (n >= 2) {
+        int i = (int)(x % 100) * 2;
+        x /= 100;
+        *--p = digitPairs[i+1];
+        *--p = digitPairs[i];
+        n -= 2;
+    }
+    if (n > 0)
+        *--p = '0' + (int)(x % 10);
+    return p;
+}
+
+char *opp_formatdouble(char *buf, double d, int prec)
+{
+    if (prec < 0)
+        prec = 6;
+    else if (prec == 0)
+        prec = 1;
+
+    uint64_t digits;
+    int exp10;
+    if (d == 0 || prec > MAX_FAST_PRECISION || !std::isfinite(d) || !toDecimal(std::fabs(d), prec, digits, exp10)) {
+        if (d == 0 && prec <= MAX_FAST_PRECISION) {
+            char *p = buf;
+            if (std::signbit(d))
+                *p++ = '-';
+            *p++ = '0';
+            *p = '\0';
+            return p;
+        }
+        int n = snprintf(buf, opp_formatdouble_bufsize(prec), "%.*g", prec, d);
+        return buf + n;
+    }
+
+    char digitBuf[MAX_FAST_PRECISION];
+    writeDigits(digitBuf + prec, digits, prec);
+    int numDigits = prec;
+    while (numDigits > 1 && digitBuf[numDigits-1] == '0')
+        numDigits--;  // %g removes trailing zeros
+
+    char *p = buf;
+    if (d < 0)
+        *p++ = '-';
+    if (exp10 < -4 || exp10 >= prec) {
+        // scientific notation
+        *p++ = digitBuf[0];
+        if (numDigits > 1) {
+            *p++ = '.';
+            memcpy(p, digitBuf + 1, numDigits - 1);
+            p += numDigits - 1;
+        }
+        *p++ = 'e';
+        int x = exp10;
+        if (x < 0) {
+            *p++ = '-';
+            x = -x;
+        }
+        else
+            *p++ = '+';
+        if (x >= 100)
+            *p++ = '0' + x / 100;
+        *p++ = digitPairs[(x % 100) * 2];
+        *p++ = digitPairs[(x % 100) * 2 + 1];
+    }
+    else if (exp10 >= 0) {
+        // fixed notation, with integer part
+        int intDigits = exp10 + 1;
+        if (numDigits <= intDigits) {
+            memcpy(p, digitBuf, numDigits);
+            memset(p + numDigits, '0', intDigits - numDigits);
+            p += intDigits;
+        }
+        else {
+            memcpy(p, digitBuf, intDigits);
+            p += intDigits;
+            *p++ = '.';
+            memcpy(p, digitBuf + intDigits, numDigits - intDigits);
+            p += numDigits - intDigits;
+        }
+    }
+    else {
+        // fixed notation, less than 1
+        *p++ = '0';
+        *p++ = '.';
+        for (int i = -1; i > exp10; i--)
+            *p++ = '0';
+        memcpy(p, digitBuf, numDigits);
+        p += numDigits;
+    }
+    *p = '\0';
+    return p;
+}
+
+char *opp_formatu64(char *buf, uint64_t d)
+{
+    int n = 1;
+    while (n < 20 && d >= pow10[n])
+        n++;
+    char *end = buf + n;
+    writeDigits(end, d, n);
+    *end = '\0';
+    return end;
+}
+
+char *opp_formati64(char *buf, int64_t d)
+{
+    if (d < 0) {
+        *buf++ = '-';
+        return opp_formatu64(buf, ~(uint64_t)d + 1);  // also right for INT64_MIN
+    }
+    return opp_formatu64(buf, (uint64_t)d);
+}
+
+}  // namespace common
+}  // namespace omnetpp
+
@@ -0,0 +1,60 @@
+//==========================================================================
+//  NUMBERFORMAT.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_COMMON_NUMBERFORMAT_H
+#define __OMNETPP_COMMON_NUMBERFORMAT_H
+
+#include <cstdint>
+#include "commondefs.h"
+
+namespace omnetpp {
+namespace common {
+
+/**
+ * Fast replacements of printf for writing numbers into result files.
+ * They produce exactly the same text as the printf conversions they
+ * replace, and return a pointer to the terminating '\\0'.
+ */
+
+/**
+ * Maximum number of characters (including the terminating '\\0') that
+ * opp_formatdouble() writes for the given precision.
+ */
+inline int opp_formatdouble_bufsize(int prec) {return prec > 16 ? prec + 16 : 32;}
+
+/**
+ * Prints d into buf like sprintf(buf, "%.*g", prec, d). Most values are
+ * converted with exact integer arithmetic (digits are correctly rounded,
+ * ties to even); the rest (very large or small magnitudes, prec > 17,
+ * infinity and NaN) are passed to sprintf. buf must have room for at least
+ * opp_formatdouble_bufsize(prec) characters.
+ */
+COMMON_API char *opp_formatdouble(char *buf, double d, int prec);
+
+/**
+ * Prints d into buf like sprintf(buf, "%" PRId64, d). buf must have room
+ * for at least 21 characters.
+ */
+COMMON_API char *opp_formati64(char *buf, int64_t d);
+
+/**
+ * Prints d into buf like sprintf(buf, "%" PRIu64, d). buf must have room
+ * for at least 21 characters.
+ */
+COMMON_API char *opp_formatu64(char *buf, uint64_t d);
+
+}  // namespace common
+}  // namespace omnetpp
+
+#endif
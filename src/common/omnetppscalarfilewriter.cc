@@ -30,7 +30,11 @@ OmnetppScalarFileWriter::OmnetppScalarFileWriter()
 
 OmnetppScalarFileWriter::~OmnetppScalarFileWriter()
 {
-    close();
+    // note: no close(), because it may throw
+    if (f) {
+        buffer.writeTo(f);
+        fclose(f);
+    }
 }
 
 void OmnetppScalarFileWriter::open(const char *filename)
@@ -44,6 +48,7 @@ void OmnetppScalarFileWriter::open(const char *filename)
     // opening the file in append mode. On other systems ftell() correctly points to the end of the file.
     opp_fseek(f, 0, SEEK_END);
 
+    buffer.clear();
     if (opp_ftell(f) == 0)
         check(fprintf(f, "version %d\n", SCALAR_FILE_VERSION));
 }
@@ -51,8 +56,14 @@ void OmnetppScalarFileWriter::open(const char *filename)
 void OmnetppScalarFileWriter::close()
 {
     if (f) {
-        fclose(f);
+        bool ok = buffer.writeTo(f);
+        ok = fclose(f) == 0 && ok;
         f = nullptr;
+        if (!ok) {
+            std::string name = fname;
+            fname = "";
+            throw opp_runtime_error("Cannot write output scalar file '%s'", name.c_str());
+        }
         fname = "";
     }
 }
@@ -60,25 +71,76 @@ void OmnetppScalarFileWriter::close()
 void OmnetppScalarFileWriter::check(int fprintfResult)
 {
     if (fprintfResult < 0) {
-        close();
-        throw opp_runtime_error("Cannot write output scalar file '%s'", fname.c_str());
+        buffer.clear();
+        std::string name = fname;
+        if (f) {
+            fclose(f);
+            f = nullptr;
+            fname = "";
+        }
+        throw opp_runtime_error("Cannot write output scalar file '%s'", name.c_str());
     }
 }
 
+void OmnetppScalarFileWriter::writeBuffer()
+{
+    check(buffer.writeTo(f) ? 0 : -1);
+}
+
+void OmnetppScalarFileWriter::appendQuoted(const char *s)
+{
+    if (!opp_needsquotes(s))
+        buffer.append(s);
+    else
+        buffer.append(opp_quotestr(s));
+}
+
+void OmnetppScalarFileWriter::writeAttribute(const char *name, const char *value)
+{
+    buffer.append("attr ");
+    appendQuoted(name);
+    buffer.append(' ');
+    appendQuoted(value);
+    buffer.append('\n');
+}
+
 void OmnetppScalarFileWriter::writeAttributes(const StringMap& attributes)
 {
-    for (auto pair : attributes)
-        check(fprintf(f, "attr %s %s\n", QUOTE(pair.first.c_str()), QUOTE(pair.second.c_str())));
+    for (auto& pair : attributes)
+        writeAttribute(pair.first.c_str(), pair.second.c_str());
+}
+
+void OmnetppScalarFileWriter::writeAttributes(const AttributeList& attributes)
+{
+    for (auto& pair : attributes)
+        writeAttribute(pair.first, pair.second);
+}
+
+void OmnetppScalarFileWriter::writeHeaderLine(const char *keyword, const char *componentFullPath, const char *name)
+{
+    buffer.append(keyword);
+    buffer.append(' ');
+    appendQuoted(componentFullPath);
+    buffer.append(' ');
+    appendQuoted(name);
 }
 
 void OmnetppScalarFileWriter::writeStatisticField(const char *name, int64_t value)
 {
-    check(fprintf(f, "field %s %" PRId64 "\n", QUOTE(name), value));
+    buffer.append("field ");
+    buffer.append(QUOTE(name));
+    buffer.append(' ');
+    buffer.appendInt(value);
+    buffer.append('\n');
 }
 
 void OmnetppScalarFileWriter::writeStatisticField(const char *name, double value)
 {
-    check(fprintf(f, "field %s %.*g\n", QUOTE(name), prec, value));
+    buffer.append("field ");
+    buffer.append(QUOTE(name));
+    buffer.append(' ');
+    buffer.appendDouble(value, prec);
+    buffer.append('\n');
 }
 
 void OmnetppScalarFileWriter::writeStatisticFields(const Statistics& statistic)
@@ -105,12 +167,14 @@ void OmnetppScalarFileWriter::writeStatisticFields(const Statistics& statistic)
 void OmnetppScalarFileWriter::beginRecordingForRun(const std::string& runName, const StringMap& attributes, const StringMap& itervars, const OrderedKeyValueList& configEntries)
 {
     Assert(isOpen());
+    writeBuffer();
 
     // save run
     check(fprintf(f, "run %s\n", QUOTE(runName.c_str())));
 
     // save run attributes
     writeAttributes(attributes);
+    writeBuffer();  // attributes go into the buffer, the rest of the header is written directly
 
     // save itervars
     for (auto pair : itervars)
@@ -126,53 +190,106 @@ void OmnetppScalarFileWriter::beginRecordingForRun(const std::string& runName, c
 void OmnetppScalarFileWriter::endRecordingForRun()
 {
     Assert(isOpen());
-    check(fprintf(f, "\n"));
+    buffer.append('\n');
+    writeBuffer();
 }
 
 void OmnetppScalarFileWriter::recordScalar(const std::string& componentFullPath, const std::string& name, double value, const StringMap& attributes)
 {
-    Assert(isOpen());
-    check(fprintf(f, "scalar %s %s %.*g\n", QUOTE(componentFullPath.c_str()), QUOTE(name.c_str()), prec, value));
+    recordScalar(componentFullPath.c_str(), name.c_str(), value, AttributeList());
     writeAttributes(attributes);
 }
 
 void OmnetppScalarFileWriter::recordStatistic(const std::string& componentFullPath, const std::string& name, const Statistics& statistic, const StringMap& attributes)
+{
+    recordStatistic(componentFullPath.c_str(), name.c_str(), statistic, AttributeList());
+    writeAttributes(attributes);
+}
+
+void OmnetppScalarFileWriter::recordHistogram(const std::string& componentFullPath, const std::string& name, const Statistics& statistic, const Histogram& bins, const StringMap& attributes)
 {
     Assert(isOpen());
-    check(fprintf(f, "statistic %s %s\n", QUOTE(componentFullPath.c_str()), QUOTE(name.c_str())));
+    writeHeaderLine("statistic", componentFullPath.c_str(), name.c_str());
+    buffer.append('\n');
     writeStatisticFields(statistic);
     writeAttributes(attributes);
+    writeBins(bins);
+    writeBufferIfFull();
 }
 
-void OmnetppScalarFileWriter::writeBin(double lowerEdge, double value)
+void OmnetppScalarFileWriter::recordParameter(const std::string& componentFullPath, const std::string& name, const std::string& value, const StringMap& attributes)
 {
-    check(fprintf(f, "bin\t%.*g\t%.*g\n", prec, lowerEdge, prec, value));
+    recordParameter(componentFullPath.c_str(), name.c_str(), value.c_str(), AttributeList());
+    writeAttributes(attributes);
 }
 
-void OmnetppScalarFileWriter::recordHistogram(const std::string& componentFullPath, const std::string& name, const Statistics& statistic, const Histogram& bins, const StringMap& attributes)
+void OmnetppScalarFileWriter::recordScalar(const char *componentFullPath, const char *name, double value, const AttributeList& attributes)
+{
+    Assert(isOpen());
+    writeHeaderLine("scalar", componentFullPath, name);
+    buffer.append(' ');
+    buffer.appendDouble(value, prec);
+    buffer.append('\n');
+    writeAttributes(attributes);
+    writeBufferIfFull();
+}
+
+void OmnetppScalarFileWriter::recordStatistic(const char *componentFullPath, const char *name, const Statistics& statistic, const AttributeList& attributes)
 {
     Assert(isOpen());
-    check(fprintf(f, "statistic %s %s\n", QUOTE(componentFullPath.c_str()), QUOTE(name.c_str())));
+    writeHeaderLine("statistic", componentFullPath, name);
+    buffer.append('\n');
     writeStatisticFields(statistic);
     writeAttributes(attributes);
+    writeBufferIfFull();
+}
+
+void OmnetppScalarFileWriter::writeBin(double lowerEdge, double value)
+{
+    buffer.append("bin\t");
+    buffer.appendDouble(lowerEdge, prec);
+    buffer.append('\t');
+    buffer.appendDouble(value, prec);
+    buffer.append('\n');
+}
 
+void OmnetppScalarFileWriter::writeBins(const Histogram& bins)
+{
     int n = bins.getNumBins();
     writeBin(-INFINITY, bins.getUnderflows());
-    for (int i = 0; i < n; i++)
+    for (int i = 0; i < n; i++) {
         writeBin(bins.getBinEdge(i), bins.getBinValue(i));
+        writeBufferIfFull();
+    }
     writeBin(bins.getBinEdge(n), bins.getOverflows());
 }
 
-void OmnetppScalarFileWriter::recordParameter(const std::string& componentFullPath, const std::string& name, const std::string& value, const StringMap& attributes)
+void OmnetppScalarFileWriter::recordHistogram(const char *componentFullPath, const char *name, const Statistics& statistic, const Histogram& bins, const AttributeList& attributes)
+{
+    Assert(isOpen());
+    writeHeaderLine("statistic", componentFullPath, name);
+    buffer.append('\n');
+    writeStatisticFields(statistic);
+    writeAttributes(attributes);
+    writeBins(bins);
+    writeBufferIfFull();
+}
+
+void OmnetppScalarFileWriter::recordParameter(const char *componentFullPath, const char *name, const char *value, const AttributeList& attributes)
 {
     Assert(isOpen());
-    check(fprintf(f, "par %s %s %s\n", QUOTE(componentFullPath.c_str()), QUOTE(name.c_str()), QUOTE(value.c_str())));
+    writeHeaderLine("par", componentFullPath, name);
+    buffer.append(' ');
+    appendQuoted(value);
+    buffer.append('\n');
     writeAttributes(attributes);
+    writeBufferIfFull();
 }
 
 void OmnetppScalarFileWriter::flush()
 {
     Assert(isOpen());
+    writeBuffer();
     fflush(f);
 }
 
@@ -22,31 +22,49 @@
 #include <vector>
 #include "statistics.h"
 #include "histogram.h"
+#include "textbuffer.h"
 
 namespace omnetpp {
 namespace common {
 
 /**
  * Class for writing text-based output scalar files.
+ *
+ * Output is collected in a memory buffer and written to the file in large
+ * chunks; it is written out by flush(), endRecordingForRun() and close().
+ * The record methods that take plain strings and an AttributeList do not
+ * allocate memory in the steady state, which matters when millions of
+ * scalars are recorded at the end of a simulation run.
  */
 class COMMON_API OmnetppScalarFileWriter
 {
   public:
     typedef std::map<std::string, std::string> StringMap;
     typedef std::vector<std::pair<std::string, std::string>> OrderedKeyValueList;
+    typedef std::vector<std::pair<const char *, const char *>> AttributeList; // (name, value) pairs; strings are not copied
 
   protected:
     std::string fname;  // output file name
     FILE *f = nullptr;  // file ptr of output file; nullptr if closed (not yet opened, or after error)
     int prec = 14;      // number of significant digits when writing doubles
+    TextBuffer buffer;  // output not yet written to the file
+
+    static const size_t BUFFER_FLUSH_SIZE = 65536; // write out the buffer when it grows beyond this size
 
   protected:
     void check(int fprintfResult);
+    void writeBuffer();
+    void writeBufferIfFull() {if (buffer.getLength() >= BUFFER_FLUSH_SIZE) writeBuffer();}
+    void appendQuoted(const char *s);
+    void writeAttribute(const char *name, const char *value);
     void writeAttributes(const StringMap& attributes);
+    void writeAttributes(const AttributeList& attributes);
+    void writeHeaderLine(const char *keyword, const char *componentFullPath, const char *name);
     void writeStatisticFields(const Statistics& statistic);
     void writeStatisticField(const char *name, int64_t value);
     void writeStatisticField(const char *name, double value);
     void writeBin(double lowerEdge, double value);
+    void writeBins(const Histogram& bins);
 
   public:
     OmnetppScalarFileWriter();
@@ -65,6 +83,11 @@ class COMMON_API OmnetppScalarFileWriter
     void recordStatistic(const std::string& componentFullPath, const std::string& name, const Statistics& statistic, const StringMap& attributes);
     void recordHistogram(const std::string& componentFullPath, const std::string& name, const Statistics& statistic, const Histogram& bins, const StringMap& attributes); //TODO should be done by recordStatistic; do recordWeightedStatistic instead!
     void recordParameter(const std::string& componentFullPath, const std::string& name, const std::string& value, const StringMap& attributes);
+
+    void recordScalar(const char *componentFullPath, const char *name, double value, const AttributeList& attributes);
+    void recordStatistic(const char *componentFullPath, const char *name, const Statistics& statistic, const AttributeList& attributes);
+    void recordHistogram(const char *componentFullPath, const char *name, const Statistics& statistic, const Histogram& bins, const AttributeList& attributes);
+    void recordParameter(const char *componentFullPath, const char *name, const char *value, const AttributeList& attributes);
     void flush();
 };
 
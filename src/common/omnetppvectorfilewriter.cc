@@ -16,8 +16,10 @@
 *--------------------------------------------------------------*/
 
 #include <algorithm>
+#include <memory>
 #include "commonutil.h"
 #include "stringutil.h"
+#include "backgroundworker.h"
 #include "omnetppvectorfilewriter.h"
 
 
@@ -25,8 +27,13 @@ namespace omnetpp {
 namespace common {
 
 #define VECTOR_FILE_VERSION    3
+#define BINARY_VECTOR_FILE_VERSION    4
 #define INDEX_FILE_VERSION     3
 
+#define BACKGROUND_QUEUE_LENGTH    1024  // max. number of pending operations for the background thread
+#define TEXT_BUFFER_FLUSH_SIZE     65536 // write out formatted lines in chunks of about this size
+#define MIN_REBALANCE_INTERVAL     1024  // min. number of samples between recomputing adaptive buffer sizes
+
 using std::ostream;
 using std::ofstream;
 using std::ios;
@@ -48,7 +55,8 @@ OmnetppVectorFileWriter::~OmnetppVectorFileWriter()
 void OmnetppVectorFileWriter::check(int fprintfResult)
 {
     if (fprintfResult < 0) {
-        close();
+        if (!worker)
+            close();  // otherwise we are in the background thread, and the error will be reported in the main thread
         throw opp_runtime_error("Cannot write output vector file '%s'", fname.c_str());
     }
 }
@@ -56,7 +64,8 @@ void OmnetppVectorFileWriter::check(int fprintfResult)
 void OmnetppVectorFileWriter::checki(int fprintfResult)
 {
     if (fprintfResult < 0) {
-        close();
+        if (!worker)
+            close();
         throw opp_runtime_error("Cannot write output vector index file '%s'", ifname.c_str());
     }
 }
@@ -65,10 +74,10 @@ void OmnetppVectorFileWriter::open(const char *filename)
 {
     // open file
     fname = filename;
-    f = fopen(fname.c_str(), "w");  // we only support overwrite but not append
+    f = fopen(fname.c_str(), binary ? "wb" : "w");  // we only support overwrite but not append
     if (f == nullptr)
         throw opp_runtime_error("Cannot open output vector file '%s'", fname.c_str());
-    check(fprintf(f, "version %d\n", VECTOR_FILE_VERSION));
+    check(fprintf(f, "version %d\n", binary ? BINARY_VECTOR_FILE_VERSION : VECTOR_FILE_VERSION));
 
     // open index file
     ifname = opp_substringbeforelast(fname, ".") + ".vci";
@@ -78,10 +87,25 @@ void OmnetppVectorFileWriter::open(const char *filename)
 
     fprintf(fi, "%64s\n", "");  // leave blank space for "fingerprint" (size and modification date of the vector file)
     check(fprintf(fi, "version %d\n", INDEX_FILE_VERSION));
+
+    if (backgroundWriting) {
+        try {
+            worker = new BackgroundWorker(BACKGROUND_QUEUE_LENGTH, backgroundQueueLimit);
+        }
+        catch (std::exception&) {
+            close();
+            throw;
+        }
+    }
 }
 
 void OmnetppVectorFileWriter::close()
 {
+    if (worker) {
+        delete worker;  // writes out pending data, unless there was an error
+        worker = nullptr;
+    }
+
     if (f) {
         fclose(f);
         f = nullptr;
@@ -103,18 +127,61 @@ void OmnetppVectorFileWriter::close()
 
 void OmnetppVectorFileWriter::cleanup()  // MUST NOT THROW
 {
+    delete worker;
     if (f)
         fclose(f);
     if (fi)
         fclose(fi);
 }
 
+void OmnetppVectorFileWriter::setBackgroundWriting(bool enabled, size_t queueMemoryLimit)
+{
+    Assert(!isOpen());
+    backgroundWriting = enabled;
+    backgroundQueueLimit = queueMemoryLimit;
+}
+
+void OmnetppVectorFileWriter::execute(size_t cost, const std::function<void()>& task)
+{
+    if (!worker)
+        task();
+    else {
+        try {
+            worker->submit(cost, task);  // also reports errors of earlier tasks
+        }
+        catch (std::exception&) {
+            close();
+            throw;
+        }
+    }
+}
+
+void OmnetppVectorFileWriter::flushWorker()
+{
+    if (worker) {
+        try {
+            worker->flush();
+        }
+        catch (std::exception&) {
+            close();
+            throw;
+        }
+    }
+}
+
 void OmnetppVectorFileWriter::beginRecordingForRun(const std::string& runName, const StringMap& attributes, const StringMap& itervars, const OrderedKeyValueList& configEntries)
 {
     Assert(vectors.size() == 0);
     bufferedSamples = 0;
+    samplesSinceRebalance = 0;
+    blockSizeHistogram.clear();
     Assert(isOpen());
 
+    execute(0, [this, runName, attributes, itervars, configEntries]() {writeRunHeader(runName, attributes, itervars, configEntries);});
+}
+
+void OmnetppVectorFileWriter::writeRunHeader(const std::string& runName, const StringMap& attributes, const StringMap& itervars, const OrderedKeyValueList& configEntries)
+{
     // note: we write everything twice, once in .vec and once in .vci
 
     // save run
@@ -159,8 +226,13 @@ void OmnetppVectorFileWriter::endRecordingForRun()
     }
     vectors.clear();
 
-    check(fprintf(f, "\n"));
-    check(fprintf(fi, "\n"));
+    std::vector<int64_t> histogram = blockSizeHistogram;
+    execute(0, [this, histogram]() {
+        writeBlockSizeHistogram(histogram);
+        check(fprintf(f, "\n"));
+        check(fprintf(fi, "\n"));
+    });
+    flushWorker();
 
     bufferedSamples = 0;
     nextVectorId = 0;
@@ -171,23 +243,29 @@ void *OmnetppVectorFileWriter::registerVector(const std::string& componentFullPa
     VectorData *vp = new VectorData();
     vp->id = nextVectorId++;
     vp->recordEventNumbers = recordEventNumbers;
-    vp->bufferedSamplesLimit = bufferSize / sizeof(Sample);
+    vp->bufferedSamplesLimit = vp->configuredSamplesLimit = bufferSize / sizeof(Sample);
+    vp->recentSamples = 0;
+    vp->recordingRate = 0;
     if (vp->bufferedSamplesLimit > 0)
         vp->buffer.reserve(vp->bufferedSamplesLimit);
     vectors.push_back(vp);
 
+    int id = vp->id;
+    execute(0, [this, id, componentFullPath, name, attributes, recordEventNumbers]() {writeVectorDeclaration(id, componentFullPath, name, attributes, recordEventNumbers);});
+    return vp;
+}
 
-    const char *columns = vp->recordEventNumbers ? "ETV" : "TV";
-    check(fprintf(f, "vector %d %s %s %s\n", vp->id, QUOTE(componentFullPath.c_str()), QUOTE(name.c_str()), columns));
+void OmnetppVectorFileWriter::writeVectorDeclaration(int id, const std::string& componentFullPath, const std::string& name, const StringMap& attributes, bool recordEventNumbers)
+{
+    const char *columns = recordEventNumbers ? "ETV" : "TV";
+    check(fprintf(f, "vector %d %s %s %s\n", id, QUOTE(componentFullPath.c_str()), QUOTE(name.c_str()), columns));
     for (auto pair : attributes)
         check(fprintf(f, "attr %s %s\n", QUOTE(pair.first.c_str()), QUOTE(pair.second.c_str())));
 
     // write vector declaration and vector attributes to the index file too
-    checki(fprintf(fi, "vector %d %s %s %s\n", vp->id, QUOTE(componentFullPath.c_str()), QUOTE(name.c_str()), columns));
+    checki(fprintf(fi, "vector %d %s %s %s\n", id, QUOTE(componentFullPath.c_str()), QUOTE(name.c_str()), columns));
     for (auto pair : attributes)
         checki(fprintf(fi, "attr %s %s\n", QUOTE(pair.first.c_str()), QUOTE(pair.second.c_str())));
-
-    return vp;
 }
 
 void OmnetppVectorFileWriter::deregisterVector(void *vectorhandle)
@@ -210,6 +288,7 @@ void OmnetppVectorFileWriter::recordInVector(void *vectorhandle, eventnumber_t e
     // store value
     vp->buffer.push_back(Sample(t, simtimeScaleExp, eventNumber, value));
     this->bufferedSamples++;
+    vp->recentSamples++;
 
     // update vector statistics
     if (vp->currentBlock.statistics.getCount() == 0) {
@@ -222,10 +301,13 @@ void OmnetppVectorFileWriter::recordInVector(void *vectorhandle, eventnumber_t e
     vp->currentBlock.statistics.collect(value);
 
     // write out block if necessary
-    if (vp->bufferedSamplesLimit > 0 && (int)vp->buffer.size() >= vp->bufferedSamplesLimit)
+    if (vp->bufferedSamplesLimit > 0 && (long)vp->buffer.size() >= vp->bufferedSamplesLimit)
         writeBlock(vp);
     else if (bufferedSamplesLimit > 0 && bufferedSamples >= bufferedSamplesLimit)
-        writeRecords();
+        writeLargestBuffers();
+
+    if (adaptiveBufferSizes && bufferedSamplesLimit > 0 && ++samplesSinceRebalance >= std::max(bufferedSamplesLimit / 8, MIN_REBALANCE_INTERVAL))
+        rebalanceBufferSizes();
 }
 
 void OmnetppVectorFileWriter::writeRecords()
@@ -235,6 +317,49 @@ void OmnetppVectorFileWriter::writeRecords()
             writeBlock(vp);
 }
 
+void OmnetppVectorFileWriter::writeLargestBuffers()
+{
+    // write out the largest buffers until at least half of the buffer space is free;
+    // small buffers (rarely recorded vectors) are left to grow into larger blocks
+    flushCandidates.clear();
+    for (auto vp : vectors)
+        if (!vp->buffer.empty())
+            flushCandidates.push_back(vp);
+    std::sort(flushCandidates.begin(), flushCandidates.end(), [](VectorData *a, VectorData *b) {return a->buffer.size() > b->buffer.size();});
+
+    for (auto vp : flushCandidates) {
+        if (bufferedSamples <= bufferedSamplesLimit / 2)
+            break;
+        writeBlock(vp);
+    }
+}
+
+void OmnetppVectorFileWriter::rebalanceBufferSizes()
+{
+    samplesSinceRebalance = 0;
+
+    // update recording rates (samples per rebalancing period, decaying to follow changes)
+    double totalRate = 0;
+    for (auto vp : vectors) {
+        vp->recordingRate = vp->recordingRate / 2 + vp->recentSamples;
+        vp->recentSamples = 0;
+        totalRate += vp->recordingRate;
+    }
+    if (totalRate == 0)
+        return;
+
+    // give each vector a share of the buffer space proportional to its rate, but
+    // never less than configured, and never so much that a single vector triggers
+    // writeLargestBuffers() on its own
+    long maxLimit = bufferedSamplesLimit / 2;
+    for (auto vp : vectors) {
+        if (vp->configuredSamplesLimit == 0)
+            continue; // no per-vector limit
+        long share = (long)(bufferedSamplesLimit * (vp->recordingRate / totalRate));
+        vp->bufferedSamplesLimit = std::max(vp->configuredSamplesLimit, std::min(share, maxLimit));
+    }
+}
+
 void OmnetppVectorFileWriter::writeBlock(VectorData *vp)
 {
     Assert(f != nullptr);
@@ -242,54 +367,154 @@ void OmnetppVectorFileWriter::writeBlock(VectorData *vp)
     Assert(vp != nullptr);
     Assert(!vp->buffer.empty());
 
-    char buf[64], buf2[64];
+    size_t count = vp->buffer.size();
+    int bin = 0;
+    while ((count >> (bin+1)) != 0)
+        bin++;
+    if ((int)blockSizeHistogram.size() <= bin)
+        blockSizeHistogram.resize(bin+1);
+    blockSizeHistogram[bin]++;
 
-    Block& currentBlock = vp->currentBlock;
-    currentBlock.offset = opp_ftell(f);
-
-    if (vp->recordEventNumbers) {
-        for (auto sample : vp->buffer)
-            check(fprintf(f, "%d\t%" PRId64 "\t%s\t%.*g\n", vp->id, sample.eventNumber, sample.time.ttoa(buf), prec, sample.value));
-    }
+    if (!worker)
+        writeBlockData(vp->id, vp->recordEventNumbers, vp->buffer, vp->currentBlock);
     else {
-        for (auto sample : vp->buffer)
-            check(fprintf(f, "%d\t%s\t%.*g\n", vp->id, sample.time.ttoa(buf), prec, sample.value));
+        // hand over the samples to the background thread, and continue with a fresh buffer
+        std::shared_ptr<Samples> samples = std::make_shared<Samples>();
+        samples->swap(vp->buffer);
+        if (vp->configuredSamplesLimit > 0)
+            vp->buffer.reserve(vp->configuredSamplesLimit);
+        int id = vp->id;
+        bool recordEventNumbers = vp->recordEventNumbers;
+        Block block = vp->currentBlock;
+        execute(count * sizeof(Sample), [this, id, recordEventNumbers, samples, block]() mutable {
+            writeBlockData(id, recordEventNumbers, *samples, block);
+        });
     }
 
-    currentBlock.size = opp_ftell(f) - currentBlock.offset;
+    vp->currentBlock.reset();
+    bufferedSamples -= count;
+    vp->buffer.clear();
+}
+
+void OmnetppVectorFileWriter::writeBlockData(int vectorId, bool recordEventNumbers, const Samples& samples, Block& block)
+{
+    block.offset = opp_ftell(f);
+
+    if (binary)
+        writeBinaryBlockData(vectorId, recordEventNumbers, samples);
+    else
+        writeTextBlockData(vectorId, recordEventNumbers, samples);
+
+    block.size = opp_ftell(f) - block.offset;
 
-    Block& block = vp->currentBlock;
     Statistics& stats = block.statistics;
 
     // make sure that the offsets referred by the index file are exists in the vector file
     // so the index can be used to access the vector file while it is being written
     fflush(f);
 
-    if (vp->recordEventNumbers) {
-        checki(fprintf(fi, "%d\t%" PRId64 " %" PRId64 " %" PRId64 " %" PRId64 " %s %s %" PRId64 " %.*g %.*g %.*g %.*g\n",
-                vp->id, block.offset, block.size,
-                block.startEventNum, block.endEventNum,
-                block.startTime.ttoa(buf), block.endTime.ttoa(buf2),
-                stats.getCount(), prec, stats.getMin(), prec, stats.getMax(), prec, stats.getSum(), prec, stats.getSumSqr()));
+    // index line: "<id>\t<offset> <size> [<startEventNum> <endEventNum>] <startTime> <endTime> <count> <min> <max> <sum> <sumsqr>"
+    TextBuffer& b = textBuffer;
+    b.appendInt(vectorId);
+    b.append('\t');
+    b.appendInt(block.offset);
+    b.append(' ');
+    b.appendInt(block.size);
+    b.append(' ');
+    if (recordEventNumbers) {
+        b.appendInt(block.startEventNum);
+        b.append(' ');
+        b.appendInt(block.endEventNum);
+        b.append(' ');
     }
-    else {
-        checki(fprintf(fi, "%d\t%" PRId64 " %" PRId64 " %s %s %" PRId64 " %.*g %.*g %.*g %.*g\n",
-                vp->id, block.offset, block.size,
-                block.startTime.ttoa(buf), block.endTime.ttoa(buf2),
-                stats.getCount(), prec, stats.getMin(), prec, stats.getMax(), prec, stats.getSum(), prec, stats.getSumSqr()));
+    b.appendSimtime(block.startTime.t, block.startTime.scaleExp);
+    b.append(' ');
+    b.appendSimtime(block.endTime.t, block.endTime.scaleExp);
+    b.append(' ');
+    b.appendInt(stats.getCount());
+    for (double x : {stats.getMin(), stats.getMax(), stats.getSum(), stats.getSumSqr()}) {
+        b.append(' ');
+        b.appendDouble(x, prec);
     }
+    b.append('\n');
+    checki(b.writeTo(fi) ? 0 : -1);
 
     fflush(fi);
-    block.reset();
+}
 
-    bufferedSamples -= vp->buffer.size();
-    vp->buffer.clear();
+void OmnetppVectorFileWriter::writeBlockSizeHistogram(const std::vector<int64_t>& histogram)
+{
+    // comment line in the index file, e.g. "# blocks: 14, samples per block: 1-1: 2, 256-511: 12"
+    int64_t numBlocks = 0;
+    for (int64_t n : histogram)
+        numBlocks += n;
+    if (numBlocks == 0)
+        return;
+    TextBuffer& b = textBuffer;
+    b.append("# blocks: ");
+    b.appendInt(numBlocks);
+    b.append(", samples per block:");
+    const char *sep = " ";
+    for (size_t i = 0; i < histogram.size(); i++) {
+        if (histogram[i] == 0)
+            continue;
+        b.append(sep);
+        b.appendInt((int64_t)1 << i);
+        b.append('-');
+        b.appendInt(((int64_t)2 << i) - 1);
+        b.append(": ");
+        b.appendInt(histogram[i]);
+        sep = ", ";
+    }
+    b.append('\n');
+    checki(b.writeTo(fi) ? 0 : -1);
+}
+
+void OmnetppVectorFileWriter::writeTextBlockData(int vectorId, bool recordEventNumbers, const Samples& samples)
+{
+    // one line per sample: "<id>\t[<eventNumber>\t]<time>\t<value>"
+    TextBuffer& b = textBuffer;
+    for (const Sample& sample : samples) {
+        b.appendInt(vectorId);
+        b.append('\t');
+        if (recordEventNumbers) {
+            b.appendInt(sample.eventNumber);
+            b.append('\t');
+        }
+        b.appendSimtime(sample.time.t, sample.time.scaleExp);
+        b.append('\t');
+        b.appendDouble(sample.value, prec);
+        b.append('\n');
+        if (b.getLength() >= TEXT_BUFFER_FLUSH_SIZE)
+            check(b.writeTo(f) ? 0 : -1);
+    }
+    check(b.writeTo(f) ? 0 : -1);
+}
+
+void OmnetppVectorFileWriter::writeBinaryBlockData(int vectorId, bool recordEventNumbers, const Samples& samples)
+{
+    // split samples into columns, and let the codec do the rest
+    size_t count = samples.size();
+    eventNumberColumn.resize(count);
+    timeColumn.resize(count);
+    valueColumn.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        const Sample& sample = samples[i];
+        eventNumberColumn[i] = sample.eventNumber;
+        timeColumn[i] = sample.time.t;
+        valueColumn[i] = sample.value;
+    }
+
+    int scaleExp = samples[0].time.scaleExp;  // same for all samples
+    const std::string& block = codec.encodeBlock(vectorId, scaleExp, count, recordEventNumbers ? eventNumberColumn.data() : nullptr, timeColumn.data(), valueColumn.data(), compress);
+    check(fwrite(block.data(), 1, block.size(), f) == block.size() ? 0 : -1);
 }
 
 void OmnetppVectorFileWriter::flush()
 {
     Assert(isOpen());
     writeRecords();  // flushes both files
+    flushWorker();
 }
 
 
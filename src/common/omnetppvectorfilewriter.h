@@ -21,16 +21,41 @@
 #include <string>
 #include <map>
 #include <vector>
+#include <functional>
 #include "commondefs.h"
 #include "statistics.h"
+#include "binaryvectorcodec.h"
+#include "textbuffer.h"
 #include "omnetpp/platdep/platmisc.h"  // file_offset_t
 
 namespace omnetpp {
 namespace common {
 
 
+class BackgroundWorker;
+
 /**
- * Class for writing text-based output vector files.
+ * Class for writing output vector files. Vector data are written either
+ * as text lines, or in binary form (see BinaryVectorCodec); the index file
+ * is the same for both.
+ *
+ * Optionally, all formatting and file output can be done in a background
+ * thread (see setBackgroundWriting()). Filled sample buffers are then handed
+ * over to the thread, and recording only blocks if the amount of data waiting
+ * to be written exceeds the given limit. Write errors are reported by a
+ * subsequent call on the simulation thread.
+ *
+ * Buffer management: a vector's samples are written out as a block when its
+ * buffer reaches the per-vector limit. When the total number of buffered
+ * samples reaches the overall limit, the largest buffers are written out
+ * until half of the overall buffer space is freed, so rarely recorded vectors
+ * keep accumulating samples instead of being flushed as tiny blocks. With
+ * adaptive buffer sizes (see setAdaptiveBufferSizes()), per-vector limits are
+ * periodically recomputed from the observed recording rates: each vector may
+ * use a share of the overall buffer space proportional to its rate, but at
+ * least its configured buffer size. Statistics of the written block sizes
+ * are available via getBlockSizeHistogram(), and are also written into the
+ * index file as a comment at the end of each run.
  */
 class COMMON_API OmnetppVectorFileWriter
 {
@@ -76,6 +101,9 @@ class COMMON_API OmnetppVectorFileWriter
        int id;                    // vector ID
        Samples buffer;            // buffer holding recorded data not yet written to the file
        long bufferedSamplesLimit; // maximum number of samples gathered in the buffer before writing out (0=no limit)
+       long configuredSamplesLimit; // bufferedSamplesLimit as configured; the minimum with adaptive buffer sizes
+       long recentSamples;        // number of samples recorded since the last rebalancing of buffer sizes
+       double recordingRate;      // exponentially decaying average of recentSamples
        bool recordEventNumbers;   // record the current event number for each sample
        Block currentBlock;
     };
@@ -85,6 +113,8 @@ class COMMON_API OmnetppVectorFileWriter
     std::string fname;   // output file name
     FILE *f;             // file ptr of output file
     int prec = 14;       // number of significant digits when writing doubles
+    bool binary = false; // write vector data as binary blocks
+    bool compress = false; // compress binary blocks
     int nextVectorId;    // holds next free ID for output vectors
 
     std::string ifname;  // index file name
@@ -93,14 +123,38 @@ class COMMON_API OmnetppVectorFileWriter
     Vectors vectors;           // registered output vectors
     int bufferedSamples;       // currently total buffered samples
     int bufferedSamplesLimit;  // limit of total buffered samples (0=no limit)
+    bool adaptiveBufferSizes = false; // adjust per-vector buffer limits to recording rates
+    long samplesSinceRebalance = 0;   // samples recorded since the last rebalanceBufferSizes() call
+    Vectors flushCandidates;          // scratch space for writeLargestBuffers()
+    std::vector<int64_t> blockSizeHistogram; // number of blocks written in the current run, by log2 of their sample count
+
+    BinaryVectorCodec codec;   // encoder of binary blocks
+    std::vector<int64_t> eventNumberColumn;  // column buffers for binary blocks, reused across blocks
+    std::vector<int64_t> timeColumn;
+    std::vector<double> valueColumn;
+    TextBuffer textBuffer;     // for formatting text lines, reused across blocks
+
+    bool backgroundWriting = false;   // write files from a background thread
+    size_t backgroundQueueLimit = 0;  // max. bytes of sample data waiting for the background thread
+    BackgroundWorker *worker = nullptr; // only exists while the file is open
 
   protected:
     void cleanup();  // MUST NOT THROW
     void check(int fprintfResult);
     void checki(int fprintfResult);
+    virtual void writeRunHeader(const std::string& runName, const StringMap& attributes, const StringMap& itervars, const OrderedKeyValueList& configEntries);
+    virtual void writeVectorDeclaration(int id, const std::string& componentFullPath, const std::string& name, const StringMap& attributes, bool recordEventNumbers);
     virtual void writeRecords();
+    virtual void writeLargestBuffers();
+    virtual void rebalanceBufferSizes();
+    virtual void writeBlockSizeHistogram(const std::vector<int64_t>& histogram);
     virtual void writeBlock(VectorData *vp);
+    virtual void writeBlockData(int vectorId, bool recordEventNumbers, const Samples& samples, Block& block);
+    virtual void writeTextBlockData(int vectorId, bool recordEventNumbers, const Samples& samples);
+    virtual void writeBinaryBlockData(int vectorId, bool recordEventNumbers, const Samples& samples);
     virtual void finalizeVector(VectorData *vp);
+    void execute(size_t cost, const std::function<void()>& task); // runs the task in the background thread if there is one
+    void flushWorker(); // waits until the background thread has written everything
 
   public:
     OmnetppVectorFileWriter();
@@ -112,8 +166,17 @@ class COMMON_API OmnetppVectorFileWriter
 
     void setPrecision(int p) {prec = p;}
     int getPrecision() const {return prec;}
+    void setBinary(bool b) {binary = b;} // must be called before open()
+    bool isBinary() const {return binary;}
+    void setCompression(bool b) {compress = b;} // only affects binary files
+    bool getCompression() const {return compress;}
+    void setBackgroundWriting(bool enabled, size_t queueMemoryLimit); // must be called before open()
+    bool getBackgroundWriting() const {return backgroundWriting;}
     void setOverallMemoryLimit(size_t limit) {bufferedSamplesLimit = limit / sizeof(Sample);}
     size_t getOverallMemoryLimit() const {return bufferedSamplesLimit * sizeof(Sample);}
+    void setAdaptiveBufferSizes(bool enabled) {adaptiveBufferSizes = enabled;} // only effective with an overall memory limit
+    bool getAdaptiveBufferSizes() const {return adaptiveBufferSizes;}
+    const std::vector<int64_t>& getBlockSizeHistogram() const {return blockSizeHistogram;} // element i: number of blocks with 2^i..2^(i+1)-1 samples
 
     void beginRecordingForRun(const std::string& runName, const StringMap& attributes, const StringMap& itervars, const OrderedKeyValueList& paramAssignments);
     void endRecordingForRun();
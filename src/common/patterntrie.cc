@@ -0,0 +1,223 @@
+//==========================================================================
+//  PATTERNTRIE.CC - part of
+//                     OMNeT++/OMNEST
+//             Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <algorithm>
+#include "opp_ctype.h"
+#include "patternmatcher.h"
+#include "patterntrie.h"
+
+namespace omnetpp {
+namespace common {
+
+struct PatternTrie::MatchState {
+    const char *path;
+    std::string pathCopy;  // path with the dots replaced by '\0'
+    std::vector<const char *> segments;  // point into pathCopy
+    const std::function<bool(int)>& accept;
+    int best;
+
+    MatchState(const char *path, const std::function<bool(int)>& accept) : path(path), pathCopy(path), accept(accept), best(INT_MAX) {}
+    const char *getRest(int k) const {return path + (segments[k] - pathCopy.c_str());}
+    bool isAccepted(int id) const {return !accept || accept(id);}
+};
+
+PatternTrie::Node::~Node()
+{
+    for (auto& child : literalChildren)
+        delete child.second;
+    for (auto& child : wildcardChildren) {
+        delete child.first;
+        delete child.second;
+    }
+    delete anySeqChild;
+    for (auto& rest : restPatterns)
+        delete rest.first;
+}
+
+PatternTrie::PatternTrie()
+{
+    root = new Node();
+}
+
+PatternTrie::~PatternTrie()
+{
+    delete root;
+}
+
+void PatternTrie::clear()
+{
+    delete root;
+    root = new Node();
+    numPatterns = 0;
+}
+
+// If s points to a numeric range ("{10..20}" or "[10..20]"), returns the
+// position of the closing bracket, otherwise nullptr. Cf. PatternMatcher::parseNumRange().
+static const char *skipNumRange(const char *s)
+{
+    char closingChar = *s == '{' ? '}' : ']';
+    s++;
+    while (opp_isdigit(*s))
+        s++;
+    if (*s != '.' || *(s+1) != '.')
+        return nullptr;
+    s += 2;
+    while (opp_isdigit(*s))
+        s++;
+    return *s == closingChar ? s : nullptr;
+}
+
+const char *PatternTrie::splitPattern(const char *pattern, std::vector<std::string>& segments)
+{
+    // Splits the pattern at the dots. Splitting stops at the first segment
+    // that may match a dot, i.e. one that contains a "**" other than
+    // the whole segment, a character set, or a backslash (which might
+    // be escaping a dot); the rest of the pattern from that segment on
+    // is returned.
+    const char *segmentStart = pattern;
+    const char *s = pattern;
+    while (true) {
+        if (*s == '\0' || *s == '.') {
+            std::string segment(segmentStart, s);
+            if (segment != "**" && segment.find("**") != std::string::npos)
+                return segmentStart;
+            segments.push_back(segment);
+            if (*s == '\0')
+                return nullptr;
+            segmentStart = ++s;
+        }
+        else if (*s == '\\')
+            return segmentStart;
+        else if (*s == '{' || *s == '[') {
+            const char *closingBracket = skipNumRange(s);
+            if (closingBracket)
+                s = closingBracket + 1;
+            else if (*s == '{')
+                return segmentStart; // character set
+            else
+                s++;
+        }
+        else
+            s++;
+    }
+}
+
+void PatternTrie::add(const char *pattern, int id)
+{
+    std::vector<std::string> segments;
+    const char *rest = splitPattern(pattern, segments);
+
+    // create the pattern matchers first, so that the trie remains intact if they throw
+    PatternMatcher *restPattern = rest ? new PatternMatcher(rest, true, true, true) : nullptr;
+
+    std::vector<Node *> visitedNodes;
+    Node *node = root;
+    visitedNodes.push_back(node);
+    for (const std::string& segment : segments) {
+        if (segment == "**") {
+            if (!node->anySeqChild)
+                node->anySeqChild = new Node();
+            node = node->anySeqChild;
+        }
+        else if (!PatternMatcher::containsWildcards(segment.c_str())) {
+            Node *& child = node->literalChildren[segment];
+            if (!child)
+                child = new Node();
+            node = child;
+        }
+        else {
+            auto it = std::find(node->wildcardChildPatterns.begin(), node->wildcardChildPatterns.end(), segment);
+            if (it != node->wildcardChildPatterns.end())
+                node = node->wildcardChildren[it - node->wildcardChildPatterns.begin()].second;
+            else {
+                PatternMatcher *segmentPattern = new PatternMatcher(segment.c_str(), true, true, true);
+                Node *child = new Node();
+                node->wildcardChildren.push_back(std::make_pair(segmentPattern, child));
+                node->wildcardChildPatterns.push_back(segment);
+                node = child;
+            }
+        }
+        visitedNodes.push_back(node);
+    }
+
+    if (restPattern)
+        node->restPatterns.push_back(std::make_pair(restPattern, id));
+    else
+        node->ids.insert(std::upper_bound(node->ids.begin(), node->ids.end(), id), id);
+    for (Node *visitedNode : visitedNodes)
+        visitedNode->minId = std::min(visitedNode->minId, id);
+    numPatterns++;
+}
+
+int PatternTrie::findFirstMatch(const char *path, const std::function<bool(int)>& accept) const
+{
+    if (root->minId == INT_MAX)
+        return -1;  // empty
+
+    MatchState state(path, accept);
+    char *s = &state.pathCopy[0];
+    state.segments.push_back(s);
+    for ( ; *s; s++) {
+        if (*s == '.') {
+            *s = '\0';
+            state.segments.push_back(s + 1);
+        }
+    }
+
+    doMatch(root, 0, state);
+    return state.best == INT_MAX ? -1 : state.best;
+}
+
+void PatternTrie::doMatch(const Node *node, int k, MatchState& state) const
+{
+    // node represents the first k segments of the path being matched;
+    // nothing to do if we already have a better match than anything in this subtree
+    if (node->minId >= state.best)
+        return;
+
+    int numSegments = state.segments.size();
+    if (k == numSegments) {
+        for (int id : node->ids) {
+            if (id >= state.best)
+                break;
+            if (state.isAccepted(id)) {
+                state.best = id;
+                break;
+            }
+        }
+        return;
+    }
+
+    for (const auto& rest : node->restPatterns)
+        if (rest.second < state.best && rest.first->matches(state.getRest(k)) && state.isAccepted(rest.second))
+            state.best = rest.second;
+
+    const char *segment = state.segments[k];
+    auto it = node->literalChildren.find(segment);
+    if (it != node->literalChildren.end())
+        doMatch(it->second, k+1, state);
+
+    for (const auto& child : node->wildcardChildren)
+        if (child.second->minId < state.best && child.first->matches(segment))
+            doMatch(child.second, k+1, state);
+
+    // "**" matches one or more segments
+    if (node->anySeqChild)
+        for (int j = k+1; j <= numSegments; j++)
+            doMatch(node->anySeqChild, j, state);
+}
+
+}  // namespace common
+}  // namespace omnetpp
+
@@ -0,0 +1,106 @@
+//==========================================================================
+//  PATTERNTRIE.H - part of
+//                     OMNeT++/OMNEST
+//             Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_COMMON_PATTERNTRIE_H
+#define __OMNETPP_COMMON_PATTERNTRIE_H
+
+#include <climits>
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include "commondefs.h"
+
+namespace omnetpp {
+namespace common {
+
+class PatternMatcher;
+
+/**
+ * Matches a dotted path (e.g. a module full path) against a set of
+ * PatternMatcher patterns at once, and returns the first matching one.
+ * Patterns are interpreted with dottedpath=true, fullstring=true and
+ * casesensitive=true, that is, in the way omnetpp.ini keys are.
+ *
+ * Patterns are split into segments at the dots, and stored in a trie of
+ * segments, so that patterns with a common prefix (e.g. "**.host[*]") share
+ * nodes, and literal segments are looked up in a map instead of being
+ * matched one by one. A "**" segment is matched against one or more path
+ * segments. Segments that might match across a dot (ones that contain "**"
+ * within a segment, a character set or a backslash) cannot be represented in
+ * the trie; from such a segment on, the rest of the pattern is matched with
+ * a PatternMatcher against the rest of the path.
+ *
+ * Every pattern has an integer id; "first match" means the matching pattern
+ * with the smallest id.
+ */
+class COMMON_API PatternTrie
+{
+  private:
+    struct Node {
+        std::map<std::string, Node*, std::less<>> literalChildren;
+        std::vector<std::pair<PatternMatcher*, Node*>> wildcardChildren;
+        std::vector<std::string> wildcardChildPatterns; // same indices as wildcardChildren
+        Node *anySeqChild = nullptr; // "**" segment
+        std::vector<std::pair<PatternMatcher*, int>> restPatterns; // patterns to be matched against the rest of the path
+        std::vector<int> ids; // patterns ending at this node, in increasing order
+        int minId = INT_MAX; // smallest id in this subtree
+        ~Node();
+    };
+
+    Node *root;
+    int numPatterns = 0;
+
+    struct MatchState;
+
+  private:
+    static const char *splitPattern(const char *pattern, std::vector<std::string>& segments);
+    void doMatch(const Node *node, int k, MatchState& state) const;
+
+  public:
+    PatternTrie();
+    ~PatternTrie();
+    PatternTrie(const PatternTrie&) = delete;
+    PatternTrie& operator=(const PatternTrie&) = delete;
+
+    /**
+     * Adds a pattern with the given id. Throws an exception if the pattern
+     * is bogus.
+     */
+    void add(const char *pattern, int id);
+
+    /**
+     * Removes all patterns.
+     */
+    void clear();
+
+    /**
+     * Returns the number of patterns added.
+     */
+    int size() const {return numPatterns;}
+
+    /**
+     * Returns the smallest id among the patterns that match the given path,
+     * or -1 if there is no match. If the accept function is given, patterns
+     * for which it returns false are ignored.
+     */
+    int findFirstMatch(const char *path, const std::function<bool(int)>& accept=nullptr) const;
+};
+
+}  // namespace common
+}  // namespace omnetpp
+
+
+#endif
+
@@ -151,6 +151,17 @@ const char SQL_CREATE_TABLES[] =
             "value         REAL " // cannot be NOT NULL because of NaN values
         "); "
         ""
+        "CREATE TABLE IF NOT EXISTS vectorBlock "
+        "( "
+            "vectorId        INTEGER NOT NULL REFERENCES vector(vectorId) ON DELETE CASCADE, "
+            "startEventNum   INTEGER NOT NULL, "
+            "endEventNum     INTEGER NOT NULL, "
+            "startSimtimeRaw INTEGER NOT NULL, "
+            "endSimtimeRaw   INTEGER NOT NULL, "
+            "count           INTEGER NOT NULL, "
+            "data            BLOB NOT NULL " // a block in the binary vector file format, see BinaryVectorCodec
+        "); "
+        ""
         "COMMIT TRANSACTION; "
         ""
         "PRAGMA synchronous = OFF; "
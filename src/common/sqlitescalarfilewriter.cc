@@ -22,6 +22,8 @@
 namespace omnetpp {
 namespace common {
 
+#define MULTIROW_INSERT_SIZE  64      // rows per multi-row INSERT; 3 parameters per row, SQLite's limit is 999
+
 SqliteScalarFileWriter::SqliteScalarFileWriter()
 {
     runId = -1;
@@ -29,13 +31,13 @@ SqliteScalarFileWriter::SqliteScalarFileWriter()
     stmt = nullptr;
     add_scalar_stmt = nullptr;
     add_scalar_attr_stmt = nullptr;
+    add_scalar_attr_multirow_stmt = nullptr;
     add_statistic_stmt = nullptr;
     add_statistic_attr_stmt = nullptr;
     add_statistic_bin_stmt = nullptr;
     add_parameter_stmt = nullptr;
     add_parameter_attr_stmt = nullptr;
 
-    commitFreq = 0;
     insertCount = 0;
 }
 
@@ -82,9 +84,11 @@ void SqliteScalarFileWriter::open(const char *filename)
 void SqliteScalarFileWriter::close()
 {
     if (db) {
+        insertPendingScalarAttrs();
         finalizeStatement(stmt);
         finalizeStatement(add_scalar_stmt);
         finalizeStatement(add_scalar_attr_stmt);
+        finalizeStatement(add_scalar_attr_multirow_stmt);
         finalizeStatement(add_statistic_stmt);
         finalizeStatement(add_statistic_attr_stmt);
         finalizeStatement(add_statistic_bin_stmt);
@@ -107,6 +111,7 @@ void SqliteScalarFileWriter::cleanup()  // MUST NOT THROW
         finalizeStatement(stmt);
         finalizeStatement(add_scalar_stmt);
         finalizeStatement(add_scalar_attr_stmt);
+        finalizeStatement(add_scalar_attr_multirow_stmt);
         finalizeStatement(add_statistic_stmt);
         finalizeStatement(add_statistic_attr_stmt);
         finalizeStatement(add_statistic_bin_stmt);
@@ -122,6 +127,8 @@ void SqliteScalarFileWriter::cleanup()  // MUST NOT THROW
         runId = -1;
         fname = "";
     }
+    pendingScalarAttrs.clear();
+    pendingAttrText.clear();
 }
 
 void SqliteScalarFileWriter::prepareStatement(sqlite3_stmt *&stmt, const char *sql)
@@ -139,6 +146,11 @@ void SqliteScalarFileWriter::prepareStatements()
 {
     prepareStatement(add_scalar_stmt, "INSERT INTO scalar (runId, moduleName, scalarName, scalarValue) VALUES (?, ?, ?, ?);");
     prepareStatement(add_scalar_attr_stmt, "INSERT INTO scalarAttr (scalarId, attrName, attrValue) VALUES (?, ?, ?);");
+
+    std::string sql = "INSERT INTO scalarAttr (scalarId, attrName, attrValue) VALUES (?, ?, ?)";
+    for (int i = 1; i < MULTIROW_INSERT_SIZE; i++)
+        sql += ", (?, ?, ?)";
+    prepareStatement(add_scalar_attr_multirow_stmt, (sql + ";").c_str());
     prepareStatement(add_statistic_stmt,
             "INSERT INTO statistic (runId, moduleName, statName, isHistogram, isWeighted, "
             "statCount, statMean, statStddev, statMin, statMax, statSum, statSqrsum, "
@@ -202,15 +214,16 @@ void SqliteScalarFileWriter::beginRecordingForRun(const std::string& runName, in
 
 void SqliteScalarFileWriter::endRecordingForRun()
 {
+    insertPendingScalarAttrs();
     runId = -1;
 }
 
-sqlite_int64 SqliteScalarFileWriter::writeScalar(const std::string& componentFullPath, const std::string& name, double value)
+sqlite_int64 SqliteScalarFileWriter::writeScalar(const char *componentFullPath, const char *name, double value)
 {
     checkOK(sqlite3_reset(add_scalar_stmt));
     checkOK(sqlite3_bind_int64(add_scalar_stmt, 1, runId));
-    checkOK(sqlite3_bind_text(add_scalar_stmt, 2, componentFullPath.c_str(), componentFullPath.size(), SQLITE_STATIC));
-    checkOK(sqlite3_bind_text(add_scalar_stmt, 3, name.c_str(), name.length(), SQLITE_STATIC));
+    checkOK(sqlite3_bind_text(add_scalar_stmt, 2, componentFullPath, -1, SQLITE_STATIC));
+    checkOK(sqlite3_bind_text(add_scalar_stmt, 3, name, -1, SQLITE_STATIC));
     checkOK(sqlite3_bind_double(add_scalar_stmt, 4, value));
     checkDone(sqlite3_step(add_scalar_stmt));
     checkOK(sqlite3_clear_bindings(add_scalar_stmt));
@@ -220,34 +233,76 @@ sqlite_int64 SqliteScalarFileWriter::writeScalar(const std::string& componentFul
 
 void SqliteScalarFileWriter::writeScalarAttr(sqlite_int64 scalarId, const char *name, size_t nameLength, const char *value, size_t valueLength)
 {
-    checkOK(sqlite3_reset(add_scalar_attr_stmt));
-    checkOK(sqlite3_bind_int64(add_scalar_attr_stmt, 1, scalarId));
-    checkOK(sqlite3_bind_text(add_scalar_attr_stmt, 2, name, nameLength, SQLITE_STATIC));
-    checkOK(sqlite3_bind_text(add_scalar_attr_stmt, 3, value, valueLength, SQLITE_STATIC));
-    checkDone(sqlite3_step(add_scalar_attr_stmt));
-    checkOK(sqlite3_clear_bindings(add_scalar_attr_stmt));
+    // strings are copied, because they need to stay valid until inserted
+    PendingAttr attr;
+    attr.scalarId = scalarId;
+    attr.nameOffset = pendingAttrText.size();
+    attr.nameLength = nameLength;
+    pendingAttrText.append(name, nameLength);
+    attr.valueOffset = pendingAttrText.size();
+    attr.valueLength = valueLength;
+    pendingAttrText.append(value, valueLength);
+    pendingScalarAttrs.push_back(attr);
+
+    if ((int)pendingScalarAttrs.size() >= MULTIROW_INSERT_SIZE)
+        insertPendingScalarAttrs();
+}
+
+void SqliteScalarFileWriter::insertPendingScalarAttrs()
+{
+    const char *text = pendingAttrText.data();
+    size_t n = pendingScalarAttrs.size();
+    size_t i = 0;
+
+    for ( ; i + MULTIROW_INSERT_SIZE <= n; i += MULTIROW_INSERT_SIZE) {
+        checkOK(sqlite3_reset(add_scalar_attr_multirow_stmt));
+        int k = 1;
+        for (size_t j = i; j < i + MULTIROW_INSERT_SIZE; j++) {
+            const PendingAttr& attr = pendingScalarAttrs[j];
+            checkOK(sqlite3_bind_int64(add_scalar_attr_multirow_stmt, k++, attr.scalarId));
+            checkOK(sqlite3_bind_text(add_scalar_attr_multirow_stmt, k++, text + attr.nameOffset, attr.nameLength, SQLITE_STATIC));
+            checkOK(sqlite3_bind_text(add_scalar_attr_multirow_stmt, k++, text + attr.valueOffset, attr.valueLength, SQLITE_STATIC));
+        }
+        checkDone(sqlite3_step(add_scalar_attr_multirow_stmt));
+    }
+
+    for ( ; i < n; i++) {
+        const PendingAttr& attr = pendingScalarAttrs[i];
+        checkOK(sqlite3_reset(add_scalar_attr_stmt));
+        checkOK(sqlite3_bind_int64(add_scalar_attr_stmt, 1, attr.scalarId));
+        checkOK(sqlite3_bind_text(add_scalar_attr_stmt, 2, text + attr.nameOffset, attr.nameLength, SQLITE_STATIC));
+        checkOK(sqlite3_bind_text(add_scalar_attr_stmt, 3, text + attr.valueOffset, attr.valueLength, SQLITE_STATIC));
+        checkDone(sqlite3_step(add_scalar_attr_stmt));
+    }
+
+    pendingScalarAttrs.clear();
+    pendingAttrText.clear();
 }
 
 void SqliteScalarFileWriter::recordScalar(const std::string& componentFullPath, const std::string& name, double value, const StringMap& attributes)
 {
     Assert(runId != -1); // ensure run data has been written out
-    sqlite3_int64 scalarId = writeScalar(componentFullPath, name, value);
+    sqlite3_int64 scalarId = writeScalar(componentFullPath.c_str(), name.c_str(), value);
     for (const auto & attribute : attributes)
         writeScalarAttr(scalarId, attribute.first.c_str(), attribute.first.size(), attribute.second.c_str(), attribute.second.size());
+    commitIfNeeded();
+}
 
-    // commit every once in a while
-    if (++insertCount >= commitFreq) {
-        insertCount = 0;
-        commitAndBeginNew();
-    }
+void SqliteScalarFileWriter::recordScalar(const char *componentFullPath, const char *name, double value, const AttributeList& attributes)
+{
+    Assert(runId != -1); // ensure run data has been written out
+    sqlite3_int64 scalarId = writeScalar(componentFullPath, name, value);
+    for (const auto & attribute : attributes)
+        writeScalarAttr(scalarId, attribute.first, strlen(attribute.first), attribute.second, strlen(attribute.second));
+    commitIfNeeded();
 }
 
-sqlite_int64 SqliteScalarFileWriter::writeStatistic(const std::string& componentFullPath, const std::string& name, const Statistics& statistic, bool isHistogram)
+sqlite_int64 SqliteScalarFileWriter::writeStatistic(const char *componentFullPath, const char *name, const Statistics& statistic, bool isHistogram)
 {
     checkOK(sqlite3_reset(add_statistic_stmt));
     checkOK(sqlite3_bind_int64(add_statistic_stmt, 1, runId));
-    checkOK(sqlite3_bind_text(add_statistic_stmt, 2, componentFullPath.c_str(), componentFullPath.size(), SQLITE_STATIC));
-    checkOK(sqlite3_bind_text(add_statistic_stmt, 3, name.c_str(), name.size(), SQLITE_STATIC));
+    checkOK(sqlite3_bind_text(add_statistic_stmt, 2, componentFullPath, -1, SQLITE_STATIC));
+    checkOK(sqlite3_bind_text(add_statistic_stmt, 3, name, -1, SQLITE_STATIC));
     checkOK(sqlite3_bind_int(add_statistic_stmt, 4, (int)isHistogram));
     checkOK(sqlite3_bind_int(add_statistic_stmt, 5, (int)statistic.isWeighted()));
     checkOK(sqlite3_bind_int64(add_statistic_stmt, 6, statistic.getCount()));
@@ -274,23 +329,39 @@ sqlite_int64 SqliteScalarFileWriter::writeStatistic(const std::string& component
 void SqliteScalarFileWriter::recordStatistic(const std::string& componentFullPath, const std::string& name, const Statistics& statistic, const StringMap& attributes)
 {
     Assert(runId != -1); // ensure run data has been written out
-    sqlite3_int64 statisticId = writeStatistic(componentFullPath, name, statistic, false);
+    sqlite3_int64 statisticId = writeStatistic(componentFullPath.c_str(), name.c_str(), statistic, false);
     for (const auto & attribute : attributes)
         writeStatisticAttr(statisticId, attribute.first.c_str(), attribute.second.c_str());
+    commitIfNeeded();
+}
+
+void SqliteScalarFileWriter::recordStatistic(const char *componentFullPath, const char *name, const Statistics& statistic, const AttributeList& attributes)
+{
+    Assert(runId != -1); // ensure run data has been written out
+    sqlite3_int64 statisticId = writeStatistic(componentFullPath, name, statistic, false);
+    for (const auto & attribute : attributes)
+        writeStatisticAttr(statisticId, attribute.first, attribute.second);
+    commitIfNeeded();
 }
 
 void SqliteScalarFileWriter::recordHistogram(const std::string& componentFullPath, const std::string& name, const Statistics& statistic, const Histogram& bins, const StringMap& attributes)
 {
     Assert(runId != -1); // ensure run data has been written out
-    sqlite3_int64 statisticId = writeStatistic(componentFullPath, name, statistic, true);
+    sqlite3_int64 statisticId = writeStatistic(componentFullPath.c_str(), name.c_str(), statistic, true);
     for (const auto & attribute : attributes)
         writeStatisticAttr(statisticId, attribute.first.c_str(), attribute.second.c_str());
+    writeBins(statisticId, bins);
+    commitIfNeeded();
+}
 
-    int n = bins.getNumBins();
-    writeBin(statisticId, -INFINITY, bins.getUnderflows());
-    for (int i = 0; i < n; i++)
-        writeBin(statisticId, bins.getBinEdge(i), bins.getBinValue(i));
-    writeBin(statisticId, bins.getBinEdge(n), bins.getOverflows());
+void SqliteScalarFileWriter::recordHistogram(const char *componentFullPath, const char *name, const Statistics& statistic, const Histogram& bins, const AttributeList& attributes)
+{
+    Assert(runId != -1); // ensure run data has been written out
+    sqlite3_int64 statisticId = writeStatistic(componentFullPath, name, statistic, true);
+    for (const auto & attribute : attributes)
+        writeStatisticAttr(statisticId, attribute.first, attribute.second);
+    writeBins(statisticId, bins);
+    commitIfNeeded();
 }
 
 void SqliteScalarFileWriter::writeStatisticAttr(sqlite_int64 statisticId, const char *name, const char *value)
@@ -313,27 +384,40 @@ void SqliteScalarFileWriter::writeBin(sqlite_int64 statisticId, double lowerEdge
     checkOK(sqlite3_clear_bindings(add_statistic_bin_stmt));
 }
 
+void SqliteScalarFileWriter::writeBins(sqlite_int64 statisticId, const Histogram& bins)
+{
+    int n = bins.getNumBins();
+    writeBin(statisticId, -INFINITY, bins.getUnderflows());
+    for (int i = 0; i < n; i++)
+        writeBin(statisticId, bins.getBinEdge(i), bins.getBinValue(i));
+    writeBin(statisticId, bins.getBinEdge(n), bins.getOverflows());
+}
+
 void SqliteScalarFileWriter::recordParameter(const std::string& componentFullPath, const std::string& name, const std::string& value, const StringMap& attributes)
 {
     Assert(runId != -1); // ensure run data has been written out
-    sqlite3_int64 parameterId = writeParameter(componentFullPath, name, value);
+    sqlite3_int64 parameterId = writeParameter(componentFullPath.c_str(), name.c_str(), value.c_str());
     for (const auto & attribute : attributes)
         writeParameterAttr(parameterId, attribute.first.c_str(), attribute.first.size(), attribute.second.c_str(), attribute.second.size());
+    commitIfNeeded();
+}
 
-    // commit every once in a while
-    if (++insertCount >= commitFreq) {
-        insertCount = 0;
-        commitAndBeginNew();
-    }
+void SqliteScalarFileWriter::recordParameter(const char *componentFullPath, const char *name, const char *value, const AttributeList& attributes)
+{
+    Assert(runId != -1); // ensure run data has been written out
+    sqlite3_int64 parameterId = writeParameter(componentFullPath, name, value);
+    for (const auto & attribute : attributes)
+        writeParameterAttr(parameterId, attribute.first, strlen(attribute.first), attribute.second, strlen(attribute.second));
+    commitIfNeeded();
 }
 
-sqlite_int64 SqliteScalarFileWriter::writeParameter(const std::string& componentFullPath, const std::string& name, const std::string& value)
+sqlite_int64 SqliteScalarFileWriter::writeParameter(const char *componentFullPath, const char *name, const char *value)
 {
     checkOK(sqlite3_reset(add_parameter_stmt));
     checkOK(sqlite3_bind_int64(add_parameter_stmt, 1, runId));
-    checkOK(sqlite3_bind_text(add_parameter_stmt, 2, componentFullPath.c_str(), componentFullPath.size(), SQLITE_STATIC));
-    checkOK(sqlite3_bind_text(add_parameter_stmt, 3, name.c_str(), name.length(), SQLITE_STATIC));
-    checkOK(sqlite3_bind_text(add_parameter_stmt, 4, value.c_str(), value.length(), SQLITE_STATIC));
+    checkOK(sqlite3_bind_text(add_parameter_stmt, 2, componentFullPath, -1, SQLITE_STATIC));
+    checkOK(sqlite3_bind_text(add_parameter_stmt, 3, name, -1, SQLITE_STATIC));
+    checkOK(sqlite3_bind_text(add_parameter_stmt, 4, value, -1, SQLITE_STATIC));
     checkDone(sqlite3_step(add_parameter_stmt));
     checkOK(sqlite3_clear_bindings(add_parameter_stmt));
     sqlite3_int64 parameterId = sqlite3_last_insert_rowid(db);
@@ -352,10 +436,20 @@ void SqliteScalarFileWriter::writeParameterAttr(sqlite_int64 parameterId, const
 
 void SqliteScalarFileWriter::commitAndBeginNew()
 {
+    insertPendingScalarAttrs();
     checkOK(sqlite3_exec(db, "COMMIT TRANSACTION;", nullptr, nullptr, nullptr));
     checkOK(sqlite3_exec(db, "BEGIN IMMEDIATE TRANSACTION;", nullptr, nullptr, nullptr));
 }
 
+void SqliteScalarFileWriter::commitIfNeeded()
+{
+    // commit every once in a while
+    if (++insertCount >= commitFreq) {
+        insertCount = 0;
+        commitAndBeginNew();
+    }
+}
+
 void SqliteScalarFileWriter::flush()
 {
     if (db)
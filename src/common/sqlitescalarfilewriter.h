@@ -35,6 +35,7 @@ class COMMON_API SqliteScalarFileWriter
   public:
     typedef std::map<std::string, std::string> StringMap;
     typedef std::vector<std::pair<std::string, std::string>> OrderedKeyValueList;
+    typedef std::vector<std::pair<const char *, const char *>> AttributeList; // (name, value) pairs; strings are not copied
 
   protected:
     std::string fname;   // output file name
@@ -43,6 +44,7 @@ class COMMON_API SqliteScalarFileWriter
     sqlite3_stmt *stmt;
     sqlite3_stmt *add_scalar_stmt;
     sqlite3_stmt *add_scalar_attr_stmt;
+    sqlite3_stmt *add_scalar_attr_multirow_stmt;
     sqlite3_stmt *add_statistic_stmt;
     sqlite3_stmt *add_statistic_attr_stmt;
     sqlite3_stmt *add_statistic_bin_stmt;
@@ -52,16 +54,28 @@ class COMMON_API SqliteScalarFileWriter
     int commitFreq=100000; // we COMMIT after every commitFreq INSERT statements
     int insertCount;
 
+    // scalar attributes are inserted in batches, using multi-row INSERT statements
+    struct PendingAttr {
+        sqlite_int64 scalarId;
+        size_t nameOffset, nameLength;   // in pendingAttrText
+        size_t valueOffset, valueLength; // in pendingAttrText
+    };
+    std::vector<PendingAttr> pendingScalarAttrs;
+    std::string pendingAttrText;
+
   protected:
     void prepareStatements();
     void cleanup();  // MUST NOT THROW
     void commitAndBeginNew();
-    sqlite_int64 writeScalar(const std::string& componentFullPath, const std::string& name, double value);
+    void commitIfNeeded();
+    sqlite_int64 writeScalar(const char *componentFullPath, const char *name, double value);
     void writeScalarAttr(sqlite_int64 scalarId, const char *name, size_t nameLength, const char *value, size_t valueLength);
-    sqlite_int64 writeStatistic(const std::string& componentFullPath, const std::string& name, const Statistics& statistic, bool isHistogram);
+    void insertPendingScalarAttrs();
+    sqlite_int64 writeStatistic(const char *componentFullPath, const char *name, const Statistics& statistic, bool isHistogram);
     void writeStatisticAttr(sqlite_int64 statisticId, const char *name, const char *value);
     void writeBin(sqlite_int64 statisticId, double lowerEdge, double binValue);
-    sqlite_int64 writeParameter(const std::string& componentFullPath, const std::string& name, const std::string& value);
+    void writeBins(sqlite_int64 statisticId, const Histogram& bins);
+    sqlite_int64 writeParameter(const char *componentFullPath, const char *name, const char *value);
     void writeParameterAttr(sqlite_int64 parameterId, const char *name, size_t nameLength, const char *value, size_t valueLength);
     void prepareStatement(sqlite3_stmt *&stmt, const char *sql);
     void finalizeStatement(sqlite3_stmt *&stmt);
@@ -86,6 +100,12 @@ class COMMON_API SqliteScalarFileWriter
     void recordStatistic(const std::string& componentFullPath, const std::string& name, const Statistics& statistic, const StringMap& attributes);
     void recordHistogram(const std::string& componentFullPath, const std::string& name, const Statistics& statistic, const Histogram& bins, const StringMap& attributes);
     void recordParameter(const std::string& componentFullPath, const std::string& name, const std::string& value, const StringMap& attributes);
+
+    // variants that do not allocate memory
+    void recordScalar(const char *componentFullPath, const char *name, double value, const AttributeList& attributes);
+    void recordStatistic(const char *componentFullPath, const char *name, const Statistics& statistic, const AttributeList& attributes);
+    void recordHistogram(const char *componentFullPath, const char *name, const Statistics& statistic, const Histogram& bins, const AttributeList& attributes);
+    void recordParameter(const char *componentFullPath, const char *name, const char *value, const AttributeList& attributes);
     void flush();
 };
 
@@ -24,6 +24,7 @@
 #include "sqlite3.h"
 #include "commondefs.h"
 #include "statistics.h"
+#include "binaryvectorcodec.h"
 
 namespace omnetpp {
 namespace common {
@@ -31,6 +32,13 @@ namespace common {
 
 /**
  * Class for writing SQLite-based output vector files.
+ *
+ * Vector data are normally stored one sample per row in the vectorData
+ * table, using multi-row INSERT statements, with the transaction committed
+ * after every few hundred thousand rows. In block storage mode, each
+ * buffered block of samples goes into a single row of the vectorBlock table
+ * as a BLOB encoded with BinaryVectorCodec instead, which is much faster to
+ * write and also much more compact.
  */
 class COMMON_API SqliteVectorFileWriter
 {
@@ -71,12 +79,23 @@ class COMMON_API SqliteVectorFileWriter
     sqlite3_stmt *add_vector_stmt;
     sqlite3_stmt *add_vector_attr_stmt;
     sqlite3_stmt *add_vector_data_stmt;
+    sqlite3_stmt *add_vector_data_multirow_stmt; // inserts MULTIROW_INSERT_SIZE rows at once
+    sqlite3_stmt *add_vector_block_stmt;
     sqlite3_stmt *update_vector_stmt;
 
     int bufferedSamplesLimit;  // limit of total buffered samples; 0=no limit
+    bool walMode;              // use write-ahead logging while the file is open
+    bool blockStorage;         // store data in the vectorBlock table
 
     Vectors vectors;           // registered output vectors
     int bufferedSamples;       // currently total buffered samples
+    int simtimeScaleExp;       // of the current run
+    bool inTransaction;        // whether we are inside a BEGIN/COMMIT pair
+    long uncommittedSamples;   // number of samples written since the last COMMIT
+
+    BinaryVectorCodec codec;   // for block storage mode
+    std::vector<int64_t> eventNumberBuffer, simtimeBuffer; // for block storage mode
+    std::vector<double> valueBuffer;
 
   protected:
     void prepareStatements();
@@ -86,6 +105,11 @@ class COMMON_API SqliteVectorFileWriter
     virtual void writeBlock(VectorData *vp);
     virtual void finalizeVector(VectorData *vp);
     void executeSql(const char *sql);
+    void beginTransaction();
+    void commitTransaction();
+    void commitIfNeeded();
+    void insertRows(VectorData *vp);
+    void insertBlock(VectorData *vp);
 
     void prepareStatement(sqlite3_stmt *&stmt, const char *sql);
     void finalizeStatement(sqlite3_stmt *&stmt);
@@ -97,6 +121,21 @@ class COMMON_API SqliteVectorFileWriter
     SqliteVectorFileWriter();
     virtual ~SqliteVectorFileWriter();
 
+    /**
+     * Enables write-ahead logging (SQLite's WAL journal mode) while the file
+     * is open; the file is switched back to the default journal mode on close().
+     * Must be called before open().
+     */
+    void setWalMode(bool enabled) {walMode = enabled;}
+    bool getWalMode() const {return walMode;}
+
+    /**
+     * Enables storing vector data as compressed blocks in the vectorBlock
+     * table, instead of one sample per row in the vectorData table.
+     */
+    void setBlockStorage(bool enabled) {blockStorage = enabled;}
+    bool getBlockStorage() const {return blockStorage;}
+
     void open(const char *filename); // append if file exists
     void close();
     bool isOpen() const {return db != nullptr;} // IMPORTANT: db will be closed when an error occurs
@@ -0,0 +1,65 @@
+//==========================================================================
+//  TEXTBUFFER.CC - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cstdlib>
+#include <new>
+#include "stringutil.h"
+#include "textbuffer.h"
+
+namespace omnetpp {
+namespace common {
+
+TextBuffer::TextBuffer(size_t initialCapacity)
+{
+    len = 0;
+    capacity = initialCapacity > 0 ? initialCapacity : 64;
+    buf = (char *)malloc(capacity);
+    if (!buf)
+        throw std::bad_alloc();
+}
+
+TextBuffer::~TextBuffer()
+{
+    free(buf);
+}
+
+void TextBuffer::grow(size_t minCapacity)
+{
+    size_t newCapacity = capacity * 2;
+    if (newCapacity < minCapacity)
+        newCapacity = minCapacity;
+    char *newBuf = (char *)realloc(buf, newCapacity);
+    if (!newBuf)
+        throw std::bad_alloc();
+    buf = newBuf;
+    capacity = newCapacity;
+}
+
+void TextBuffer::appendSimtime(int64_t t, int scaleExp)
+{
+    char tmp[64], *endp;
+    char *s = opp_ttoa(tmp, t, scaleExp, endp);
+    append(s, endp - s);
+}
+
+bool TextBuffer::writeTo(FILE *f)
+{
+    bool ok = len == 0 || fwrite(buf, 1, len, f) == len;
+    len = 0;
+    return ok;
+}
+
+}  // namespace common
+}  // namespace omnetpp
+
@@ -0,0 +1,79 @@
+//==========================================================================
+//  TEXTBUFFER.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_COMMON_TEXTBUFFER_H
+#define __OMNETPP_COMMON_TEXTBUFFER_H
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "commondefs.h"
+#include "numberformat.h"
+
+namespace omnetpp {
+namespace common {
+
+/**
+ * A growable character buffer for assembling lines of text output, with fast
+ * number formatting (see numberformat.h). The buffer is meant to be reused,
+ * so that no memory allocation takes place in the steady state. The contents
+ * are NOT null-terminated.
+ */
+class COMMON_API TextBuffer
+{
+  protected:
+    char *buf;
+    size_t len;
+    size_t capacity;
+
+  protected:
+    void grow(size_t minCapacity);
+    char *reserve(size_t n) {if (len + n > capacity) grow(len + n); return buf + len;}
+
+  public:
+    explicit TextBuffer(size_t initialCapacity=4096);
+    ~TextBuffer();
+    TextBuffer(const TextBuffer&) = delete;
+    TextBuffer& operator=(const TextBuffer&) = delete;
+
+    const char *getData() const {return buf;}
+    size_t getLength() const {return len;}
+    bool isEmpty() const {return len == 0;}
+    void clear() {len = 0;}
+
+    void append(char c) {*reserve(1) = c; len++;}
+    void append(const char *s, size_t n) {memcpy(reserve(n), s, n); len += n;}
+    void append(const char *s) {append(s, strlen(s));}
+    void append(const std::string& s) {append(s.data(), s.size());}
+
+    /** Appends the number like printf's "%" PRId64. */
+    void appendInt(int64_t d) {len = opp_formati64(reserve(21), d) - buf;}
+
+    /** Appends the number like printf's "%.*g". */
+    void appendDouble(double d, int prec) {len = opp_formatdouble(reserve(opp_formatdouble_bufsize(prec)), d, prec) - buf;}
+
+    /** Appends a fixed-point simulation time value, see opp_ttoa(). */
+    void appendSimtime(int64_t t, int scaleExp);
+
+    /**
+     * Writes the contents to the given file, and clears the buffer.
+     * Returns false on error.
+     */
+    bool writeTo(FILE *f);
+};
+
+}  // namespace common
+}  // namespace omnetpp
+
+#endif
@@ -107,6 +107,7 @@ struct ENVIR_API EnvirOptions
 
     bool debugStatisticsRecording;
     bool checkSignals;
+    bool messagePooling;
     bool fnameAppendHost;
 
     bool useStderr;
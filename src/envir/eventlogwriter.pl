@@ -50,41 +50,20 @@ while (<FILE>)
       $fieldType = $2;
       $fieldName = $3;
       $fieldDefault  = $5;
-      $fieldPrintfValue = $fieldName;
 
+      # statement that appends the field value to the line buffer
       if ($fieldType eq "string")
       {
-         $fieldPrintfType = "%s";
-         $fieldPrintfValue = "QUOTE($fieldPrintfValue)";
+         $fieldAppend = "buffer.append(QUOTE($fieldName))";
       }
-      elsif ($fieldType eq "bool")
+      elsif ($fieldType eq "bool" || $fieldType eq "int" || $fieldType eq "short" || $fieldType eq "long" ||
+             $fieldType eq "int64_t" || $fieldType eq "eventnumber_t")
       {
-         $fieldPrintfType = "%d";
-      }
-      elsif ($fieldType eq "int")
-      {
-         $fieldPrintfType = "%d";
-      }
-      elsif ($fieldType eq "short")
-      {
-         $fieldPrintfType = "%d";
-      }
-      elsif ($fieldType eq "long")
-      {
-         $fieldPrintfType = "%ld";
-      }
-      elsif ($fieldType eq "int64_t")
-      {
-         $fieldPrintfType = '%" PRId64 "';
-      }
-      elsif ($fieldType eq "eventnumber_t")
-      {
-         $fieldPrintfType = '%" PRId64 "';
+         $fieldAppend = "buffer.appendInt($fieldName)";
       }
       elsif ($fieldType eq "simtime_t")
       {
-         $fieldPrintfType = "%s";
-         $fieldPrintfValue = "SIMTIME_STR($fieldPrintfValue)";
+         $fieldAppend = "appendSimtime($fieldName)";
       }
       else {
          die "unrecognized type '$fieldType'";
@@ -100,8 +79,7 @@ while (<FILE>)
          CODE => $fieldCode,
          TYPE => $fieldType,
          CTYPE => $fieldCType,
-         PRINTFTYPE => $fieldPrintfType,
-         PRINTFVALUE => $fieldPrintfValue,
+         APPEND => $fieldAppend,
          NAME => $fieldName,
          DEFAULTVALUE => $fieldDefault,
       };
@@ -144,6 +122,7 @@ print H
 
 #include <cstdio>
 #include \"envirdefs.h\"
+#include \"common/textbuffer.h\"
 #include \"omnetpp/simtime_t.h\"
 
 namespace omnetpp {
@@ -151,6 +130,10 @@ namespace envir {
 
 class EventLogWriter
 {
+  protected:
+    static omnetpp::common::TextBuffer buffer;  // for assembling lines; the eventlog is only written from one thread
+    static void appendSimtime(simtime_t t);
+
   public:
     static void recordLogLine(FILE *f, const char *prefix, const char *line, int lineLength);
 ";
@@ -191,17 +174,28 @@ print CC "
 #ifdef CHECK
 #undef CHECK
 #endif
-#define CHECK(fprintf)    if (fprintf<0) throw cRuntimeError(\"Cannot write event log file, disk full?\");
+#define CHECK(writeTo)    if (!(writeTo)) throw cRuntimeError(\"Cannot write event log file, disk full?\");
 
 namespace omnetpp {
 namespace envir {
 
 using namespace omnetpp::common;
 
+TextBuffer EventLogWriter::buffer;
+
+void EventLogWriter::appendSimtime(simtime_t t)
+{
+    char buf[64], *endp;
+    char *s = SimTime::ttoa(buf, t.raw(), SimTime::getScaleExp(), endp);
+    buffer.append(s, endp - s);
+}
+
 void EventLogWriter::recordLogLine(FILE *f, const char *prefix, const char *line, int lineLength)
 {
-    CHECK(fprintf(f, \"- %s\", prefix));
-    CHECK(fwrite(line, 1, lineLength, f));
+    buffer.append(\"- \");
+    buffer.append(prefix);
+    buffer.append(line, lineLength);
+    CHECK(buffer.writeTo(f));
 }
 
 ";
@@ -227,9 +221,8 @@ sub makeMethodImpl ()
    my $txt = "void EventLogWriter::" . makeMethodDecl($class,$wantOptFields) . "\n{\n";
    $txt .= "    ASSERT(f!=nullptr);\n";
 
-   # class code goes into initial fprintf
-   my $fmt .= "$class->{CODE}";
-   my $args = "";
+   # the line is assembled in the buffer, starting with the class code
+   $txt .= "    buffer.append(\"$class->{CODE}\");\n";
 
    foreach $field ( getEffectiveFields($class) )
    {
@@ -238,22 +231,21 @@ sub makeMethodImpl ()
 
       if ($field->{DEFAULTVALUE} eq "")
       {
-         # mandatory field: append to current fprintf statement
-         $fmt .= " $field->{CODE} $field->{PRINTFTYPE}";
-         $args .= ", $field->{PRINTFVALUE}";
+         # mandatory field
+         $txt .= "    buffer.append(\" $field->{CODE} \");\n";
+         $txt .= "    $field->{APPEND};\n";
       }
       else
       {
-         # optional field: flush current fprintf statement, and generate a conditional fprintf
-         $txt .= "    CHECK(fprintf(f, \"$fmt\"$args));\n" if ($fmt ne "");
-         $fmt = "";
-         $args = "";
-         $txt .= "    if ($field->{NAME}!=$field->{DEFAULTVALUE})\n";
-         $txt .= "        CHECK(fprintf(f, \" $field->{CODE} $field->{PRINTFTYPE}\", $field->{PRINTFVALUE}));\n";
+         # optional field: only written if it differs from the default value
+         $txt .= "    if ($field->{NAME}!=$field->{DEFAULTVALUE}) {\n";
+         $txt .= "        buffer.append(\" $field->{CODE} \");\n";
+         $txt .= "        $field->{APPEND};\n";
+         $txt .= "    }\n";
       }
    }
-   # flush final fprintf statement (or at least a newline if $fmt=="")
-   $txt .= "    CHECK(fprintf(f, \"$fmt\\n\"$args));\n";
+   $txt .= "    buffer.append('\\n');\n";
+   $txt .= "    CHECK(buffer.writeTo(f));\n";
 
    $txt .= "}\n\n";
    $txt;
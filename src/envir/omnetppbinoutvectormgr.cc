@@ -0,0 +1,38 @@
+//==========================================================================
+//  OMNETPPBINOUTVECTORMGR.CC - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include "common/stringutil.h"
+#include "omnetpp/cconfigoption.h"
+#include "omnetpp/cconfiguration.h"
+#include "omnetpp/csimulation.h"
+#include "omnetpp/globals.h"
+#include "omnetppbinoutvectormgr.h"
+
+namespace omnetpp {
+namespace envir {
+
+Register_Class(OmnetppBinaryOutputVectorManager);
+
+Register_PerRunConfigOption(CFGID_OUTPUT_VECTOR_COMPRESSION, "output-vector-compression", CFG_BOOL, "true", "Whether to compress vector data blocks when recording output vectors in binary form, i.e. when `outputvectormanager-class` is `omnetpp::envir::OmnetppBinaryOutputVectorManager`. Compression is lossless and fast, and typically shrinks vector files considerably.");
+
+void OmnetppBinaryOutputVectorManager::startRun()
+{
+    OmnetppOutputVectorManager::startRun();
+    writer.setCompression(getEnvir()->getConfig()->getAsBool(CFGID_OUTPUT_VECTOR_COMPRESSION));
+}
+
+}  // namespace envir
+}  // namespace omnetpp
+
@@ -0,0 +1,50 @@
+//==========================================================================
+//  OMNETPPBINOUTVECTORMGR.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_ENVIR_OMNETPPBINOUTVECTORMGR_H
+#define __OMNETPP_ENVIR_OMNETPPBINOUTVECTORMGR_H
+
+#include "omnetppoutvectormgr.h"
+
+namespace omnetpp {
+namespace envir {
+
+/**
+ * A cIOutputVectorManager that writes output vector files where vector data
+ * are stored in binary, columnar blocks that are optionally compressed.
+ * Everything else (run data, vector declarations, the index file) is the same
+ * as with OmnetppOutputVectorManager. Writing is considerably faster than
+ * with the text format, and values are stored without loss of precision.
+ *
+ * @ingroup Envir
+ */
+class OmnetppBinaryOutputVectorManager : public OmnetppOutputVectorManager
+{
+  public:
+    /**
+     * Constructor.
+     */
+    OmnetppBinaryOutputVectorManager() {writer.setBinary(true);}
+
+    /**
+     * Reads the configuration in addition to what the base class does.
+     */
+    virtual void startRun() override;
+};
+
+} // namespace envir
+}  // namespace omnetpp
+
+#endif
@@ -31,6 +31,7 @@
 #include "omnetpp/cstatistic.h"
 #include "omnetpp/cabstracthistogram.h"
 #include "omnetpp/ccomponenttype.h"
+#include "omnetpp/checkandcast.h"
 #include "envirbase.h"
 #include "omnetppoutscalarmgr.h"
 
@@ -81,6 +82,7 @@ void OmnetppOutputScalarManager::endRun()
         writer.endRecordingForRun();
         closeFile();
     }
+    componentPaths.clear();  // component IDs are only unique within a run
 }
 
 void OmnetppOutputScalarManager::openFileForRun()
@@ -119,12 +121,14 @@ bool OmnetppOutputScalarManager::recordScalar(cComponent *component, const char
     if (!name || !name[0])
         name = "(unnamed)";
 
-    std::string componentFullPath = component->getFullPath();
-    bool enabled = getEnvir()->getConfig()->getAsBool((componentFullPath + "." + name).c_str(), CFGID_SCALAR_RECORDING);
+    const char *componentFullPath = componentPaths.getFullPath(component);
+    objectFullPath.assign(componentFullPath).append(".").append(name);
+    bool enabled = getEnvir()->getConfig()->getAsBool(objectFullPath.c_str(), CFGID_SCALAR_RECORDING);
     if (!enabled)
         return false;
 
-    writer.recordScalar(componentFullPath, name, value, ResultFileUtils::convertMap(attributes));
+    ResultFileUtils::convertMap(attributes, attributeList);
+    writer.recordScalar(componentFullPath, name, value, attributeList);
     return true;
 }
 
@@ -146,9 +150,9 @@ bool OmnetppOutputScalarManager::recordStatistic(cComponent *component, const ch
     if (!name || !name[0])
         name = "(unnamed)";
 
-    std::string componentFullPath = component->getFullPath();
+    const char *componentFullPath = componentPaths.getFullPath(component);
     // check that recording this statistic is not disabled as a whole
-    std::string objectFullPath = componentFullPath + "." + name;
+    objectFullPath.assign(componentFullPath).append(".").append(name);
     bool enabled = getEnvir()->getConfig()->getAsBool(objectFullPath.c_str(), CFGID_SCALAR_RECORDING);
     if (!enabled)
         return false;
@@ -159,6 +163,7 @@ bool OmnetppOutputScalarManager::recordStatistic(cComponent *component, const ch
     else
         stats = Statistics::makeWeighted(statistic->getCount(), statistic->getMin(), statistic->getMax(), statistic->getSumWeights(), statistic->getWeightedSum(), statistic->getSqrSumWeights(), statistic->getWeightedSqrSum());
 
+    ResultFileUtils::convertMap(attributes, attributeList);
     bool savedAsHistogram = false;
     if (cAbstractHistogram *histogram = dynamic_cast<cAbstractHistogram *>(statistic)) {
         // check that recording the histogram is enabled
@@ -167,20 +172,19 @@ bool OmnetppOutputScalarManager::recordStatistic(cComponent *component, const ch
             if (!histogram->binsAlreadySetUp())
                 histogram->setUpBins();
 
-            Histogram bins;
             int n = histogram->getNumBins();
             if (n > 0) {
                 bins.setBins(histogram->getBinEdges(), histogram->getBinValues());
                 bins.setUnderflows(histogram->getUnderflowSumWeights());
                 bins.setOverflows(histogram->getOverflowSumWeights());
-                writer.recordHistogram(componentFullPath, name, stats, bins, ResultFileUtils::convertMap(attributes));
+                writer.recordHistogram(componentFullPath, name, stats, bins, attributeList);
                 savedAsHistogram = true;
             }
         }
     }
 
     if (!savedAsHistogram)
-        writer.recordStatistic(componentFullPath, name, stats, ResultFileUtils::convertMap(attributes));
+        writer.recordStatistic(componentFullPath, name, stats, attributeList);
 
     return true;
 }
@@ -198,9 +202,10 @@ bool OmnetppOutputScalarManager::recordParameter(cPar *par)
     if (isBad())
         return false;
 
-    std::string componentFullPath = par->getOwner()->getFullPath();
+    const char *componentFullPath = componentPaths.getFullPath(check_and_cast<cComponent *>(par->getOwner()));
     const char *name = par->getName();
-    bool enabled = getEnvir()->getConfig()->getAsBool((componentFullPath+"."+name).c_str(), CFGID_PARAM_RECORDING);
+    objectFullPath.assign(componentFullPath).append(".").append(name);
+    bool enabled = getEnvir()->getConfig()->getAsBool(objectFullPath.c_str(), CFGID_PARAM_RECORDING);
     if (!enabled)
         return false;
 
@@ -221,14 +226,15 @@ bool OmnetppOutputScalarManager::recordComponentType(cComponent *component)
     if (isBad())
         return false;
 
-    std::string componentFullPath = component->getFullPath();
+    const char *componentFullPath = componentPaths.getFullPath(component);
     const char *name = "typename";
-    bool enabled = getEnvir()->getConfig()->getAsBool((componentFullPath+"."+name).c_str(), CFGID_PARAM_RECORDING);
+    objectFullPath.assign(componentFullPath).append(".").append(name);
+    bool enabled = getEnvir()->getConfig()->getAsBool(objectFullPath.c_str(), CFGID_PARAM_RECORDING);
     if (!enabled)
         return false;
 
     const char *nedType = component->getComponentType()->getFullName();
-    writer.recordParameter(componentFullPath, name, opp_quotestr(nedType), StringMap());
+    writer.recordParameter(componentFullPath, name, opp_quotestr(nedType).c_str(), AttributeList());
     return true;
 }
 
@@ -42,6 +42,12 @@ class ENVIR_API OmnetppOutputScalarManager : public cIOutputScalarManager
     std::string fname;
     OmnetppScalarFileWriter writer;
 
+    // reused in the record methods, to avoid memory allocations
+    ComponentPathCache componentPaths;
+    std::string objectFullPath;
+    AttributeList attributeList;
+    common::Histogram bins;
+
   protected:
     virtual void openFileForRun();
     virtual void closeFile();
@@ -39,6 +39,10 @@ typedef std::map<std::string, std::string> StringMap;
 
 Register_Class(OmnetppOutputVectorManager);
 
+Register_PerRunConfigOption(CFGID_OUTPUT_VECTOR_WRITER_THREAD, "output-vector-writer-thread", CFG_BOOL, "false", "Whether to write output vector files from a background thread. When enabled, filled vector buffers are handed over to the thread, and formatting, compression and file writes happen there instead of in the simulation thread. Effective with `OmnetppOutputVectorManager` and `OmnetppBinaryOutputVectorManager`. See also `output-vector-writer-thread-memory-limit`.");
+Register_PerRunConfigOptionU(CFGID_OUTPUT_VECTOR_WRITER_THREAD_MEMORY_LIMIT, "output-vector-writer-thread-memory-limit", "B", "64MiB", "Total size of vector data that may be waiting for the background writer thread (see `output-vector-writer-thread`). When reached, recording blocks until the thread catches up. This memory is in addition to `output-vectors-memory-limit`.");
+Register_PerRunConfigOption(CFGID_OUTPUT_VECTORS_ADAPTIVE_BUFFERS, "output-vectors-adaptive-buffers", CFG_BOOL, "false", "Whether to adjust per-vector buffer sizes to the observed recording rates. When enabled, frequently recorded vectors may use a share of `output-vectors-memory-limit` proportional to their recording rate (but at most half of it), resulting in fewer, larger blocks in the output vector file; `**.vector-buffer` acts as the minimum buffer size. Effective with `OmnetppOutputVectorManager` and `OmnetppBinaryOutputVectorManager`.");
+
 // global options
 extern omnetpp::cConfigOption *CFGID_OUTPUT_VECTOR_FILE_APPEND;
 extern omnetpp::cConfigOption *CFGID_OUTPUT_VECTOR_FILE;
@@ -71,6 +75,11 @@ void OmnetppOutputVectorManager::startRun()
 
     size_t memoryLimit = (size_t) getEnvir()->getConfig()->getAsDouble(CFGID_OUTPUTVECTOR_MEMORY_LIMIT);
     writer.setOverallMemoryLimit(memoryLimit);
+    writer.setAdaptiveBufferSizes(getEnvir()->getConfig()->getAsBool(CFGID_OUTPUT_VECTORS_ADAPTIVE_BUFFERS));
+
+    bool writerThread = getEnvir()->getConfig()->getAsBool(CFGID_OUTPUT_VECTOR_WRITER_THREAD);
+    size_t writerThreadMemoryLimit = (size_t) getEnvir()->getConfig()->getAsDouble(CFGID_OUTPUT_VECTOR_WRITER_THREAD_MEMORY_LIMIT);
+    writer.setBackgroundWriting(writerThread, writerThreadMemoryLimit);
 }
 
 void OmnetppOutputVectorManager::endRun()
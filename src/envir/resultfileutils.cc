@@ -19,11 +19,16 @@
 
 #include "omnetpp/simkerneldefs.h"
 
+#include <algorithm>
 #include <cstring>
 #include "common/stringutil.h"
 #include "common/stringtokenizer.h"
 #include "omnetpp/cconfigoption.h"
 #include "omnetpp/csimulation.h"
+#include "omnetpp/ccomponent.h"
+#include "omnetpp/cmodule.h"
+#include "omnetpp/cchannel.h"
+#include "omnetpp/cgate.h"
 #include "omnetpp/cproperties.h"
 #include "omnetpp/cproperty.h"
 #include "omnetpp/opp_string.h"
@@ -142,6 +147,103 @@ StringMap ResultFileUtils::convertMap(const opp_string_map *m)
 }
 
 
+void ResultFileUtils::convertMap(const opp_string_map *m, AttributeList& result)
+{
+    result.clear();
+    if (m)
+        for (auto& pair : *m)
+            result.push_back(std::make_pair(pair.first.c_str(), pair.second.c_str()));
+}
+
+// the module whose path the component's path is built on: the parent module,
+// or for channels, the owner of the source gate (whose name is also returned)
+static cModule *getPathParent(cComponent *component, const char *& gateName)
+{
+    gateName = nullptr;
+    if (component->isModule())
+        return component->getParentModule();
+    cGate *srcGate = static_cast<cChannel *>(component)->getSourceGate();
+    if (!srcGate)
+        return nullptr;
+    gateName = srcGate->getFullName();
+    return srcGate->getOwnerModule();
+}
+
+const char *ComponentPathCache::getFullPath(cComponent *component)
+{
+    // make room for the component and its ancestors in advance, so that
+    // getPath() does not cause reallocation while it holds references
+    int maxId = 0;
+    const char *gateName;
+    for (cComponent *c = component; c; c = getPathParent(c, gateName))
+        maxId = std::max(maxId, c->getId());
+    if (maxId >= (int)entries.size())
+        entries.resize(std::max(maxId+1, 2*(int)entries.size()));
+    return getPath(component);
+}
+
+// whether s is "[.<gateName>].<name>"
+static bool isPathSuffix(const char *s, const char *gateName, const char *name)
+{
+    if (gateName) {
+        size_t len = strlen(gateName);
+        if (*s != '.' || strncmp(s+1, gateName, len) != 0)
+            return false;
+        s += len + 1;
+    }
+    return *s == '.' && strcmp(s+1, name) == 0;
+}
+
+const char *ComponentPathCache::getPath(cComponent *component)
+{
+    // The path is the validated path of the parent plus the name. As paths are
+    // pooled, the parent's path is unchanged iff it is the same pointer (the
+    // entry holds a reference to it, so the pointer cannot be reused for
+    // another string). This keeps the cached path correct even if the
+    // component or any of its ancestors have been renamed or moved with
+    // changeParentTo().
+    Entry& entry = entries[component->getId()];
+    const char *gateName;
+    cModule *parent = getPathParent(component, gateName);
+    if (!parent) {
+        const char *fullName = component->getFullName();
+        if (!entry.path || strcmp(entry.path, fullName) != 0)
+            setPath(entry, fullName, nullptr);
+        return entry.path;
+    }
+
+    const char *parentPath = getPath(parent);
+    if (entry.path && entry.parentPath == parentPath && isPathSuffix(entry.path + strlen(parentPath), gateName, component->getFullName()))
+        return entry.path;
+
+    tmp.assign(parentPath);
+    if (gateName)
+        tmp.append(".").append(gateName);
+    tmp.append(".").append(component->getFullName());
+    setPath(entry, tmp.c_str(), parentPath);
+    return entry.path;
+}
+
+void ComponentPathCache::setPath(Entry& entry, const char *path, const char *parentPath)
+{
+    // get the new strings before releasing the old ones, as they may be the same
+    const char *oldPath = entry.path;
+    const char *oldParentPath = entry.parentPath;
+    entry.path = pool.get(path);
+    entry.parentPath = pool.get(parentPath);
+    pool.release(oldPath);
+    pool.release(oldParentPath);
+}
+
+void ComponentPathCache::clear()
+{
+    for (Entry& entry : entries) {
+        pool.release(entry.path);
+        pool.release(entry.parentPath);
+    }
+    entries.clear();
+}
+
 }  // namespace envir
 }  // namespace omnetpp
 
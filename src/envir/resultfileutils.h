@@ -22,10 +22,12 @@
 #include <string>
 #include <map>
 #include <vector>
+#include "omnetpp/cstringpool.h"
 #include "envirdefs.h"
 
 namespace omnetpp {
 
+class cComponent;
 class cProperties;
 class opp_string_map;
 
@@ -33,6 +35,7 @@ namespace envir {
 
 typedef std::map<std::string, std::string> StringMap;
 typedef std::vector<std::pair<std::string, std::string>> OrderedKeyValueList;
+typedef std::vector<std::pair<const char *, const char *>> AttributeList;
 
 class ResultFileUtils {
   public:
@@ -42,6 +45,36 @@ class ResultFileUtils {
     static OrderedKeyValueList getSelectedConfigEntries();
     static StringMap convertProperties(const cProperties *properties);
     static StringMap convertMap(const opp_string_map *m);
+    static void convertMap(const opp_string_map *m, AttributeList& result); // result points into m
+};
+
+/**
+ * Caches the full paths of components by component ID, so that recording
+ * many results of the same component does not build the path string each
+ * time. (Component IDs are not reused within a simulation run.) The paths
+ * are interned in a string pool, and each cached path remembers the pooled
+ * path of the parent it was built on. Cached paths are validated on each
+ * call by comparing parent path pointers and the last path segment, so
+ * renaming or moving components is handled without building temporary
+ * strings. The returned pointer is only valid until the next call.
+ */
+class ComponentPathCache {
+  private:
+    struct Entry {
+        const char *path = nullptr;       // pooled
+        const char *parentPath = nullptr; // pooled; path of the parent when the path was built
+    };
+    cStringPool pool;
+    std::vector<Entry> entries;
+    std::string tmp;
+  private:
+    const char *getPath(cComponent *component);
+    void setPath(Entry& entry, const char *path, const char *parentPath);
+  public:
+    ComponentPathCache() : pool("ComponentPathCache") {}
+    ~ComponentPathCache() {clear();}
+    const char *getFullPath(cComponent *component);
+    void clear();
 };
 
 } // namespace envir
@@ -100,6 +100,26 @@ SectionBasedConfiguration::MatchableEntry::~MatchableEntry()
     delete fullPathPattern;
 }
 
+void SectionBasedConfiguration::SuffixBin::add(const MatchableEntry& entry)
+{
+    int index = entries.size();
+    entries.push_back(entry);
+    if (entry.fullPathPattern)
+        fullPathEntries.push_back(index);
+    else {
+        std::string ownerName, binName;
+        splitKey(entry.key.c_str(), ownerName, binName);
+        ownerPatternTrie.add(ownerName.c_str(), index);
+    }
+}
+
+void SectionBasedConfiguration::SuffixBin::clear()
+{
+    entries.clear();
+    ownerPatternTrie.clear();
+    fullPathEntries.clear();
+}
+
 //----
 
 SectionBasedConfiguration::SectionBasedConfiguration()
@@ -163,7 +183,7 @@ void SectionBasedConfiguration::clear()
     entries.clear();
     config.clear();
     suffixBins.clear();
-    wildcardSuffixBin.entries.clear();
+    wildcardSuffixBin.clear();
     variables.clear();
 }
 
@@ -924,9 +944,9 @@ void SectionBasedConfiguration::addEntry(const Entry& entry)
                 // initialize bin with matching wildcard keys seen so far
                 for (auto & wildcardEntry : wildcardSuffixBin.entries)
                     if (wildcardEntry.suffixPattern->matches(suffix.c_str()))
-                        bin.entries.push_back(wildcardEntry);
+                        bin.add(wildcardEntry);
             }
-            suffixBins[suffix].entries.push_back(entry2);
+            suffixBins[suffix].add(entry2);
         }
         else {
             // suffix contains wildcards: we need to add it to all existing suffix bins it matches
@@ -934,10 +954,10 @@ void SectionBasedConfiguration::addEntry(const Entry& entry)
             // config entry names cannot be wildcarded, ie. "foo.bar.cmdenv-*" is illegal),
             // but causes no harm, because getPerObjectConfigEntry() won't look into the
             // wildcard bin
-            wildcardSuffixBin.entries.push_back(entry2);
+            wildcardSuffixBin.add(entry2);
             for (auto & suffixBin : suffixBins)
                 if (entry2.suffixPattern->matches(suffixBin.first.c_str()))
-                    (suffixBin.second).entries.push_back(entry2);
+                    (suffixBin.second).add(entry2);
         }
     }
 }
@@ -1256,12 +1276,10 @@ const cConfiguration::KeyValue& SectionBasedConfiguration::getParameterEntry(con
     const SuffixBin *bin = it == suffixBins.end() ? &wildcardSuffixBin : &it->second;
 
     // find first match in the bin
-    for (const auto & entry : bin->entries) {
-        if (entryMatches(entry, moduleFullPath, paramName))
-            if (hasDefaultValue || entry.value != "default")
-                return entry;
-    }
-    return nullEntry;  // not found
+    const MatchableEntry *entry = findFirstMatch(*bin, moduleFullPath, paramName, hasDefaultValue);
+    if (!entry)
+        return nullEntry;  // not found
+    return *entry;
 }
 
 bool SectionBasedConfiguration::entryMatches(const MatchableEntry& entry, const char *moduleFullPath, const char *paramName)
@@ -1277,6 +1295,27 @@ bool SectionBasedConfiguration::entryMatches(const MatchableEntry& entry, const
     }
 }
 
+const SectionBasedConfiguration::MatchableEntry *SectionBasedConfiguration::findFirstMatch(const SuffixBin& bin, const char *ownerFullPath, const char *suffix, bool acceptDefault)
+{
+    // equivalent to trying entryMatches() on the entries in order, and returning the first match
+    auto accept = [&bin, suffix, acceptDefault](int index) {
+        const MatchableEntry& entry = bin.entries[index];
+        return (entry.suffixPattern == nullptr || entry.suffixPattern->matches(suffix)) && (acceptDefault || entry.value != "default");
+    };
+    int index = bin.ownerPatternTrie.findFirstMatch(ownerFullPath, accept);
+
+    for (int i : bin.fullPathEntries) {
+        if (index != -1 && i > index)
+            break;
+        const MatchableEntry& entry = bin.entries[i];
+        if (entryMatches(entry, ownerFullPath, suffix) && (acceptDefault || entry.value != "default")) {
+            index = i;
+            break;
+        }
+    }
+    return index == -1 ? nullptr : &bin.entries[index];
+}
+
 inline bool isSet(int value, int bits) {return (value & bits) == bits;}
 
 std::vector<const char *> SectionBasedConfiguration::getKeyValuePairs(int flags) const
@@ -1340,11 +1379,10 @@ const cConfiguration::KeyValue& SectionBasedConfiguration::getPerObjectConfigEnt
     const SuffixBin *suffixBin = &it->second;
 
     // find first match in the bin
-    for (const auto & entry : suffixBin->entries) {
-        if (entryMatches(entry, objectFullPath, keySuffix))
-            return entry;  // found value
-    }
-    return nullEntry;  // not found
+    const MatchableEntry *entry = findFirstMatch(*suffixBin, objectFullPath, keySuffix, true);
+    if (!entry)
+        return nullEntry;  // not found
+    return *entry;
 }
 
 static const char *partAfterLastDot(const char *s)
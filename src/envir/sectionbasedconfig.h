@@ -23,6 +23,7 @@
 #include <set>
 #include <string>
 #include "common/stringpool.h"
+#include "common/patterntrie.h"
 #include "omnetpp/cconfiguration.h"
 #include "omnetpp/cconfigreader.h"
 #include "envirdefs.h"
@@ -119,8 +120,18 @@ class ENVIR_API SectionBasedConfiguration : public cConfigurationEx
     //   **.tcp.eedVector.record-interval ==> goes into the "record-interval" bin; ownerPattern="**.tcp.eedVector"
     //   **.tcp.eedVector.record-*"       ==> goes into the wildcard bin; ownerPattern="**.tcp.eedVector", suffixPattern="record-*"
     //
+    // Within a bin, the owner patterns of all entries are compiled into a
+    // PatternTrie, so that a module path is matched against all of them in one
+    // pass instead of entry by entry. Entries that need full path matching
+    // (see splitKey()) are rare, and are still tried one by one.
+    //
     struct SuffixBin {
         std::vector<MatchableEntry> entries;
+        common::PatternTrie ownerPatternTrie; // owner patterns of entries[], with the index as id
+        std::vector<int> fullPathEntries; // indices of entries that have fullPathPattern
+
+        void add(const MatchableEntry& entry);
+        void clear();
     };
 
   private:
@@ -170,6 +181,7 @@ class ENVIR_API SectionBasedConfiguration : public cConfigurationEx
     void addEntry(const Entry& entry);
     static void splitKey(const char *key, std::string& outOwnerName, std::string& outBinName);
     static bool entryMatches(const MatchableEntry& entry, const char *moduleFullPath, const char *paramName);
+    static const MatchableEntry *findFirstMatch(const SuffixBin& bin, const char *ownerFullPath, const char *suffix, bool acceptDefault);
     std::vector<Scenario::IterationVariable> collectIterationVariables(const std::vector<int>& sectionChain, StringMap& outLocationToNameMap) const;
     static void parseVariable(const char *pos, std::string& outVarname, std::string& outValue, std::string& outParVar, const char *&outEndPos);
     std::string substituteVariables(const char *text, int sectionId, int entryId, const StringMap& variables, const StringMap& locationToVarName) const;
@@ -28,6 +28,7 @@
 #include "omnetpp/cstatistic.h"
 #include "omnetpp/cabstracthistogram.h"
 #include "omnetpp/ccomponenttype.h"
+#include "omnetpp/checkandcast.h"
 #include "envir/envirbase.h"
 #include "sqliteoutscalarmgr.h"
 
@@ -72,6 +73,7 @@ void SqliteOutputScalarManager::endRun()
     state = ENDED;
 
     closeFile();
+    componentPaths.clear();  // component IDs are only unique within a run
 }
 
 void SqliteOutputScalarManager::openFileForRun()
@@ -112,12 +114,14 @@ bool SqliteOutputScalarManager::recordScalar(cComponent *component, const char *
     if (!name || !name[0])
         name = "(unnamed)";
 
-    std::string componentFullPath = component->getFullPath();
-    bool enabled = getEnvir()->getConfig()->getAsBool((componentFullPath+"."+name).c_str(), CFGID_SCALAR_RECORDING);
+    const char *componentFullPath = componentPaths.getFullPath(component);
+    objectFullPath.assign(componentFullPath).append(".").append(name);
+    bool enabled = getEnvir()->getConfig()->getAsBool(objectFullPath.c_str(), CFGID_SCALAR_RECORDING);
     if (!enabled)
         return false;
 
-    writer.recordScalar(componentFullPath, name, value, ResultFileUtils::convertMap(attributes));
+    ResultFileUtils::convertMap(attributes, attributeList);
+    writer.recordScalar(componentFullPath, name, value, attributeList);
     return true;
 }
 
@@ -139,9 +143,9 @@ bool SqliteOutputScalarManager::recordStatistic(cComponent *component, const cha
     if (!name || !name[0])
         name = "(unnamed)";
 
-    std::string componentFullPath = component->getFullPath();
+    const char *componentFullPath = componentPaths.getFullPath(component);
     // check that recording this statistic is not disabled as a whole
-    std::string objectFullPath = componentFullPath + "." + name;
+    objectFullPath.assign(componentFullPath).append(".").append(name);
     bool enabled = getEnvir()->getConfig()->getAsBool(objectFullPath.c_str(), CFGID_SCALAR_RECORDING);
     if (!enabled)
         return false;
@@ -152,6 +156,7 @@ bool SqliteOutputScalarManager::recordStatistic(cComponent *component, const cha
     else
         stats = Statistics::makeWeighted(statistic->getCount(), statistic->getMin(), statistic->getMax(), statistic->getSumWeights(), statistic->getWeightedSum(), statistic->getSqrSumWeights(), statistic->getWeightedSqrSum());
 
+    ResultFileUtils::convertMap(attributes, attributeList);
     bool savedAsHistogram = false;
     if (cAbstractHistogram *histogram = dynamic_cast<cAbstractHistogram *>(statistic)) {
         // check that recording the histogram is enabled
@@ -160,20 +165,19 @@ bool SqliteOutputScalarManager::recordStatistic(cComponent *component, const cha
             if (!histogram->binsAlreadySetUp())
                 histogram->setUpBins();
 
-            Histogram bins;
             int n = histogram->getNumBins();
             if (n > 0) {
                 bins.setBins(histogram->getBinEdges(), histogram->getBinValues());
                 bins.setUnderflows(histogram->getUnderflowSumWeights());
                 bins.setOverflows(histogram->getOverflowSumWeights());
-                writer.recordHistogram(componentFullPath, name, stats, bins, ResultFileUtils::convertMap(attributes));
+                writer.recordHistogram(componentFullPath, name, stats, bins, attributeList);
                 savedAsHistogram = true;
             }
         }
     }
 
     if (!savedAsHistogram)
-        writer.recordStatistic(componentFullPath, name, stats, ResultFileUtils::convertMap(attributes));
+        writer.recordStatistic(componentFullPath, name, stats, attributeList);
     return true;
 }
 
@@ -190,9 +194,10 @@ bool SqliteOutputScalarManager::recordParameter(cPar *par)
     if (isBad())
         return false;
 
-    std::string componentFullPath = par->getOwner()->getFullPath();
+    const char *componentFullPath = componentPaths.getFullPath(check_and_cast<cComponent *>(par->getOwner()));
     const char *name = par->getName();
-    bool enabled = getEnvir()->getConfig()->getAsBool((componentFullPath+"."+name).c_str(), CFGID_PARAM_RECORDING);
+    objectFullPath.assign(componentFullPath).append(".").append(name);
+    bool enabled = getEnvir()->getConfig()->getAsBool(objectFullPath.c_str(), CFGID_PARAM_RECORDING);
     if (!enabled)
         return false;
 
@@ -213,14 +218,15 @@ bool SqliteOutputScalarManager::recordComponentType(cComponent *component)
     if (isBad())
         return false;
 
-    std::string componentFullPath = component->getFullPath();
+    const char *componentFullPath = componentPaths.getFullPath(component);
     const char *name = "typename";
-    bool enabled = getEnvir()->getConfig()->getAsBool((componentFullPath+"."+name).c_str(), CFGID_PARAM_RECORDING);
+    objectFullPath.assign(componentFullPath).append(".").append(name);
+    bool enabled = getEnvir()->getConfig()->getAsBool(objectFullPath.c_str(), CFGID_PARAM_RECORDING);
     if (!enabled)
         return false;
 
     const char *nedType = component->getComponentType()->getFullName();
-    writer.recordParameter(componentFullPath, name, nedType, StringMap());
+    writer.recordParameter(componentFullPath, name, nedType, AttributeList());
     return true;
 }
 
@@ -41,6 +41,12 @@ class SqliteOutputScalarManager : public cIOutputScalarManager
     std::string fname;
     SqliteScalarFileWriter writer;
 
+    // reused in the record methods, to avoid memory allocations
+    ComponentPathCache componentPaths;
+    std::string objectFullPath;
+    AttributeList attributeList;
+    common::Histogram bins;
+
   protected:
     virtual void openFileForRun();
     virtual void closeFile();
@@ -51,6 +51,8 @@ extern omnetpp::cConfigOption *CFGID_VECTOR_RECORDING_INTERVALS;
 extern omnetpp::cConfigOption *CFGID_VECTOR_BUFFER;
 
 Register_GlobalConfigOption(CFGID_OUTPUT_VECTOR_DB_INDEXING, "output-vector-db-indexing", CFG_CUSTOM, "skip", "Whether and when to add an index to the 'vectordata' table in SQLite output vector files. Possible values: skip, ahead, after");
+Register_GlobalConfigOption(CFGID_OUTPUT_VECTOR_DB_WAL, "output-vector-db-wal", CFG_BOOL, "false", "Whether to use write-ahead logging (SQLite's WAL journal mode) while writing SQLite output vector files. This makes recording faster, but it does not work on network file systems. The file is switched back to the default journal mode when it is closed.");
+Register_GlobalConfigOption(CFGID_OUTPUT_VECTOR_DB_BLOCK_STORAGE, "output-vector-db-block-storage", CFG_BOOL, "false", "Whether to store vector data in SQLite output vector files as compressed blocks (one row per block in the 'vectorBlock' table), instead of one row per sample in the 'vectorData' table. Block storage is much faster to write and much more compact, but the data are not accessible with plain SQL.");
 
 void SqliteOutputVectorManager::startRun()
 {
@@ -68,6 +70,8 @@ void SqliteOutputVectorManager::startRun()
     // read configuration
     size_t memoryLimit = (size_t) getEnvir()->getConfig()->getAsDouble(CFGID_OUTPUTVECTOR_MEMORY_LIMIT);
     writer.setOverallMemoryLimit(memoryLimit);
+    writer.setWalMode(getEnvir()->getConfig()->getAsBool(CFGID_OUTPUT_VECTOR_DB_WAL));
+    writer.setBlockStorage(getEnvir()->getConfig()->getAsBool(CFGID_OUTPUT_VECTOR_DB_BLOCK_STORAGE));
 
     std::string indexModeStr = getEnvir()->getConfig()->getAsCustom(CFGID_OUTPUT_VECTOR_DB_INDEXING);
     if (indexModeStr == "skip")
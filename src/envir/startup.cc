@@ -43,6 +43,7 @@
 #include "matchableobject.h"
 #include "omnetppoutscalarmgr.h"
 #include "omnetppoutvectormgr.h"
+#include "omnetppbinoutvectormgr.h"
 #include "sqliteoutscalarmgr.h"
 #include "sqliteoutvectormgr.h"
 
@@ -284,6 +285,7 @@ void env_dummy_function()
     Speedometer a;
     OmnetppOutputScalarManager oosm;
     OmnetppOutputVectorManager oovm;
+    OmnetppBinaryOutputVectorManager obovm;
     SqliteOutputScalarManager sosm;
     SqliteOutputVectorManager sovm;
     FileSnapshotManager sm;
@@ -292,6 +294,7 @@ void env_dummy_function()
     (void)a;
     (void)oosm;
     (void)oovm;
+    (void)obovm;
     (void)sosm;
     (void)sovm;
     (void)sm;
@@ -101,6 +101,14 @@ Options::Options()
     verbose = false;
 }
 
+static FileReader *createFileReader(const char *fileName)
+{
+    // the eventlog file is not expected to change while the tool reads it
+    FileReader *fileReader = new FileReader(fileName);
+    fileReader->setUseMemoryMapping(true);
+    return fileReader;
+}
+
 IEventLog *Options::createEventLog(FileReader *fileReader)
 {
     if (eventNumbers.empty() &&
@@ -154,7 +162,7 @@ void Options::deleteEventLog(IEventLog *eventLog)
 eventnumber_t Options::getFirstEventNumber()
 {
     if (firstEventNumber == -2) {
-        FileReader *fileReader = new FileReader(inputFileName);
+        FileReader *fileReader = createFileReader(inputFileName);
         EventLog eventLog(fileReader);
 
         firstEventNumber = -1;
@@ -177,7 +185,7 @@ eventnumber_t Options::getFirstEventNumber()
 eventnumber_t Options::getLastEventNumber()
 {
     if (lastEventNumber == -2) {
-        FileReader *fileReader = new FileReader(inputFileName);
+        FileReader *fileReader = createFileReader(inputFileName);
         EventLog eventLog(fileReader);
 
         lastEventNumber = -1;
@@ -202,7 +210,7 @@ void offsets(Options options)
     if (options.verbose)
         fprintf(stdout, "# Printing event offsets from log file %s\n", options.inputFileName);
 
-    FileReader *fileReader = new FileReader(options.inputFileName);
+    FileReader *fileReader = createFileReader(options.inputFileName);
     EventLogIndex eventLogIndex(fileReader);
 
     long begin = clock();
@@ -234,7 +242,7 @@ void events(Options options)
     if (options.verbose)
         fprintf(stdout, "# Printing events from log file %s\n", options.inputFileName);
 
-    FileReader *fileReader = new FileReader(options.inputFileName);
+    FileReader *fileReader = createFileReader(options.inputFileName);
     EventLog eventLog(fileReader);
 
     long begin = clock();
@@ -261,7 +269,7 @@ void ranges(Options options)
     if (options.verbose)
         fprintf(stdout, "# Printing continuous ranges from log file %s\n", options.inputFileName);
 
-    FileReader *fileReader = new FileReader(options.inputFileName);
+    FileReader *fileReader = createFileReader(options.inputFileName);
     EventLog eventLog(fileReader);
 
     long begin = clock();
@@ -291,7 +299,7 @@ void echo(Options options)
     if (options.verbose)
         fprintf(stdout, "# Echoing events from log file %s from event number #%" EVENTNUMBER_PRINTF_FORMAT " to event number #%" EVENTNUMBER_PRINTF_FORMAT "\n", options.inputFileName, options.getFirstEventNumber(), options.getLastEventNumber());
 
-    FileReader *fileReader = new FileReader(options.inputFileName);
+    FileReader *fileReader = createFileReader(options.inputFileName);
     IEventLog *eventLog = options.createEventLog(fileReader);
 
     long begin = clock();
@@ -309,12 +317,13 @@ void cat(Options options)
     if (options.verbose)
         fprintf(stdout, "# Cating from file %s\n", options.inputFileName);
 
-    FileReader *fileReader = new FileReader(options.inputFileName);
+    FileReader *fileReader = createFileReader(options.inputFileName);
 
     long begin = clock();
-    char *line;
-    while ((line = fileReader->getNextLineBufferPointer()))
-        fprintf(stdout, "%.*s", fileReader->getCurrentLineLength(), line);
+    fileReader->readLines(0, -1, [](char *line, int length) {
+        fwrite(line, 1, length, stdout);
+        return true;
+    });
     long end = clock();
 
     if (options.verbose)
@@ -329,7 +338,7 @@ void filter(Options options)
         fprintf(stdout, "# Filtering events from log file %s for traced event number #%" EVENTNUMBER_PRINTF_FORMAT " from event number #%" EVENTNUMBER_PRINTF_FORMAT " to event number #%" EVENTNUMBER_PRINTF_FORMAT "\n",
                 options.inputFileName, tracedEventNumber, options.getFirstEventNumber(), options.getLastEventNumber());
 
-    FileReader *fileReader = new FileReader(options.inputFileName);
+    FileReader *fileReader = createFileReader(options.inputFileName);
     IEventLog *eventLog = options.createEventLog(fileReader);
 
     long begin = clock();
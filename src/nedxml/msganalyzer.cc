@@ -337,6 +337,12 @@ void MsgAnalyzer::analyzeClassOrStruct(ClassInfo& classInfo, const std::string&
         classInfo.fieldNameSuffix = "_var";
     }
 
+    // pooled
+    classInfo.basePooled = baseClassInfo != nullptr && baseClassInfo->pooled;
+    classInfo.pooled = getPropertyAsBool(classInfo.props, PROP_POOLED, classInfo.basePooled);
+    if (classInfo.pooled && !classInfo.iscObject)
+        errors->addError(classInfo.astNode, "%s: @pooled is only supported for classes derived from cObject", classInfo.name.c_str());
+
     // beforeChange
     classInfo.beforeChange = getProperty(classInfo.props, PROP_BEFORECHANGE, "");
     if (classInfo.beforeChange.empty() && baseClassInfo != nullptr)
@@ -697,6 +703,7 @@ MsgAnalyzer::ClassInfo MsgAnalyzer::extractClassInfoFromEnum(EnumElement *enumEl
     classInfo.baseClass = classInfo.extendsQName;
 
     classInfo.omitGetVerb = false;
+    classInfo.pooled = classInfo.basePooled = false;
     classInfo.fieldNameSuffix = "";
 
     classInfo.classInfoComplete = true;
@@ -473,6 +473,14 @@ void MsgCodeGenerator::generateClassDecl(const ClassInfo& classInfo, const std::
         else
             H << "{return new " << classInfo.className << "(*this);}\n";
     }
+    if (classInfo.pooled && !classInfo.basePooled) {
+        H << "    static void *operator new(size_t size) {return omnetpp::cMessage::allocateFromPool(size);}\n";
+        H << "    static void operator delete(void *p, size_t size) {omnetpp::cMessage::releaseToPool(p, size);}\n";
+    }
+    else if (!classInfo.pooled && classInfo.basePooled) {
+        H << "    static void *operator new(size_t size) {return ::operator new(size);}\n";
+        H << "    static void operator delete(void *p) {::operator delete(p);}\n";
+    }
     std::string maybe_override = classInfo.iscObject ? " override" : "";
     std::string maybe_handleChange = classInfo.beforeChange.empty() ? "" : (classInfo.beforeChange + ";");
     if (!classInfo.str.empty())
@@ -162,6 +162,8 @@ class NEDXML_API MsgTypeTable
         std::string extendsName;       // base type's name from MSG
         bool customize;                // from @customize
         bool omitGetVerb;              // from @omitGetVerb
+        bool pooled;                   // from @pooled (inherited from the base class if not specified)
+        bool basePooled;               // whether the base class is pooled
         bool isClass;                  // true=class, false=struct
         bool iscObject;                // whether type is subclassed from cObject
         bool iscNamedObject;           // whether type is subclassed from cNamedObject
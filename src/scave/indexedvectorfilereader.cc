@@ -41,11 +41,14 @@ IndexedVectorFileReader::IndexedVectorFileReader(const char *filename, bool incl
     std::string ifname = IndexFileUtils::getIndexFileName(filename);
     IndexFileReader indexReader(ifname.c_str());
     index = indexReader.readAll();
+    isBinary = IndexFileUtils::isBinaryVectorFile(filename);
 }
 
 IndexedVectorFileReader::~IndexedVectorFileReader()
 {
     delete index;
+    if (binaryFile)
+        fclose(binaryFile);
 }
 
 // see filemgrs.h
@@ -63,6 +66,9 @@ IndexedVectorFileReader::~IndexedVectorFileReader()
 
 Entries IndexedVectorFileReader::loadBlock(const Block& block, std::function<bool(const VectorDatum&)> filter)
 {
+    if (isBinary)
+        return loadBinaryBlock(block, filter);
+
     std::vector<VectorDatum> result;
 
     VectorInfo *vector = index->getVectorById(block.vectorId);
@@ -113,6 +119,43 @@ Entries IndexedVectorFileReader::loadBlock(const Block& block, std::function<boo
     return result;
 }
 
+Entries IndexedVectorFileReader::loadBinaryBlock(const Block& block, std::function<bool(const VectorDatum&)> filter)
+{
+    // read the whole block (header line and payload) in one go
+    if (!binaryFile && (binaryFile = fopen(fname.c_str(), "rb")) == nullptr)
+        throw opp_runtime_error("Cannot open vector file '%s'", fname.c_str());
+    blockBuffer.resize(block.size);
+    if (opp_fseek(binaryFile, block.startOffset, SEEK_SET) != 0 || fread(blockBuffer.data(), 1, block.size, binaryFile) != (size_t)block.size)
+        throw opp_runtime_error("Cannot read vector data from file '%s', block offset %" PRId64, fname.c_str(), (int64_t)block.startOffset);
+
+    BinaryVectorCodec::BlockHeader header;
+    CHECK(BinaryVectorCodec::parseBlockHeader(blockBuffer.data(), blockBuffer.size(), header), "Malformed block header", block, 0);
+    CHECK(header.vectorId == block.vectorId, "Unexpected vector id", block, 0);
+    CHECK(header.count == block.getCount(), "Block size does not match the index", block, 0);
+    CHECK(header.getBlockLength() <= blockBuffer.size(), "Truncated block", block, 0);
+
+    int count = header.count;
+    eventNumbers.resize(count);
+    rawTimes.resize(count);
+    values.resize(count);
+    codec.decodePayload(header, blockBuffer.data() + header.headerLength, eventNumbers.data(), rawTimes.data(), values.data());
+
+    std::vector<VectorDatum> result;
+    result.reserve(count);
+    bool hasEventNumbers = includeEventNumbers && header.hasEventNumbers;
+    for (int i = 0; i < count; ++i) {
+        VectorDatum entry;
+        entry.serial = block.startSerial+i;
+        if (hasEventNumbers)
+            entry.eventNumber = eventNumbers[i];
+        entry.simtime = BigDecimal(rawTimes[i], header.simtimeScaleExp);
+        entry.value = values[i];
+        if (!filter || filter(entry))
+            result.push_back(entry);
+    }
+    return result;
+}
+
 VectorDatum *IndexedVectorFileReader::getEntryBySerial(int vectorId, int64_t serial)
 {
     VectorInfo *vector = index->getVectorById(vectorId);
@@ -25,6 +25,7 @@
 #include <functional>
 #include <cstdarg>
 #include "common/filereader.h"
+#include "common/binaryvectorcodec.h"
 #include "scavedefs.h"
 #include "ivectordatareader.h"
 #include "resultfilemanager.h"
@@ -51,9 +52,18 @@ class SCAVE_API IndexedVectorFileReader : public IVectorDataReader
         VectorFileIndex *index; // index of the vector file, loaded fully into the memory
         bool includeEventNumbers;
 
+        // for binary vector files
+        bool isBinary;
+        FILE *binaryFile = nullptr;
+        omnetpp::common::BinaryVectorCodec codec;
+        std::vector<char> blockBuffer;
+        std::vector<int64_t> eventNumbers, rawTimes;
+        std::vector<double> values;
+
     protected:
         /** reads a block from the vector file */
         Entries loadBlock(const Block& block, std::function<bool(const VectorDatum&)> filter = nullptr);
+        Entries loadBinaryBlock(const Block& block, std::function<bool(const VectorDatum&)> filter);
 
     public:
         explicit IndexedVectorFileReader(const char* filename, bool includeEventNumbers, Adapter *adapter) :
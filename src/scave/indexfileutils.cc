@@ -46,20 +46,30 @@ bool IndexFileUtils::isIndexFile(const char *filename)
     return opp_stringendswith(filename, ".vci");
 }
 
-bool IndexFileUtils::isExistingVectorFile(const char *filename)
+static std::string readVersionLine(const char *filename)
 {
-    if (!opp_stringendswith(filename, ".vec"))
-        return false;
-
     FILE *f = fopen(filename, "r");
     if (!f)
-        return false;
+        return "";
 
     char buf[20] = "";
     fgets(buf, 20, f);
     fclose(f);
-    std::string trimmed = opp_trim(buf);
-    return trimmed == "version 2" || trimmed == "version 3";
+    return opp_trim(buf);
+}
+
+bool IndexFileUtils::isExistingVectorFile(const char *filename)
+{
+    if (!opp_stringendswith(filename, ".vec"))
+        return false;
+
+    std::string versionLine = readVersionLine(filename);
+    return versionLine == "version 2" || versionLine == "version 3" || versionLine == "version 4";
+}
+
+bool IndexFileUtils::isBinaryVectorFile(const char *filename)
+{
+    return readVersionLine(filename) == "version 4";
 }
 
 std::string IndexFileUtils::getVectorFileName(const char *filename)
@@ -37,6 +37,7 @@ class SCAVE_API IndexFileUtils
     public:
         static bool isIndexFile(const char *indexFileName);
         static bool isExistingVectorFile(const char *vectorFileName);
+        static bool isBinaryVectorFile(const char *vectorFileName);  // i.e. vector data is stored in binary blocks
         static std::string getIndexFileName(const char *vectorFileName);
         static std::string getVectorFileName(const char *indexFileName);
         /**
@@ -37,6 +37,7 @@
 #include "common/commonutil.h"
 #include "common/stringutil.h"
 #include "common/stlutil.h"
+#include "common/binaryvectorcodec.h"
 #include "omnetpp/platdep/platmisc.h"
 #include "indexfileutils.h"
 #include "indexfilereader.h"
@@ -44,6 +45,7 @@
 #include "scaveexception.h"
 #include "vectorfileindex.h"
 #include "vectorfileindexer.h"
+#include "resultfilecache.h"
 #include "interruptedflag.h"
 
 #ifdef THREADED
@@ -72,6 +74,8 @@ OmnetppResultFileLoader::OmnetppResultFileLoader(ResultFileManager *resultFileMa
     indexingOption = flags & (ResultFileManager::ALLOW_INDEXING|ResultFileManager::SKIP_IF_NO_INDEX|ResultFileManager::ALLOW_LOADING_WITHOUT_INDEX);
     lockfileOption = flags & (ResultFileManager::SKIP_IF_LOCKED|ResultFileManager::IGNORE_LOCK_FILE);
     verbose = flags & ResultFileManager::VERBOSE;
+    useCache = flags & ResultFileManager::USE_CACHE;
+    useMemoryMapping = flags & ResultFileManager::USE_MEMORY_MAPPING;
 }
 
 
@@ -90,7 +94,7 @@ void OmnetppResultFileLoader::processLine(char **vec, int numTokens, ParseContex
         int version;
         CHECK(numTokens == 2, "incorrect 'version' line -- version <number> expected");
         CHECK(parseInt(vec[1], version), "version is not a number");
-        CHECK(version == 2 || version == 3, "unsupported file version (version 2 or version 3 expected)");
+        CHECK(version >= 2 && version <= 4, "unsupported file version (version 2, 3 or 4 expected)");
         return;
     }
 
@@ -378,6 +382,29 @@ ResultFile *OmnetppResultFileLoader::loadFile(const char *displayName, const cha
 
         bool isVecFile = IndexFileUtils::isExistingVectorFile(fileSystemFileName);
         bool hasUpToDateIndex = isVecFile && IndexFileUtils::isIndexFileUpToDate(fileSystemFileName);
+        if (isVecFile && !hasUpToDateIndex && indexingOption == ResultFileManager::SKIP_IF_NO_INDEX) {
+            // checked before the cache, as the file must be skipped even if it is cached
+            LOG << "file " << fileSystemFileName << " has no valid index, skipping\n";
+            return nullptr;
+        }
+
+        if (useCache) {
+            // an up-to-date cache file makes both indexing and parsing unnecessary
+            fileRef = resultFileManager->addFile(displayName, fileSystemFileName, ResultFile::FILETYPE_OMNETPP);
+            try {
+                if (ResultFileCache::read(resultFileManager, fileRef, indexingOption)) {
+                    LOG << "read " << ResultFileCache::getCacheFileName(fileSystemFileName) << "\n";
+                    return fileRef;
+                }
+            }
+            catch (std::exception& e) {
+                LOG << "ignoring cache file: " << e.what() << "\n";
+            }
+            ResultFile *tmp = fileRef;
+            fileRef = nullptr;
+            resultFileManager->unloadFile(tmp);
+        }
+
         if (isVecFile && !hasUpToDateIndex) {
             // vector file with a missing or out-of-date index
             LOG << "file " << fileSystemFileName << " has no valid index, ";
@@ -386,7 +413,9 @@ ResultFile *OmnetppResultFileLoader::loadFile(const char *displayName, const cha
             case ResultFileManager::ALLOW_LOADING_WITHOUT_INDEX: LOG << "scanning vec file instead of vci\n"; break;
             case ResultFileManager::ALLOW_INDEXING: {
                 LOG << "reindexing..." << std::flush;
-                VectorFileIndexer().generateIndex(fileSystemFileName, nullptr);
+                VectorFileIndexer indexer;
+                indexer.setUseMemoryMapping(useMemoryMapping);
+                indexer.generateIndex(fileSystemFileName, nullptr);
                 hasUpToDateIndex = true;
                 LOG << "done\n";
                 break;
@@ -409,6 +438,9 @@ ResultFile *OmnetppResultFileLoader::loadFile(const char *displayName, const cha
             doLoadFile(fileSystemFileName, fileRef);
             LOG << "done\n";
         }
+
+        if (useCache && !ResultFileCache::write(fileRef, indexingOption))
+            LOG << "could not write " << ResultFileCache::getCacheFileName(fileSystemFileName) << "\n";
     }
     catch (std::exception&) {
         try {
@@ -426,18 +458,24 @@ void OmnetppResultFileLoader::doLoadFile(const char *fileName, ResultFile *fileR
 {
     // process lines in file
     FileReader freader(fileName);
-    char *line;
+    freader.setUseMemoryMapping(useMemoryMapping);
     LineTokenizer tokenizer;
     ParseContext ctx;
     ctx.fileRef = fileRef;
     ctx.fileName = fileRef->getFilePath().c_str();
     resetFields(ctx);
-    while ((line = freader.getNextLineBufferPointer()) != nullptr) {
-        int len = freader.getCurrentLineLength();
+    freader.readLines(0, -1, [&](char *line, int len) {
+        BinaryVectorCodec::BlockHeader header;
+        if (line[0] == 'b' && BinaryVectorCodec::parseBlockHeader(line, len, header)) {
+            // binary block of vector data, skip it
+            freader.seekTo(freader.getCurrentLineEndOffset() + header.payloadLength + 1);
+            return true;
+        }
         int numTokens = tokenizer.tokenize(line, len);
         char **tokens = tokenizer.tokens();
         processLine(tokens, numTokens, ctx);
-    }
+        return true;
+    });
     flush(ctx); // last result item
 }
 
@@ -52,6 +52,8 @@ class SCAVE_API OmnetppResultFileLoader : public IResultFileLoader
     int indexingOption;
     int lockfileOption;
     bool verbose;
+    bool useCache;
+    bool useMemoryMapping;
     InterruptedFlag *interrupted;
 
     struct ParseContext {
@@ -104,6 +104,8 @@ void ScaveTool::printHelpPage(const std::string& page)
                     "  'itervars'    Displays ${configname} ${iterationvars} ${repetition}\n"
                     "  'experiment'  Displays ${experiment} ${measurement} ${replication}\n");
         help.option("-k, --no-indexing", "Disallow automatic indexing of vector files");
+        help.option("-J, --jobs <n>", "Number of threads for loading result files; 0 means the number of CPU cores. The default is 1.");
+        help.option("-C, --cache", "Use binary cache files (<file>.cache) for faster loading; they are created or updated as needed");
         help.option("-v, --verbose", "Print info about progress (verbose)");
         help.line();
         help.para("The <files> argument accepts directories and glob/globstar patterns as well, in addition to file names. See main help page for details.");
@@ -123,6 +125,8 @@ void ScaveTool::printHelpPage(const std::string& page)
         help.option("-x <key>=<value>", "Option for the exporter. This option may occur multiple times.");
         help.option("--<key>=<value>", "Same as -x <key>=<value>.");
         help.option("-k, --no-indexing", "Disallow automatic indexing of vector files");
+        help.option("-J, --jobs <n>", "Number of threads for loading result files; 0 means the number of CPU cores. The default is 1.");
+        help.option("-C, --cache", "Use binary cache files (<file>.cache) for faster loading; they are created or updated as needed");
         help.option("-v, --verbose", "Print info about progress (verbose)");
         help.line();
         help.para("Supported export formats: " + opp_join(ExporterFactory::getSupportedFormats(), ", ", '\''));
@@ -208,7 +212,7 @@ void ScaveTool::printHelpPage(const std::string& page)
     }
 }
 
-void ScaveTool::loadFiles(ResultFileManager& manager, const vector<string>& fileNames, bool indexingAllowed, bool verbose)
+void ScaveTool::loadFiles(ResultFileManager& manager, const vector<string>& fileNames, bool indexingAllowed, bool useCache, bool verbose, int numJobs)
 {
     if (fileNames.empty()) {
         cerr << "opp_scavetool: Warning: No input files\n";
@@ -216,30 +220,31 @@ void ScaveTool::loadFiles(ResultFileManager& manager, const vector<string>& file
     }
 
     typedef ResultFileManager RFM;
-    int loadFlags = RFM::NEVER_RELOAD | (indexingAllowed ? RFM::ALLOW_INDEXING : RFM::ALLOW_LOADING_WITHOUT_INDEX) | RFM::SKIP_IF_LOCKED | (verbose ? RFM::VERBOSE : 0);
+    int loadFlags = RFM::NEVER_RELOAD | (indexingAllowed ? RFM::ALLOW_INDEXING : RFM::ALLOW_LOADING_WITHOUT_INDEX) | RFM::SKIP_IF_LOCKED | RFM::USE_MEMORY_MAPPING | (useCache ? RFM::USE_CACHE : 0) | (verbose ? RFM::VERBOSE : 0);
 
-    // load files
+    // collect files
+    std::vector<std::string> filesToLoad;
     for (auto& i : fileNames) {
         const char *fileArg = i.c_str();
-        std::vector<std::string> filesToLoad;
 
         if (isDirectory(fileArg)) {
-            filesToLoad = collectFilesInDirectory(fileArg, true, ".sca");
+            addAll(filesToLoad, collectFilesInDirectory(fileArg, true, ".sca"));
             addAll(filesToLoad, collectFilesInDirectory(fileArg, true, ".vec"));
         }
         else if (strchr(fileArg, '*') != nullptr || strchr(fileArg, '?') != nullptr) {
-            filesToLoad = collectMatchingFiles(fileArg);
-            if (filesToLoad.empty())
-                filesToLoad.push_back(fileArg); // like "bash" does; allows reporting errors in the pattern ("**/foo*.vec: no such file")
+            std::vector<std::string> matchingFiles = collectMatchingFiles(fileArg);
+            if (matchingFiles.empty())
+                matchingFiles.push_back(fileArg); // like "bash" does; allows reporting errors in the pattern ("**/foo*.vec: no such file")
+            addAll(filesToLoad, matchingFiles);
         }
         else {
             filesToLoad.push_back(fileArg);
         }
-
-        for (auto& fileName : filesToLoad)
-            manager.loadFile(fileName.c_str(), fileName.c_str(), loadFlags, nullptr);
     }
 
+    // load files
+    manager.loadFiles(filesToLoad, loadFlags, nullptr, numJobs);
+
     if (verbose)
         cout << manager.getFiles().size() << " file(s) loaded\n";
 }
@@ -280,6 +285,14 @@ int ScaveTool::resolveResultTypeFilter(const std::string& filter)
     return result;
 }
 
+int ScaveTool::parseJobs(const char *str)
+{
+    int numJobs;
+    if (!parseInt(str, numJobs) || numJobs < 0)
+        throw opp_runtime_error("Invalid number of jobs '%s' in '-J' option", str);
+    return numJobs;
+}
+
 string ScaveTool::rebuildCommandLine(int argc, char **argv)
 {
     string result;
@@ -368,6 +381,8 @@ void ScaveTool::queryCommand(int argc, char **argv)
     bool opt_useTabs = false;
     bool opt_verbose = false;
     bool opt_indexingAllowed = true;
+    int opt_numJobs = 1;
+    bool opt_useCache = false;
 
     // parse options
     bool endOpts = false;
@@ -419,6 +434,12 @@ void ScaveTool::queryCommand(int argc, char **argv)
             opt_useTabs = true;
         else if (opt == "-k" || opt == "--no-indexing")
             opt_indexingAllowed = false;
+        else if ((opt == "-J" || opt == "--jobs") && i != argc-1)
+            opt_numJobs = parseJobs(argv[++i]);
+        else if (opt.substr(0,2) == "-J")
+            opt_numJobs = parseJobs(opt.substr(2).c_str());
+        else if (opt == "-C" || opt == "--cache")
+            opt_useCache = true;
         else if (opt == "-v" || opt == "--verbose")
             opt_verbose = true;
         else if (opt[0] != '-')
@@ -447,7 +468,7 @@ void ScaveTool::queryCommand(int argc, char **argv)
 
     // load files
     ResultFileManager resultFileManager;
-    loadFiles(resultFileManager, opt_fileNames, opt_indexingAllowed, opt_verbose);
+    loadFiles(resultFileManager, opt_fileNames, opt_indexingAllowed, opt_useCache, opt_verbose, opt_numJobs);
 
     // filter statistics
     IDList results = resultFileManager.getAllItems(opt_includeFields);
@@ -672,6 +693,8 @@ void ScaveTool::exportCommand(int argc, char **argv)
     int opt_resultTypeFilter = ResultFileManager::SCALAR | ResultFileManager::VECTOR | ResultFileManager::STATISTICS | ResultFileManager::HISTOGRAM | ResultFileManager::PARAMETER;
     bool opt_verbose = false;
     bool opt_indexingAllowed = true;
+    int opt_numJobs = 1;
+    bool opt_useCache = false;
     bool opt_includeFields = false;
     double opt_vectorStartTime = -INFINITY;
     double opt_vectorEndTime = INFINITY;
@@ -709,6 +732,12 @@ void ScaveTool::exportCommand(int argc, char **argv)
             opt_exporterOptions.push_back(opt.substr(2));
         else if (opt == "-k" || opt == "--no-indexing")
             opt_indexingAllowed = false;
+        else if ((opt == "-J" || opt == "--jobs") && i != argc-1)
+            opt_numJobs = parseJobs(argv[++i]);
+        else if (opt.substr(0,2) == "-J")
+            opt_numJobs = parseJobs(opt.substr(2).c_str());
+        else if (opt == "-C" || opt == "--cache")
+            opt_useCache = true;
         else if (opt == "-v" || opt == "--verbose")
             opt_verbose = true;
         else if (opt[0] == '-' && opt[1]== '-' && opt[2])
@@ -750,7 +779,7 @@ void ScaveTool::exportCommand(int argc, char **argv)
 
     // load files
     ResultFileManager resultFileManager;
-    loadFiles(resultFileManager, opt_fileNames, opt_indexingAllowed, opt_verbose);
+    loadFiles(resultFileManager, opt_fileNames, opt_indexingAllowed, opt_useCache, opt_verbose, opt_numJobs);
 
     // filter results
     IDList results = resultFileManager.getAllItems(opt_includeFields);
@@ -805,6 +834,7 @@ void ScaveTool::indexCommand(int argc, char **argv)
     }
 
     VectorFileIndexer indexer;
+    indexer.setUseMemoryMapping(true);
     int count = 0;
     for (int i = 0; i < (int)opt_fileNames.size(); i++) {
         const char *fileName = opt_fileNames[i].c_str();
@@ -27,7 +27,8 @@ namespace scave {
 class ScaveTool
 {
 protected:
-    void loadFiles(ResultFileManager& manager, const std::vector<std::string>& fileNames, bool indexingAllowed, bool verbose);
+    void loadFiles(ResultFileManager& manager, const std::vector<std::string>& fileNames, bool indexingAllowed, bool useCache, bool verbose, int numJobs);
+    int parseJobs(const char *str);
     std::string rebuildCommandLine(int argc, char **argv);
     int resolveResultTypeFilter(const std::string& filter);
 
@@ -0,0 +1,563 @@
+//=========================================================================
+//  RESULTFILECACHE.CC - part of
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <type_traits>
+#include <unordered_map>
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#endif
+#include "common/exception.h"
+#include "common/stringutil.h"
+#include "omnetpp/platdep/platmisc.h"
+#include "resultfilemanager.h"
+#include "resultfilecache.h"
+
+using namespace omnetpp::common;
+
+namespace omnetpp {
+namespace scave {
+
+#define CACHE_FILE_SUFFIX   ".cache"
+#define CACHE_FILE_VERSION  2
+#define BYTE_ORDER_MARK     0x01020304
+
+static const char CACHE_FILE_MAGIC[8] = {'O', 'P', 'P', 'C', 'A', 'C', 'H', 'E'};
+
+// records are copied in and out of the file with memcpy()
+static_assert(std::is_trivially_copyable<Statistics>::value, "Statistics must be trivially copyable");
+
+namespace {
+
+enum Table {
+    STRING_OFFSETS, // uint32_t offsets into STRING_DATA
+    STRING_DATA,    // zero-terminated strings
+    LISTS,          // uint32_t items: count, followed by count (key,value) string index pairs
+    RUNS, FILERUNS, SCALARS, PARAMETERS, VECTORS, STATISTICS, HISTOGRAMS, // records
+    DOUBLES,        // histogram data: underflows, overflows, bin edges, bin values
+    NUM_TABLES
+};
+
+struct TableEntry {
+    uint64_t offset; // from the beginning of the file
+    uint64_t size;   // in bytes
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint32_t layout;        // identifies the sizes of the record types
+    uint32_t loadFlags;     // the loader flags that affect the loaded contents, see getContentFlags()
+    int64_t lastModified;   // fingerprint of the result file
+    int64_t fileSize;
+    TableEntry tables[NUM_TABLES];
+};
+
+// string and list fields contain indices into STRING_OFFSETS and LISTS
+struct RunRecord { uint32_t name, attributes, itervars, configEntries; };
+struct FileRunRecord { uint32_t run; };
+struct ItemRecord { uint32_t fileRun, moduleName, name, attributes; };
+struct ScalarRecord { ItemRecord item; double value; };
+struct ParameterRecord { ItemRecord item; uint32_t value, reserved; };
+struct TimeRecord { int64_t intVal; int32_t scale, reserved; };  // BigDecimal
+struct VectorRecord { ItemRecord item; int32_t vectorId; uint32_t columns; eventnumber_t startEventNum, endEventNum; TimeRecord startTime, endTime; Statistics stat; };
+struct StatisticsRecord { ItemRecord item; Statistics stat; };
+struct HistogramRecord { ItemRecord item; Statistics stat; uint32_t bins, numBins; };  // bins: index into DOUBLES
+
+static TimeRecord toRecord(const BigDecimal& t)
+{
+    TimeRecord record;
+    record.intVal = t.getIntValue();
+    record.scale = t.getScale();
+    record.reserved = 0;
+    return record;
+}
+
+static BigDecimal fromRecord(const TimeRecord& record)
+{
+    if (record.scale == INT_MAX) {
+        BigDecimal t = BigDecimal::Nil;  // special values only differ in intVal
+        t.setIntValue(record.intVal);
+        return t;
+    }
+    return BigDecimal(record.intVal, record.scale);
+}
+
+// The result file may be loaded differently depending on the indexing flags
+// (e.g. from the .vci file, or by scanning the .vec file), so the cache is
+// only used with the same flags it was created with.
+static uint32_t getContentFlags(int loadFlags)
+{
+    return loadFlags & (ResultFileManager::ALLOW_INDEXING | ResultFileManager::SKIP_IF_NO_INDEX | ResultFileManager::ALLOW_LOADING_WITHOUT_INDEX);
+}
+
+static uint32_t getLayout()
+{
+    return sizeof(Header) ^ (sizeof(ScalarRecord) << 6) ^ (sizeof(VectorRecord) << 12) ^ (sizeof(StatisticsRecord) << 18) ^ (sizeof(HistogramRecord) << 24);
+}
+
+/**
+ * Collects the contents of the tables for writing a cache file.
+ */
+class TableBuilder
+{
+  public:
+    std::string tables[NUM_TABLES];
+
+  private:
+    std::unordered_map<std::string, uint32_t> stringIndices;
+    std::unordered_map<const void *, uint32_t> listIndices;
+    uint32_t numStrings = 0;
+    uint32_t listsSize = 0;
+    uint32_t doublesSize = 0;
+
+  public:
+    template<typename T>
+    void add(Table table, const T& record) {
+        tables[table].append((const char *)&record, sizeof(T));
+    }
+
+    uint32_t addString(const std::string& str) {
+        auto it = stringIndices.find(str);
+        if (it != stringIndices.end())
+            return it->second;
+        add(STRING_OFFSETS, (uint32_t)tables[STRING_DATA].size());
+        tables[STRING_DATA].append(str.c_str(), str.size() + 1);
+        stringIndices[str] = numStrings;
+        return numStrings++;
+    }
+
+    template<typename C>  // StringMap or OrderedKeyValueList
+    uint32_t addList(const C& list) {
+        // lists are identified by address, as the attributes of result items are pooled
+        auto it = listIndices.find(&list);
+        if (it != listIndices.end())
+            return it->second;
+        uint32_t index = listsSize;
+        add(LISTS, (uint32_t)list.size());
+        for (const auto& pair : list) {
+            add(LISTS, addString(pair.first));
+            add(LISTS, addString(pair.second));
+        }
+        listsSize += 1 + 2 * list.size();
+        listIndices[&list] = index;
+        return index;
+    }
+
+    uint32_t addDoubles(const std::vector<double>& values) {
+        uint32_t index = doublesSize;
+        for (double d : values)
+            add(DOUBLES, d);
+        doublesSize += values.size();
+        return index;
+    }
+};
+
+/**
+ * Read-only view of a file, memory-mapped where possible.
+ */
+class MappedFile
+{
+  public:
+    const char *data = nullptr;
+    size_t size = 0;
+  private:
+#ifdef _WIN32
+    std::string buffer;
+#endif
+  public:
+    MappedFile() {}
+    MappedFile(const MappedFile&) = delete;
+    bool open(const char *fileName);
+    ~MappedFile();
+};
+
+#ifndef _WIN32
+bool MappedFile::open(const char *fileName)
+{
+    int fd = ::open(fileName, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED)
+        return false;
+    data = (const char *)p;
+    size = st.st_size;
+    return true;
+}
+
+MappedFile::~MappedFile()
+{
+    if (data)
+        munmap((void *)data, size);
+}
+#else
+bool MappedFile::open(const char *fileName)
+{
+    FILE *f = fopen(fileName, "rb");
+    if (!f)
+        return false;
+    char buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        buffer.append(buf, n);
+    bool ok = !ferror(f) && !buffer.empty();
+    fclose(f);
+    data = buffer.data();
+    size = buffer.size();
+    return ok;
+}
+
+MappedFile::~MappedFile()
+{
+}
+#endif
+
+/**
+ * Bounds-checked access to the tables of a cache file.
+ */
+class TableReader
+{
+  private:
+    const char *data;
+    const Header& header;
+    const char *fileName;
+
+  public:
+    TableReader(const char *data, const Header& header, const char *fileName) : data(data), header(header), fileName(fileName) {}
+
+    void corrupt() const {
+        throw opp_runtime_error("Corrupt result cache file '%s'", fileName);
+    }
+
+    template<typename T>
+    size_t count(Table table) const {
+        return header.tables[table].size / sizeof(T);
+    }
+
+    template<typename T>
+    T get(Table table, size_t i) const {
+        if (i >= count<T>(table))
+            corrupt();
+        T result;
+        memcpy(&result, data + header.tables[table].offset + i * sizeof(T), sizeof(T));
+        return result;
+    }
+
+    const char *getString(uint32_t i) const {
+        uint32_t offset = get<uint32_t>(STRING_OFFSETS, i);
+        if (offset >= header.tables[STRING_DATA].size)
+            corrupt();
+        return data + header.tables[STRING_DATA].offset + offset;  // the table ends in '\0', checked in read()
+    }
+
+    template<typename C>
+    void getList(uint32_t i, C& result) const {
+        uint32_t n = get<uint32_t>(LISTS, i);
+        for (uint32_t k = 0; k < n; k++)
+            result.insert(result.end(), std::make_pair(std::string(getString(get<uint32_t>(LISTS, i + 1 + 2*k))), std::string(getString(get<uint32_t>(LISTS, i + 2 + 2*k)))));
+    }
+
+    void getDoubles(uint32_t i, size_t n, std::vector<double>& result) const {
+        result.resize(n);
+        for (size_t k = 0; k < n; k++)
+            result[k] = get<double>(DOUBLES, i + k);
+    }
+};
+
+}  // namespace
+
+std::string ResultFileCache::getCacheFileName(const char *resultFileName)
+{
+    return std::string(resultFileName) + CACHE_FILE_SUFFIX;
+}
+
+bool ResultFileCache::read(ResultFileManager *manager, ResultFile *file, int loadFlags)
+{
+    std::string cacheFileName = getCacheFileName(file->getFileSystemFilePath().c_str());
+    MappedFile cache;
+    if (!cache.open(cacheFileName.c_str()))
+        return false;
+
+    // check that the cache file is compatible and up to date
+    Header header;
+    if (cache.size < sizeof(header))
+        return false;
+    memcpy(&header, cache.data, sizeof(header));
+    if (memcmp(header.magic, CACHE_FILE_MAGIC, sizeof(header.magic)) != 0 || header.version != CACHE_FILE_VERSION ||
+            header.byteOrderMark != BYTE_ORDER_MARK || header.layout != getLayout())
+        return false;
+    if (header.lastModified != file->fingerprint.lastModified || header.fileSize != file->fingerprint.fileSize)
+        return false;
+    if (header.loadFlags != getContentFlags(loadFlags))
+        return false;
+
+    TableReader reader(cache.data, header, cacheFileName.c_str());
+    for (const TableEntry& table : header.tables)
+        if (table.offset > cache.size || table.size > cache.size - table.offset)
+            reader.corrupt();
+    const TableEntry& stringData = header.tables[STRING_DATA];
+    if (stringData.size > 0 && cache.data[stringData.offset + stringData.size - 1] != '\0')
+        reader.corrupt();
+
+    // runs and file runs; a run is only added together with its file run,
+    // so that unloading the file cleans up after a corrupt cache file
+    std::vector<FileRun *> fileRuns;
+    for (size_t i = 0; i < reader.count<FileRunRecord>(FILERUNS); i++) {
+        FileRunRecord fileRunRecord = reader.get<FileRunRecord>(FILERUNS, i);
+        RunRecord record = reader.get<RunRecord>(RUNS, fileRunRecord.run);
+        const char *runName = reader.getString(record.name);
+        Run *run = manager->getRunByName(runName);
+        if (!run) {
+            StringMap attributes, itervars;
+            OrderedKeyValueList configEntries;
+            reader.getList(record.attributes, attributes);
+            reader.getList(record.itervars, itervars);
+            reader.getList(record.configEntries, configEntries);
+            run = manager->addRun(runName);
+            run->attributes = std::move(attributes);
+            run->itervars = std::move(itervars);
+            run->configEntries = std::move(configEntries);
+        }
+        fileRuns.push_back(manager->addFileRun(file, run));
+    }
+
+    // result items; strings and attributes are pooled only once per cache entry
+    size_t numStrings = reader.count<uint32_t>(STRING_OFFSETS);
+    std::vector<const std::string *> moduleNameRefs(numStrings), nameRefs(numStrings);
+    std::unordered_map<uint32_t, const StringMap *> attributesRefs;
+    auto fill = [&](ResultItem& item, const ItemRecord& record) -> FileRun * {
+        if (record.fileRun >= fileRuns.size() || record.moduleName >= numStrings || record.name >= numStrings)
+            reader.corrupt();
+        item.fileRunRef = fileRuns[record.fileRun];
+        const std::string *& moduleNameRef = moduleNameRefs[record.moduleName];
+        if (!moduleNameRef)
+            moduleNameRef = manager->moduleNames.insert(reader.getString(record.moduleName));
+        item.moduleNameRef = moduleNameRef;
+        const std::string *& nameRef = nameRefs[record.name];
+        if (!nameRef)
+            nameRef = manager->names.insert(reader.getString(record.name));
+        item.nameRef = nameRef;
+        auto it = attributesRefs.find(record.attributes);
+        if (it != attributesRefs.end())
+            item.attributes = it->second;
+        else {
+            StringMap attrs;
+            reader.getList(record.attributes, attrs);
+            item.setAttributes(attrs);
+            attributesRefs[record.attributes] = item.attributes;
+        }
+        return item.fileRunRef;
+    };
+
+    for (size_t i = 0; i < reader.count<ScalarRecord>(SCALARS); i++) {
+        ScalarRecord record = reader.get<ScalarRecord>(SCALARS, i);
+        ScalarResult scalar;
+        FileRun *fileRun = fill(scalar, record.item);
+        scalar.value = record.value;
+        scalar.ownID = 0;
+        fileRun->scalarResults.push_back(scalar);
+    }
+
+    for (size_t i = 0; i < reader.count<ParameterRecord>(PARAMETERS); i++) {
+        ParameterRecord record = reader.get<ParameterRecord>(PARAMETERS, i);
+        ParameterResult parameter;
+        FileRun *fileRun = fill(parameter, record.item);
+        parameter.value = reader.getString(record.value);
+        fileRun->parameterResults.push_back(parameter);
+    }
+
+    for (size_t i = 0; i < reader.count<VectorRecord>(VECTORS); i++) {
+        VectorRecord record = reader.get<VectorRecord>(VECTORS, i);
+        VectorResult vector;
+        FileRun *fileRun = fill(vector, record.item);
+        vector.vectorId = record.vectorId;
+        vector.columns = reader.getString(record.columns);
+        vector.startEventNum = record.startEventNum;
+        vector.endEventNum = record.endEventNum;
+        vector.startTime = fromRecord(record.startTime);
+        vector.endTime = fromRecord(record.endTime);
+        vector.stat = record.stat;
+        fileRun->vectorResults.push_back(vector);
+    }
+
+    for (size_t i = 0; i < reader.count<StatisticsRecord>(STATISTICS); i++) {
+        StatisticsRecord record = reader.get<StatisticsRecord>(STATISTICS, i);
+        StatisticsResult statistics;
+        FileRun *fileRun = fill(statistics, record.item);
+        statistics.stat = record.stat;
+        fileRun->statisticsResults.push_back(statistics);
+    }
+
+    std::vector<double> edges, values;
+    for (size_t i = 0; i < reader.count<HistogramRecord>(HISTOGRAMS); i++) {
+        HistogramRecord record = reader.get<HistogramRecord>(HISTOGRAMS, i);
+        HistogramResult histogram;
+        FileRun *fileRun = fill(histogram, record.item);
+        histogram.stat = record.stat;
+        if (record.numBins > 0) {
+            reader.getDoubles(record.bins + 2, record.numBins + 1, edges);
+            reader.getDoubles(record.bins + 3 + record.numBins, record.numBins, values);
+            histogram.bins.setBins(edges, values);
+        }
+        histogram.bins.setUnderflows(reader.get<double>(DOUBLES, record.bins));
+        histogram.bins.setOverflows(reader.get<double>(DOUBLES, record.bins + 1));
+        fileRun->histogramResults.push_back(histogram);
+    }
+
+    return true;
+}
+
+bool ResultFileCache::write(ResultFile *file, int loadFlags)
+{
+    TableBuilder builder;
+
+    // collect data
+    std::unordered_map<Run *, uint32_t> runIndices;
+    for (FileRun *fileRun : file->fileRuns) {
+        Run *run = fileRun->runRef;
+        if (runIndices.find(run) == runIndices.end()) {
+            runIndices[run] = runIndices.size();
+            RunRecord record;
+            record.name = builder.addString(run->runName);
+            record.attributes = builder.addList(run->attributes);
+            record.itervars = builder.addList(run->itervars);
+            record.configEntries = builder.addList(run->configEntries);
+            builder.add(RUNS, record);
+        }
+        FileRunRecord record;
+        record.run = runIndices[run];
+        builder.add(FILERUNS, record);
+    }
+
+    auto makeItemRecord = [&](const ResultItem& item, uint32_t fileRunIndex) {
+        ItemRecord record;
+        record.fileRun = fileRunIndex;
+        record.moduleName = builder.addString(*item.moduleNameRef);
+        record.name = builder.addString(*item.nameRef);
+        record.attributes = builder.addList(*item.attributes);
+        return record;
+    };
+
+    std::vector<double> bins;
+    for (uint32_t k = 0; k < file->fileRuns.size(); k++) {
+        FileRun *fileRun = file->fileRuns[k];
+        for (const ScalarResult& scalar : fileRun->scalarResults) {
+            ScalarRecord record;
+            record.item = makeItemRecord(scalar, k);
+            record.value = scalar.value;
+            builder.add(SCALARS, record);
+        }
+        for (const ParameterResult& parameter : fileRun->parameterResults) {
+            ParameterRecord record;
+            record.item = makeItemRecord(parameter, k);
+            record.value = builder.addString(parameter.value);
+            record.reserved = 0;
+            builder.add(PARAMETERS, record);
+        }
+        for (const VectorResult& vector : fileRun->vectorResults) {
+            VectorRecord record;
+            memset((void *)&record, 0, sizeof(record));  // padding
+            record.item = makeItemRecord(vector, k);
+            record.vectorId = vector.vectorId;
+            record.columns = builder.addString(vector.columns);
+            record.startEventNum = vector.startEventNum;
+            record.endEventNum = vector.endEventNum;
+            record.startTime = toRecord(vector.startTime);
+            record.endTime = toRecord(vector.endTime);
+            record.stat = vector.stat;
+            builder.add(VECTORS, record);
+        }
+        for (const StatisticsResult& statistics : fileRun->statisticsResults) {
+            StatisticsRecord record;
+            memset((void *)&record, 0, sizeof(record));
+            record.item = makeItemRecord(statistics, k);
+            record.stat = statistics.stat;
+            builder.add(STATISTICS, record);
+        }
+        for (const HistogramResult& histogram : fileRun->histogramResults) {
+            HistogramRecord record;
+            memset((void *)&record, 0, sizeof(record));
+            record.item = makeItemRecord(histogram, k);
+            record.stat = histogram.stat;
+            const Histogram& h = histogram.bins;
+            bins.clear();
+            bins.push_back(h.getUnderflows());
+            bins.push_back(h.getOverflows());
+            bins.insert(bins.end(), h.getBinEdges().begin(), h.getBinEdges().end());
+            bins.insert(bins.end(), h.getBinValues().begin(), h.getBinValues().end());
+            record.bins = builder.addDoubles(bins);
+            record.numBins = h.getNumBins();
+            builder.add(HISTOGRAMS, record);
+        }
+    }
+
+    // lay out the tables after the header, 8-byte aligned
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CACHE_FILE_MAGIC, sizeof(header.magic));
+    header.version = CACHE_FILE_VERSION;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    header.layout = getLayout();
+    header.loadFlags = getContentFlags(loadFlags);
+    header.lastModified = file->fingerprint.lastModified;
+    header.fileSize = file->fingerprint.fileSize;
+    uint64_t offset = sizeof(header);
+    for (int i = 0; i < NUM_TABLES; i++) {
+        offset = (offset + 7) & ~(uint64_t)7;
+        header.tables[i].offset = offset;
+        header.tables[i].size = builder.tables[i].size();
+        offset += builder.tables[i].size();
+    }
+
+    // write into a temporary file, then rename, so that readers never see a partial file
+    std::string cacheFileName = getCacheFileName(file->getFileSystemFilePath().c_str());
+    std::string tmpFileName = cacheFileName + ".tmp" + opp_stringf("%d", (int)getpid());
+    FILE *f = fopen(tmpFileName.c_str(), "wb");
+    if (!f)
+        return false;
+    static const char padding[8] = {0};
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    uint64_t pos = sizeof(header);
+    for (int i = 0; i < NUM_TABLES && ok; i++) {
+        ok = fwrite(padding, 1, header.tables[i].offset - pos, f) == header.tables[i].offset - pos;
+        ok = ok && fwrite(builder.tables[i].data(), 1, builder.tables[i].size(), f) == builder.tables[i].size();
+        pos = header.tables[i].offset + header.tables[i].size;
+    }
+    ok = (fclose(f) == 0) && ok;
+    if (ok && rename(tmpFileName.c_str(), cacheFileName.c_str()) != 0) {
+        remove(cacheFileName.c_str());  // rename() does not overwrite on Windows
+        ok = rename(tmpFileName.c_str(), cacheFileName.c_str()) == 0;
+    }
+    if (!ok)
+        remove(tmpFileName.c_str());
+    return ok;
+}
+
+}  // namespace scave
+}  // namespace omnetpp
+
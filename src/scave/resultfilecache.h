@@ -0,0 +1,71 @@
+//=========================================================================
+//  RESULTFILECACHE.H - part of
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_SCAVE_RESULTFILECACHE_H
+#define __OMNETPP_SCAVE_RESULTFILECACHE_H
+
+#include <string>
+#include "scavedefs.h"
+
+namespace omnetpp {
+namespace scave {
+
+class ResultFileManager;
+class ResultFile;
+
+/**
+ * Persistent binary cache of the contents of an OMNeT++ result file, that is,
+ * the runs and result items loaded from an .sca file or from the index of a
+ * .vec file. The cache file is stored next to the result file, with the
+ * ".cache" suffix appended to its name. It is only used if the size and
+ * modification time of the result file recorded in it match the actual ones,
+ * and it was written with the same indexing-related load flags.
+ *
+ * The cache file consists of a header and tables of fixed-size records,
+ * referring to strings and other variable-length data by index; it is
+ * designed to be memory-mapped and read without any parsing. The format
+ * is specific to the byte order and the data layout of the build that
+ * wrote it; incompatible cache files are ignored.
+ */
+class SCAVE_API ResultFileCache
+{
+  public:
+    /**
+     * Returns the name of the cache file belonging to the given result file.
+     */
+    static std::string getCacheFileName(const char *resultFileName);
+
+    /**
+     * Loads the cached contents of the given result file (which must have
+     * been added to the ResultFileManager, but must not contain any runs yet).
+     * loadFlags are the ResultFileManager::LoadFlags the file is loaded with.
+     * Returns false if there is no up-to-date cache file for it, or it was
+     * written with different flags. Throws an exception if the cache file
+     * is corrupt; the file must be unloaded then.
+     */
+    static bool read(ResultFileManager *manager, ResultFile *file, int loadFlags);
+
+    /**
+     * Writes the contents of the given (fully loaded) result file into its
+     * cache file, together with the relevant bits of loadFlags (see read()).
+     * Returns false if the cache file could not be written.
+     */
+    static bool write(ResultFile *file, int loadFlags);
+};
+
+} // namespace scave
+}  // namespace omnetpp
+
+
+#endif
@@ -23,6 +23,10 @@
 #include <algorithm>
 #include <utility>
 #include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 #include "common/opp_ctype.h"
 #include "common/matchexpression.h"
 #include "common/patternmatcher.h"
@@ -99,15 +103,20 @@ void ResultFileManager::clear()
     for (ResultFile *file : fileList)
         delete file;
 
+    for (const StringMap *attrs : attrsPool)
+        delete attrs;
+
     fileRunList.clear();
     runList.clear();
     runsByName.clear();
     fileList.clear();
     filesByDisplayName.clear();
+    attrsPool.clear();
 
     moduleNames.clear();
     names.clear();
     classNames.clear();
+    namesWithSuffixCache.clear();
 }
 
 ResultFileList ResultFileManager::getFiles() const
@@ -1251,15 +1260,11 @@ static bool isFileReadable(const char *fileName)
 
 #define LOG !verbose ? std::cout : std::cout
 
-ResultFile *ResultFileManager::loadFile(const char *displayName, const char *fileSystemFileName, int flags, InterruptedFlag *interrupted)
+void ResultFileManager::checkLoadFlags(int flags)
 {
-    WRITER_MUTEX
-
-    // extract and validate flags
     int reloadOption = flags & (RELOAD|RELOAD_IF_CHANGED|NEVER_RELOAD);
     int indexingOption = flags & (ALLOW_INDEXING|SKIP_IF_NO_INDEX|ALLOW_LOADING_WITHOUT_INDEX);
     int lockfileOption = flags & (SKIP_IF_LOCKED|IGNORE_LOCK_FILE);
-    bool verbose = (flags & VERBOSE) != 0;
 
     if (reloadOption != RELOAD && reloadOption != RELOAD_IF_CHANGED && reloadOption != NEVER_RELOAD)
         throw opp_runtime_error("invalid reload flags %d, must be one of: RELOAD, RELOAD_IF_CHANGED, NEVER_RELOAD", reloadOption);
@@ -1267,13 +1272,17 @@ ResultFile *ResultFileManager::loadFile(const char *displayName, const char *fil
         throw opp_runtime_error("invalid indexing flags %d, must be one of: ALLOW_INDEXING, SKIP_IF_NO_INDEX, ALLOW_LOADING_WITHOUT_INDEX", indexingOption);
     if (lockfileOption != SKIP_IF_LOCKED && lockfileOption != IGNORE_LOCK_FILE)
         throw opp_runtime_error("invalid lockfile handling flags %d, must be one of: SKIP_IF_LOCKED, IGNORE_LOCK_FILE", lockfileOption);
+}
 
-    if (interrupted == nullptr) {
-        static InterruptedFlag neverInterrupted;
-        interrupted = &neverInterrupted; // eliminate need for nullptr checks
-    }
+ResultFile *ResultFileManager::handleAlreadyLoaded(const char *displayName, const char *fileSystemFileName, int flags)
+{
+    // returns the file if it is already loaded and should be kept; otherwise unloads it
+    // (if needed) and returns nullptr, meaning that the file needs to be loaded
+    WRITER_MUTEX
+
+    int reloadOption = flags & (RELOAD|RELOAD_IF_CHANGED|NEVER_RELOAD);
+    bool verbose = (flags & VERBOSE) != 0;
 
-    // check if loaded
     ResultFile *fileRef = getFile(displayName);
     if (fileRef) {
         FileFingerprint fingerprint = readFileFingerprint(fileSystemFileName);
@@ -1301,6 +1310,24 @@ ResultFile *ResultFileManager::loadFile(const char *displayName, const char *fil
             }
         }
     }
+    return nullptr;
+}
+
+ResultFile *ResultFileManager::loadFile(const char *displayName, const char *fileSystemFileName, int flags, InterruptedFlag *interrupted)
+{
+    WRITER_MUTEX
+
+    checkLoadFlags(flags);
+
+    if (interrupted == nullptr) {
+        static InterruptedFlag neverInterrupted;
+        interrupted = &neverInterrupted; // eliminate need for nullptr checks
+    }
+
+    // check if loaded
+    ResultFile *fileRef = handleAlreadyLoaded(displayName, fileSystemFileName, flags);
+    if (fileRef)
+        return fileRef;
 
     // try if file can be opened, before we add it to our database
     if (fileSystemFileName == nullptr)
@@ -1320,6 +1347,177 @@ ResultFile *ResultFileManager::loadFile(const char *displayName, const char *fil
     }
 }
 
+ResultFileList ResultFileManager::loadFiles(const StringVector& fileNames, int flags, InterruptedFlag *interrupted, int numThreads)
+{
+    checkLoadFlags(flags);
+
+    if (numThreads <= 0)
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+
+    ResultFileList result;
+    if (numThreads == 1 || fileNames.size() <= 1) {
+        for (const std::string& fileName : fileNames) {
+            ResultFile *file = loadFile(fileName.c_str(), fileName.c_str(), flags, interrupted);
+            if (file && !contains(result, file))
+                result.push_back(file);
+        }
+        return result;
+    }
+
+    // decide which files need to be loaded; this may unload files, so it is done upfront
+    struct Job {
+        std::string fileName;
+        ResultFile *file = nullptr;  // already loaded file, or the file in staging
+        std::unique_ptr<ResultFileManager> staging;
+        std::exception_ptr error;
+        bool done = false;
+    };
+    std::vector<Job> jobs;
+    std::set<std::string> seen;
+    for (const std::string& fileName : fileNames) {
+        if (!seen.insert(fileNameToSlash(fileName.c_str())).second)
+            continue; // listed twice
+        Job job;
+        job.fileName = fileName;
+        job.file = handleAlreadyLoaded(fileName.c_str(), fileName.c_str(), flags);
+        job.done = job.file != nullptr;
+        jobs.push_back(std::move(job));
+    }
+
+    // parse files into staging ResultFileManagers on worker threads
+    std::mutex mutex;
+    std::condition_variable doneCondition;
+    size_t nextJob = 0;
+    bool cancelled = false;
+    auto worker = [&]() {
+        while (true) {
+            Job *job;
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                while (nextJob < jobs.size() && jobs[nextJob].done)
+                    nextJob++;
+                if (cancelled || nextJob == jobs.size())
+                    return;
+                job = &jobs[nextJob++];
+            }
+            try {
+                job->staging.reset(new ResultFileManager());
+                job->file = job->staging->loadFile(job->fileName.c_str(), job->fileName.c_str(), flags, interrupted);
+            }
+            catch (...) {
+                job->error = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                job->done = true;
+            }
+            doneCondition.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numThreads && i < (int)jobs.size(); i++)
+        threads.push_back(std::thread(worker));
+
+    // merge the results in the original order, while the workers are parsing the subsequent files
+    try {
+        for (Job& job : jobs) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                doneCondition.wait(lock, [&job]() {return job.done;});
+            }
+            if (job.error)
+                std::rethrow_exception(job.error);
+            if (job.staging) {
+                if (job.file)
+                    adoptFile(*job.staging, job.file);
+                job.staging.reset();
+            }
+            if (job.file)
+                result.push_back(job.file);
+        }
+    }
+    catch (...) {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            cancelled = true;
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        throw;
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+    return result;
+}
+
+void ResultFileManager::adoptFile(ResultFileManager& staging, ResultFile *file)
+{
+    // Move the file (which was loaded into staging) over to this ResultFileManager,
+    // together with its FileRuns and result items. Strings and attribute maps are
+    // re-pooled; Runs are merged with existing ones of the same name.
+    WRITER_MUTEX
+
+    serial++;
+
+    staging.fileList.erase(file);
+    staging.filesByDisplayName.erase(file->getFilePath());
+    file->resultFileManager = this;
+    fileList.insert(file);
+    filesByDisplayName[file->getFilePath()] = file;
+
+    // translation of pooled objects; items typically share a few of them
+    std::unordered_map<const std::string *, const std::string *> moduleNameMap, nameMap;
+    std::unordered_map<const StringMap *, const StringMap *> attrsMap;
+    auto adoptItem = [&](ResultItem& item) {
+        const std::string *& moduleNameRef = moduleNameMap[item.moduleNameRef];
+        if (!moduleNameRef)
+            moduleNameRef = moduleNames.insert(*item.moduleNameRef);
+        item.moduleNameRef = moduleNameRef;
+
+        const std::string *& nameRef = nameMap[item.nameRef];
+        if (!nameRef)
+            nameRef = names.insert(*item.nameRef);
+        item.nameRef = nameRef;
+
+        const StringMap *& attributes = attrsMap[item.attributes];
+        if (!attributes)
+            item.setAttributes(*item.attributes);  // looks up the pool of this ResultFileManager, via fileRunRef
+        else
+            item.attributes = attributes;
+        attributes = item.attributes;
+    };
+
+    for (FileRun *fileRun : file->fileRuns) {
+        Run *stagingRun = fileRun->runRef;
+        Run *run = getRunByName(stagingRun->getRunName().c_str());
+        if (!run) {
+            run = addRun(stagingRun->getRunName());
+            run->attributes = stagingRun->attributes;
+            run->itervars = stagingRun->itervars;
+            run->configEntries = stagingRun->configEntries;
+        }
+
+        staging.fileRunList[fileRun->id] = nullptr;  // staging will only delete its Run objects
+        fileRun->id = fileRunList.size();
+        fileRunList.push_back(fileRun);
+        fileRun->runRef = run;
+        run->fileRuns.push_back(fileRun);
+
+        for (ResultItem& item : fileRun->scalarResults)
+            adoptItem(item);
+        for (ResultItem& item : fileRun->parameterResults)
+            adoptItem(item);
+        for (ResultItem& item : fileRun->vectorResults)
+            adoptItem(item);
+        for (ResultItem& item : fileRun->statisticsResults)
+            adoptItem(item);
+        for (ResultItem& item : fileRun->histogramResults)
+            adoptItem(item);
+    }
+}
+
 #undef LOG
 
 void ResultFileManager::setFileInput(ResultFile *file, const char *inputName)
@@ -53,6 +53,7 @@ class InterruptedFlag;
 class CmpBase;
 class OmnetppResultFileLoader;
 class SqliteResultFileLoader;
+class ResultFileCache;
 
 typedef std::vector<std::string> StringVector;
 typedef std::set<std::string> StringSet;
@@ -124,6 +125,12 @@ class SCAVE_API ResultFileManager
 
         VERBOSE = (1<<8), // print on stdout what it's doing
 
+        // Whether to read/write a binary cache file (<file>.cache) next to the result file, see ResultFileCache
+        USE_CACHE = (1<<9), // load from cache if up to date, and create/update it after parsing
+
+        // Faster reading, but the process may crash if a file is truncated while being read
+        USE_MEMORY_MAPPING = (1<<10), // memory-map text files while parsing or indexing them
+
         LOADFLAGS_DEFAULTS = RELOAD_IF_CHANGED | ALLOW_INDEXING | SKIP_IF_LOCKED
     };
 
@@ -135,6 +142,7 @@ class SCAVE_API ResultFileManager
     friend class CmpBase; // uncheckedGet...()
     friend class OmnetppResultFileLoader;
     friend class SqliteResultFileLoader;
+    friend class ResultFileCache;
   private:
     int serial = 0; // incremented at each results change
 
@@ -199,6 +207,11 @@ class SCAVE_API ResultFileManager
     int addStatistics(FileRun *fileRunRef, const char *moduleName, const char *statisticsName, const Statistics& stat, const StringMap& attrs);
     int addHistogram(FileRun *fileRunRef, const char *moduleName, const char *histogramName, const Statistics& stat, const Histogram& bins, const StringMap& attrs);
 
+    // utility functions for loadFile() and loadFiles()
+    static void checkLoadFlags(int flags);
+    ResultFile *handleAlreadyLoaded(const char *displayName, const char *fileSystemFileName, int flags);
+    void adoptFile(ResultFileManager& staging, ResultFile *file);
+
     FileRun *getFileRunForID(ID id) const; // checks for nullptr
 
     void makeIDs(std::vector<ID>& out, FileRun *fileRun, int numItems, int type) const;
@@ -358,6 +371,15 @@ class SCAVE_API ResultFileManager
      * the file is actually read from fileSystemFileName.
      */
     ResultFile *loadFile(const char *displayName, const char *fileSystemFileName, int flags, InterruptedFlag *interrupted);
+
+    /**
+     * Loads several files at once (displayName is the same as the file name),
+     * parsing them concurrently on numThreads threads; numThreads=0 means the
+     * number of hardware threads. Each file is parsed into a private staging
+     * ResultFileManager, and merged into this one in the order of the list.
+     * Returns the loaded files in the same order, with skipped files left out.
+     */
+    ResultFileList loadFiles(const StringVector& fileNames, int flags, InterruptedFlag *interrupted, int numThreads=0);
     void setFileInput(ResultFile *file, const char *inputName); // for the "Inputs" page in the IDE
     void unloadFile(ResultFile *file);
     void unloadFile(const char *displayName);
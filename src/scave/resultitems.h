@@ -51,6 +51,7 @@ class FileRun;
 class ResultFileManager;
 class OmnetppResultFileLoader;
 class SqliteResultFileLoader;
+class ResultFileCache;
 
 typedef std::vector<std::string> StringVector;
 typedef std::set<std::string> StringSet;
@@ -69,6 +70,7 @@ class SCAVE_API ResultItem
 {
     friend class ResultFileManager;
     friend class SqliteResultFileLoader;
+    friend class ResultFileCache;
 
   public:
     enum DataType { TYPE_INT, TYPE_DOUBLE, TYPE_ENUM };
@@ -136,6 +138,7 @@ class SCAVE_API ResultItem
 class SCAVE_API ScalarResult : public ResultItem
 {
     friend class ResultFileManager;
+    friend class ResultFileCache;
   private:
     double value;
     ID ownID; // indicates whether this scalar is a field of a histogram/vector/etc; and if so, which field of which item
@@ -158,9 +161,11 @@ class SCAVE_API ScalarResult : public ResultItem
 class SCAVE_API ParameterResult : public ResultItem
 {
     friend class ResultFileManager;
+    friend class ResultFileCache;
   private:
     std::string value; //TODO stringpool
   protected:
+    ParameterResult() {} // for ResultFileCache
     ParameterResult(FileRun *fileRun, const std::string& moduleName, const std::string& name, const StringMap& attrs, const std::string& value) :
         ResultItem(fileRun, moduleName, name, attrs), value(value) {}
   public:
@@ -178,6 +183,7 @@ class SCAVE_API VectorResult : public ResultItem
     friend class ResultFileManager;
     friend class OmnetppResultFileLoader;
     friend class SqliteResultFileLoader;
+    friend class ResultFileCache;
   private:
     int vectorId;
     std::string columns;
@@ -185,6 +191,7 @@ class SCAVE_API VectorResult : public ResultItem
     simultime_t startTime, endTime;
     Statistics stat;
   protected:
+    VectorResult() : vectorId(-1), startEventNum(-1), endEventNum(-1) {} // for ResultFileCache
     VectorResult(FileRun *fileRun, const std::string& moduleName, const std::string& name, const StringMap& attrs, int vectorId, const std::string& columns) :
         ResultItem(fileRun, moduleName, name, attrs), vectorId(vectorId), columns(columns), startEventNum(-1), endEventNum(-1), startTime(0.0), endTime(0.0) {}
   public:
@@ -210,9 +217,11 @@ class SCAVE_API StatisticsResult : public ResultItem
     friend class ResultFileManager;
     friend class OmnetppResultFileLoader;
     friend class SqliteResultFileLoader;
+    friend class ResultFileCache;
   private:
     Statistics stat;
   protected:
+    StatisticsResult() {} // for ResultFileCache
     StatisticsResult(FileRun *fileRun, const std::string& moduleName, const std::string& name, const StringMap& attrs, const Statistics& stat) :
         ResultItem(fileRun, moduleName, name, attrs), stat(stat) {}
   public:
@@ -230,9 +239,11 @@ class SCAVE_API HistogramResult : public StatisticsResult
     friend class ResultFileManager;
     friend class OmnetppResultFileLoader;
     friend class SqliteResultFileLoader;
+    friend class ResultFileCache;
   private:
     Histogram bins;
   protected:
+    HistogramResult() {} // for ResultFileCache
     HistogramResult(FileRun *fileRun, const std::string& moduleName, const std::string& name, const StringMap& attrs, const Statistics& stat, const Histogram& bins) :
         StatisticsResult(fileRun, moduleName, name, attrs, stat), bins(bins) {}
   public:
@@ -259,6 +270,7 @@ class SCAVE_API ResultFile
 {
     friend class OmnetppResultFileLoader;
     friend class SqliteResultFileLoader;
+    friend class ResultFileCache;
     friend class ResultFileManager;
 
   public:
@@ -298,6 +310,7 @@ class SCAVE_API Run
     friend class ResultFileManager;
     friend class OmnetppResultFileLoader;
     friend class SqliteResultFileLoader;
+    friend class ResultFileCache;
 
   private:
     std::string runName; // unique identifier for the run, "runId"
@@ -348,6 +361,7 @@ class SCAVE_API FileRun
     friend class ResultFileManager;
     friend class OmnetppResultFileLoader;
     friend class SqliteResultFileLoader;
+    friend class ResultFileCache;
 
   private:
     int id;  // position in fileRunList
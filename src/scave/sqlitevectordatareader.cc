@@ -14,6 +14,7 @@
   `license' for details on this and other legal matters.
 *--------------------------------------------------------------*/
 
+#include <algorithm>
 #include "common/opp_ctype.h"
 #include "omnetpp/platdep/platmisc.h"
 #include "scaveutils.h"
@@ -194,6 +195,23 @@ void SqliteVectorDataReader::ensureDbOpen()
         }
 
         finalizeStatement();
+
+        // find vectors stored in blocks; older files have no vectorBlock table
+        prepareStatement("SELECT name FROM sqlite_master WHERE type = 'table' AND name = 'vectorBlock';");
+        bool hasBlockTable = sqlite3_step(stmt) == SQLITE_ROW;
+        finalizeStatement();
+
+        if (hasBlockTable) {
+            prepareStatement("SELECT DISTINCT vectorId FROM vectorBlock;");
+            while (true) {
+                int resultCode = sqlite3_step(stmt);
+                if (resultCode == SQLITE_DONE)
+                    break;
+                checkRow(resultCode);
+                blockStoredVectorIds.insert(sqlite3_column_int(stmt, 0));
+            }
+            finalizeStatement();
+        }
     }
 }
 
@@ -210,6 +228,168 @@ std::map<int, std::set<int>> SqliteVectorDataReader::groupVectorIdsBySimtimeExp(
     return result;
 }
 
+void SqliteVectorDataReader::splitVectorIds(const std::set<int>& vectorIds, std::set<int>& blockStoredIds, std::set<int>& rowStoredIds)
+{
+    for (int id : vectorIds)
+        (isBlockStored(id) ? blockStoredIds : rowStoredIds).insert(id);
+}
+
+int SqliteVectorDataReader::decodeBlock(int column)
+{
+    const char *data = (const char *)sqlite3_column_blob(stmt, column);
+    size_t length = sqlite3_column_bytes(stmt, column);
+
+    BinaryVectorCodec::BlockHeader header;
+    if (data == nullptr || !BinaryVectorCodec::parseBlockHeader(data, length, header) || header.getBlockLength() > length)
+        error("malformed vector data block");
+
+    blockEventNumbers.resize(header.count);
+    blockSimtimes.resize(header.count);
+    blockValues.resize(header.count);
+    if (!header.hasEventNumbers)
+        std::fill(blockEventNumbers.begin(), blockEventNumbers.end(), -1);
+    codec.decodePayload(header, data + header.headerLength, blockEventNumbers.data(), blockSimtimes.data(), blockValues.data());
+    return header.count;
+}
+
+void SqliteVectorDataReader::loadBlock(int64_t rowId)
+{
+    prepareStatement("SELECT data FROM vectorBlock WHERE rowid = ?;");
+    checkOK(sqlite3_bind_int64(stmt, 1, rowId));
+    checkRow(sqlite3_step(stmt));
+    decodeBlock(0);
+    finalizeStatement();
+}
+
+std::vector<SqliteVectorDataReader::BlockInfo> SqliteVectorDataReader::getBlockInfos(int vectorId, BlockColumn column)
+{
+    if (column == SIMTIME_COLUMN)
+        prepareStatement("SELECT rowid, count, startSimtimeRaw, endSimtimeRaw FROM vectorBlock WHERE vectorId = ? ORDER BY rowid;");
+    else
+        prepareStatement("SELECT rowid, count, startEventNum, endEventNum FROM vectorBlock WHERE vectorId = ? ORDER BY rowid;");
+    checkOK(sqlite3_bind_int64(stmt, 1, vectorId));
+
+    std::vector<BlockInfo> blocks;
+    int64_t serial = 0;
+    while (true) {
+        int resultCode = sqlite3_step(stmt);
+        if (resultCode == SQLITE_DONE)
+            break;
+        checkRow(resultCode);
+
+        BlockInfo block;
+        block.rowId = sqlite3_column_int64(stmt, 0);
+        block.serialBase = serial;
+        block.count = sqlite3_column_int(stmt, 1);
+        block.start = sqlite3_column_int64(stmt, 2);
+        block.end = sqlite3_column_int64(stmt, 3);
+        blocks.push_back(block);
+        serial += block.count;
+    }
+    finalizeStatement();
+    return blocks;
+}
+
+VectorDatum *SqliteVectorDataReader::findEntryInBlocks(int vectorId, BlockColumn column, int64_t key, bool after)
+{
+    // note: simtimes and event numbers are nondecreasing within a vector,
+    // so blocks can be skipped based on their first and last values
+    std::vector<BlockInfo> blocks = getBlockInfos(vectorId, column);
+    const std::vector<int64_t>& keys = column == SIMTIME_COLUMN ? blockSimtimes : blockEventNumbers;
+    int simtimeExp = getSimtimeExp(vectorId);
+
+    if (after) {
+        for (const BlockInfo& block : blocks) {
+            if (block.end < key)
+                continue;
+            loadBlock(block.rowId);
+            for (int i = 0; i < block.count; i++)
+                if (keys[i] >= key)
+                    return new VectorDatum(block.serialBase + i, blockEventNumbers[i], BigDecimal(blockSimtimes[i], simtimeExp), blockValues[i]);
+        }
+    }
+    else {
+        for (auto it = blocks.rbegin(); it != blocks.rend(); ++it) {
+            const BlockInfo& block = *it;
+            if (block.start > key)
+                continue;
+            loadBlock(block.rowId);
+            for (int i = block.count - 1; i >= 0; i--)
+                if (keys[i] <= key)
+                    return new VectorDatum(block.serialBase + i, blockEventNumbers[i], BigDecimal(blockSimtimes[i], simtimeExp), blockValues[i]);
+        }
+    }
+    return nullptr;
+}
+
+void SqliteVectorDataReader::collectBlockEntries(const std::set<int>& vectorIds, bool filter, BlockColumn column, int64_t start, int64_t end)
+{
+    // blocks outside the interval are not decoded, but still counted for the serial numbers
+    std::string dataExpr = "data";
+    if (filter)
+        dataExpr = column == SIMTIME_COLUMN ?
+                "CASE WHEN endSimtimeRaw >= ? AND startSimtimeRaw < ? THEN data END" :
+                "CASE WHEN endEventNum >= ? AND startEventNum < ? THEN data END";
+
+    prepareStatement((
+        "SELECT vectorId, count, " + dataExpr + " "
+        "FROM vectorBlock WHERE vectorId IN (" + makePlaceholders(vectorIds.size()) + ") ORDER BY rowid;").c_str());
+
+    int i = 1;
+    if (filter) {
+        checkOK(sqlite3_bind_int64(stmt, i++, start));
+        checkOK(sqlite3_bind_int64(stmt, i++, end));
+    }
+    for (int v : vectorIds)
+        checkOK(sqlite3_bind_int64(stmt, i++, v));
+
+    const std::vector<int64_t>& keys = column == SIMTIME_COLUMN ? blockSimtimes : blockEventNumbers;
+    std::map<int, int64_t> nextSerial;
+    int currentVectorId = -1;
+    std::vector<VectorDatum> entryBuffer;
+    entryBuffer.reserve(bufferSize);
+
+    while (true) {
+        int resultCode = sqlite3_step(stmt);
+        if (resultCode == SQLITE_DONE)
+            break;
+        checkRow(resultCode);
+
+        int vectorId = sqlite3_column_int(stmt, 0);
+        int count = sqlite3_column_int(stmt, 1);
+        int64_t& serial = nextSerial[vectorId];
+        int64_t serialBase = serial;
+        serial += count;
+
+        if (sqlite3_column_type(stmt, 2) == SQLITE_NULL)
+            continue;  // outside the interval
+        decodeBlock(2);
+
+        if (vectorId != currentVectorId) {
+            if (!entryBuffer.empty())
+                adapterLambda(currentVectorId, entryBuffer);
+            currentVectorId = vectorId;
+            entryBuffer.clear();
+        }
+
+        int simtimeExp = getSimtimeExp(vectorId);
+        for (int j = 0; j < count; j++) {
+            if (filter && (keys[j] < start || keys[j] >= end))
+                continue;
+            if (entryBuffer.size() >= bufferSize) {
+                adapterLambda(currentVectorId, entryBuffer);
+                entryBuffer.clear();
+            }
+            entryBuffer.push_back(VectorDatum(serialBase + j, blockEventNumbers[j], BigDecimal(blockSimtimes[j], simtimeExp), blockValues[j]));
+        }
+    }
+
+    if (!entryBuffer.empty())
+        adapterLambda(currentVectorId, entryBuffer);
+
+    finalizeStatement();
+}
+
 int SqliteVectorDataReader::getSerialForRowId(int64_t rowId)
 {
     prepareStatement(
@@ -262,6 +442,17 @@ VectorDatum *SqliteVectorDataReader::getEntryBySerial(int vectorId, int64_t seri
 {
     ensureDbOpen();
 
+    if (isBlockStored(vectorId)) {
+        for (const BlockInfo& block : getBlockInfos(vectorId, EVENTNUM_COLUMN)) {
+            if (serial >= block.serialBase && serial < block.serialBase + block.count) {
+                loadBlock(block.rowId);
+                int i = serial - block.serialBase;
+                return new VectorDatum(serial, blockEventNumbers[i], BigDecimal(blockSimtimes[i], getSimtimeExp(vectorId)), blockValues[i]);
+            }
+        }
+        return nullptr;
+    }
+
     prepareStatement(
             "SELECT rowid, eventNumber, simtimeRaw, value "
             "FROM vectorData WHERE vectorId = ? ORDER BY rowid LIMIT 1 OFFSET ?;");
@@ -276,6 +467,9 @@ VectorDatum *SqliteVectorDataReader::getEntryBySimtime(int vectorId, simultime_t
 {
     ensureDbOpen();
 
+    if (isBlockStored(vectorId))
+        return findEntryInBlocks(vectorId, SIMTIME_COLUMN, simtime.getMantissaForScale(getSimtimeExp(vectorId)), after);
+
     if (after) {
         prepareStatement(
             "SELECT rowid, eventNumber, simtimeRaw, value "
@@ -299,6 +493,9 @@ VectorDatum *SqliteVectorDataReader::getEntryByEventnum(int vectorId, eventnumbe
 {
     ensureDbOpen();
 
+    if (isBlockStored(vectorId))
+        return findEntryInBlocks(vectorId, EVENTNUM_COLUMN, eventNum, after);
+
     if (after) {
         prepareStatement(
             "SELECT rowid, eventNumber, simtimeRaw, value "
@@ -316,10 +513,17 @@ VectorDatum *SqliteVectorDataReader::getEntryByEventnum(int vectorId, eventnumbe
     return getSingleEntry(getSimtimeExp(vectorId));
 }
 
-void SqliteVectorDataReader::collectEntries(const std::set<int>& vectorIds)
+void SqliteVectorDataReader::collectEntries(const std::set<int>& allVectorIds)
 {
     ensureDbOpen();
 
+    std::set<int> blockStoredIds, vectorIds;
+    splitVectorIds(allVectorIds, blockStoredIds, vectorIds);
+    if (!blockStoredIds.empty())
+        collectBlockEntries(blockStoredIds, false, EVENTNUM_COLUMN, 0, 0);
+    if (vectorIds.empty())
+        return;
+
     prepareStatement((
         "SELECT vectorId, eventNumber, simtimeRaw, value "
         "FROM vectorData WHERE vectorId IN (" + makePlaceholders(vectorIds.size()) + ") ORDER BY rowid;").c_str());
@@ -339,14 +543,18 @@ void SqliteVectorDataReader::collectEntriesInSimtimeInterval(const std::set<int>
 
     for (auto vectorIdGroup : vectorIdGroups) {
         int simtimeExp = vectorIdGroup.first;
-        std::set<int>& idsInGroup = vectorIdGroup.second;
-
-        if (idsInGroup.empty())
-            continue; // safeguard
+        std::set<int> blockStoredIds, idsInGroup;
+        splitVectorIds(vectorIdGroup.second, blockStoredIds, idsInGroup);
 
         int64_t startTimeRaw = startTime.getMantissaForScale(simtimeExp);
         int64_t endTimeRaw = endTime.getMantissaForScale(simtimeExp);
 
+        if (!blockStoredIds.empty())
+            collectBlockEntries(blockStoredIds, true, SIMTIME_COLUMN, startTimeRaw, endTimeRaw);
+
+        if (idsInGroup.empty())
+            continue; // safeguard
+
         prepareStatement((
             "SELECT vectorId, eventNumber, simtimeRaw, value "
             "FROM vectorData WHERE vectorId IN (" + makePlaceholders(idsInGroup.size()) + ") "
@@ -363,10 +571,17 @@ void SqliteVectorDataReader::collectEntriesInSimtimeInterval(const std::set<int>
     }
 }
 
-void SqliteVectorDataReader::collectEntriesInEventnumInterval(const std::set<int>& vectorIds, eventnumber_t startEventNum, eventnumber_t endEventNum)
+void SqliteVectorDataReader::collectEntriesInEventnumInterval(const std::set<int>& allVectorIds, eventnumber_t startEventNum, eventnumber_t endEventNum)
 {
     ensureDbOpen();
 
+    std::set<int> blockStoredIds, vectorIds;
+    splitVectorIds(allVectorIds, blockStoredIds, vectorIds);
+    if (!blockStoredIds.empty())
+        collectBlockEntries(blockStoredIds, true, EVENTNUM_COLUMN, startEventNum, endEventNum);
+    if (vectorIds.empty())
+        return;
+
     prepareStatement((
         "SELECT vectorId, eventNumber, simtimeRaw, value "
         "FROM vectorData WHERE vectorId IN (" + makePlaceholders(vectorIds.size()) + ") "
@@ -22,6 +22,7 @@
 #include <string>
 #include "ivectordatareader.h"
 #include "common/sqlite3.h"
+#include "common/binaryvectorcodec.h"
 
 namespace omnetpp {
 namespace scave {
@@ -30,9 +31,24 @@ class VectorResult;
 
 #define SQLITEVECTORDATAREADER_BUFSIZE  (64*1024)
 
+/**
+ * Reads vector data from SQLite result files. Data may be stored either one
+ * sample per row in the vectorData table, or as blocks encoded with
+ * BinaryVectorCodec in the vectorBlock table (see SqliteVectorFileWriter);
+ * both are handled transparently.
+ */
 class SCAVE_API SqliteVectorDataReader : public IVectorDataReader
 {
     protected:
+        enum BlockColumn {EVENTNUM_COLUMN, SIMTIME_COLUMN}; // for searching/filtering blocks
+
+        struct BlockInfo {
+            int64_t rowId;
+            int64_t serialBase; // serial of the first entry in the block
+            int count;
+            int64_t start, end; // first and last values of the searched column
+        };
+
         sqlite3 *db;
         sqlite3_stmt *stmt; // we only have one prepared statement active at a time
         std::string filename;
@@ -40,6 +56,13 @@ class SCAVE_API SqliteVectorDataReader : public IVectorDataReader
         size_t bufferSize;
         AdapterLambdaType adapterLambda;
         std::map<int, int> simtimeExpForVectorId;
+        std::set<int> blockStoredVectorIds; // vectors stored in the vectorBlock table
+
+        // buffers for decoding blocks
+        omnetpp::common::BinaryVectorCodec codec;
+        std::vector<int64_t> blockEventNumbers;
+        std::vector<int64_t> blockSimtimes;
+        std::vector<double> blockValues;
 
     protected:
         void ensureDbOpen();
@@ -56,6 +79,14 @@ class SCAVE_API SqliteVectorDataReader : public IVectorDataReader
         VectorDatum *getSingleEntry(int simtimeExp);
         void processStatementRows();
 
+        bool isBlockStored(int vectorId) const {return blockStoredVectorIds.find(vectorId) != blockStoredVectorIds.end();}
+        void splitVectorIds(const std::set<int>& vectorIds, std::set<int>& blockStoredIds, std::set<int>& rowStoredIds);
+        int decodeBlock(int column);
+        void loadBlock(int64_t rowId);
+        std::vector<BlockInfo> getBlockInfos(int vectorId, BlockColumn column);
+        VectorDatum *findEntryInBlocks(int vectorId, BlockColumn column, int64_t key, bool after);
+        void collectBlockEntries(const std::set<int>& vectorIds, bool filter, BlockColumn column, int64_t start, int64_t end);
+
     public:
         explicit SqliteVectorDataReader(const char* filename, bool includeEventNumbers, Adapter *adapter, size_t bufferSize = SQLITEVECTORDATAREADER_BUFSIZE) :
             SqliteVectorDataReader(filename, includeEventNumbers, [adapter](int vectorId, const std::vector<VectorDatum>& data) { adapter->process(vectorId, data); }, bufferSize)
@@ -23,6 +23,7 @@
 #include "common/stringutil.h"
 #include "common/filereader.h"
 #include "common/linetokenizer.h"
+#include "common/binaryvectorcodec.h"
 #include "omnetpp/platdep/platmisc.h"
 #include "scaveutils.h"
 #include "scaveexception.h"
@@ -60,11 +61,11 @@ static string createTempFileName(const string& baseFileName)
 void VectorFileIndexer::generateIndex(const char *vectorFileName, IProgressMonitor *monitor)
 {
     FileReader reader(vectorFileName);
+    reader.setUseMemoryMapping(useMemoryMapping);
     LineTokenizer tokenizer(1024);
     VectorFileIndex index;
     index.vectorFileName = vectorFileName;
 
-    char *line;
     char **tokens;
     int64_t lineNo;
     int numTokens, numOfUnrecognizedLines = 0;
@@ -72,6 +73,13 @@ void VectorFileIndexer::generateIndex(const char *vectorFileName, IProgressMonit
     VectorInfo *lastVectorDecl = nullptr;
     Block *currentBlock = new Block();
 
+    // for binary vector files
+    FILE *binaryFile = nullptr;
+    BinaryVectorCodec codec;
+    std::vector<char> payload;
+    std::vector<int64_t> eventNumbers, rawTimes;
+    std::vector<double> values;
+
     int64_t onePercentFileSize = reader.getFileSize() / 100;
     int readPercentage = 0;
 
@@ -79,14 +87,15 @@ void VectorFileIndexer::generateIndex(const char *vectorFileName, IProgressMonit
         monitor->beginTask(string("Indexing ")+vectorFileName, 110);
 
     try {
-        while ((line = reader.getNextLineBufferPointer()) != nullptr) {
+        bool canceled = false;
+        reader.readLines(0, -1, [&](char *line, int lineLength) {
             if (monitor) {
                 if (monitor->isCanceled()) {
-                    monitor->done();
-                    return;
+                    canceled = true;
+                    return false;
                 }
                 if (onePercentFileSize > 0) {
-                    int64_t readBytes = reader.getNumReadBytes();
+                    int64_t readBytes = reader.getCurrentLineEndOffset();
                     int currentPercentage = readBytes / onePercentFileSize;
                     if (currentPercentage > readPercentage) {
                         monitor->worked(currentPercentage - readPercentage);
@@ -95,13 +104,53 @@ void VectorFileIndexer::generateIndex(const char *vectorFileName, IProgressMonit
                 }
             }
 
-            tokenizer.tokenize(line, reader.getCurrentLineLength());
+            BinaryVectorCodec::BlockHeader header;
+            if (line[0] == 'b' && BinaryVectorCodec::parseBlockHeader(line, lineLength, header)) {
+                // binary block: decode it to compute the statistics, then skip the payload
+                lineNo = reader.getNumReadLines();
+                VectorInfo *vectorRef = index.getVectorById(header.vectorId);
+                if (vectorRef == nullptr)
+                    throw ResultFileFormatException("Vector file indexer: Missing vector declaration", vectorFileName, lineNo);
+
+                if (!binaryFile && (binaryFile = fopen(vectorFileName, "rb")) == nullptr)
+                    throw opp_runtime_error("Vector file indexer: Cannot open '%s'", vectorFileName);
+                file_offset_t payloadOffset = reader.getCurrentLineEndOffset();
+                payload.resize(header.payloadLength);
+                if (opp_fseek(binaryFile, payloadOffset, SEEK_SET) != 0 || fread(payload.data(), 1, header.payloadLength, binaryFile) != header.payloadLength)
+                    throw ResultFileFormatException("Vector file indexer: Truncated binary block", vectorFileName, lineNo);
+
+                eventNumbers.resize(header.count);
+                rawTimes.resize(header.count);
+                values.resize(header.count);
+                try {
+                    codec.decodePayload(header, payload.data(), eventNumbers.data(), rawTimes.data(), values.data());
+                }
+                catch (opp_runtime_error& e) {
+                    throw ResultFileFormatException((std::string("Vector file indexer: ") + e.what()).c_str(), vectorFileName, lineNo);
+                }
+
+                Block *block = new Block();
+                block->vectorId = header.vectorId;
+                block->startOffset = reader.getCurrentLineStartOffset();
+                block->size = header.getBlockLength();
+                for (int i = 0; i < header.count; i++)
+                    block->collect(header.hasEventNumbers ? eventNumbers[i] : -1, BigDecimal(rawTimes[i], header.simtimeScaleExp), values[i]);
+                if (block->size > vectorRef->blockSize)
+                    vectorRef->blockSize = block->size;
+                vectorRef->addBlock(block);
+                index.addBlock(block);
+
+                reader.seekTo(payloadOffset + header.payloadLength + 1);
+                return true;
+            }
+
+            tokenizer.tokenize(line, lineLength);
             numTokens = tokenizer.numTokens();
             tokens = tokenizer.tokens();
             lineNo = reader.getNumReadLines();
 
             if (numTokens == 0 || tokens[0][0] == '#')
-                continue;
+                return true;
             else if ((tokens[0][0] == 'r' && strcmp(tokens[0], "run") == 0) ||
                      (tokens[0][0] == 'c' && strcmp(tokens[0], "config") == 0) ||
                      (tokens[0][0] == 'p' && strcmp(tokens[0], "param") == 0) ||
@@ -145,8 +194,8 @@ void VectorFileIndexer::generateIndex(const char *vectorFileName, IProgressMonit
                     throw ResultFileFormatException("Vector file indexer: Missing version number", vectorFileName, lineNo);
                 if (!parseInt(tokens[1], version))
                     throw ResultFileFormatException("Vector file indexer: Version is not a number", vectorFileName, lineNo);
-                if (version != 2 && version != 3)
-                    throw ResultFileFormatException("Vector file indexer: Expects version 2 or version 3", vectorFileName, lineNo);
+                if (version < 2 || version > 4)
+                    throw ResultFileFormatException("Vector file indexer: Expects version 2, 3 or 4", vectorFileName, lineNo);
             }
             else {  // data line
                 int vectorId;
@@ -156,7 +205,7 @@ void VectorFileIndexer::generateIndex(const char *vectorFileName, IProgressMonit
 
                 if (!parseInt(tokens[0], vectorId)) {
                     numOfUnrecognizedLines++;
-                    continue;
+                    return true;
                 }
 
                 if (currentVectorRef == nullptr || vectorId != currentVectorRef->vectorId) {
@@ -204,6 +253,14 @@ void VectorFileIndexer::generateIndex(const char *vectorFileName, IProgressMonit
 
                 currentBlock->collect(eventNum, simTime, value);
             }
+            return true;
+        });
+
+        if (canceled) {
+            if (binaryFile)
+                fclose(binaryFile);
+            monitor->done();
+            return;
         }
 
         // finish last block
@@ -221,10 +278,14 @@ void VectorFileIndexer::generateIndex(const char *vectorFileName, IProgressMonit
         }
     }
     catch (exception&) {
+        if (binaryFile)
+            fclose(binaryFile);
         if (monitor)
             monitor->done();
         throw;
     }
+    if (binaryFile)
+        fclose(binaryFile);
     if (monitor) {
         if (monitor->isCanceled()) {
             monitor->done();
@@ -33,9 +33,18 @@ class SCAVE_API VectorFileIndexer
     using VectorInfo = VectorFileIndex::VectorInfo;
     using Block = VectorFileIndex::Block;
 
+    private:
+        bool useMemoryMapping = false;
+
     public:
         typedef omnetpp::common::IProgressMonitor IProgressMonitor;
 
+        /**
+         * Whether to memory-map the vector file while indexing it. This is faster,
+         * but the file must not be truncated or overwritten in the meantime.
+         */
+        void setUseMemoryMapping(bool value) {useMemoryMapping = value;}
+
         void generateIndex(const char *filename, IProgressMonitor *monitor = nullptr);
 };
 
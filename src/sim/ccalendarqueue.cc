@@ -0,0 +1,466 @@
+//=========================================================================
+//  CCALENDARQUEUE.CC - part of
+//
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//   Member functions of
+//    cCalendarQueue : future event set, implemented as calendar queue
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <algorithm>
+#include <sstream>
+#include "omnetpp/globals.h"
+#include "omnetpp/cmessage.h"
+#include "omnetpp/csimulation.h"
+#include "omnetpp/ccalendarqueue.h"
+
+namespace omnetpp {
+
+Register_Class(cCalendarQueue);
+
+#define CBHEAPINDEX(i)    (-2-(i))
+#define CBINC(i)          ((i) = ((i)+1)&(cbsize-1))
+#define CBDEC(i)          ((i) = ((i)-1)&(cbsize-1))
+
+static const int MIN_BUCKETS = 16;  // must be power of 2!
+static const int WIDTH_SAMPLE_SIZE = 25;  // number of events used for estimating the bucket width
+
+// ordering of events inside a bucket: the event to be served first goes last
+static bool servedLater(const cEvent *a, const cEvent *b)
+{
+    return b->shouldPrecede(a);
+}
+
+static bool earlierArrival(const cEvent *a, const cEvent *b)
+{
+    return a->getArrivalTime() < b->getArrivalTime();
+}
+
+//----
+
+cCalendarQueue::cCalendarQueue(const char *name) : cFutureEventSet(name)
+{
+    buckets.resize(MIN_BUCKETS);
+    bucketWidth = 0;  // determined on first insertion
+    calendarLength = 0;
+    insertCount = 0;
+    currentBucket = 0;
+    currentSlot = 0;
+    firstEvent = nullptr;
+
+    cbsize = 4;  // must be power of 2!
+    cb = new cEvent *[cbsize];
+    cbhead = cbtail = 0;
+
+    flattenedValid = false;
+}
+
+cCalendarQueue::cCalendarQueue(const cCalendarQueue& other) : cFutureEventSet(other)
+{
+    cb = nullptr;
+    calendarLength = 0;
+    copy(other);
+}
+
+cCalendarQueue::~cCalendarQueue()
+{
+    clear();
+    delete[] cb;
+}
+
+std::string cCalendarQueue::str() const
+{
+    if (isEmpty())
+        return std::string("empty");
+    std::stringstream out;
+    out << "length=" << getLength() << ", buckets=" << buckets.size();
+    return out.str();
+}
+
+void cCalendarQueue::forEachChild(cVisitor *v)
+{
+    sort();
+
+    for (int i = cbhead; i != cbtail; CBINC(i))
+        v->visit(cb[i]);
+
+    for (cEvent *event : flattened)
+        v->visit(event);
+}
+
+void cCalendarQueue::clear()
+{
+    for (int i = cbhead; i != cbtail; CBINC(i))
+        dropAndDelete(cb[i]);
+    cbhead = cbtail = 0;
+
+    for (Bucket& bucket : buckets)
+        for (cEvent *event : bucket)
+            dropAndDelete(event);
+    std::vector<Bucket>(MIN_BUCKETS).swap(buckets);
+    calendarLength = 0;
+    currentBucket = 0;
+    currentSlot = 0;
+    firstEvent = nullptr;
+
+    flattened.clear();
+    flattenedValid = false;
+}
+
+void cCalendarQueue::copy(const cCalendarQueue& other)
+{
+    // copy calendar
+    buckets.clear();
+    buckets.resize(other.buckets.size());
+    for (int i = 0; i < (int)buckets.size(); i++) {
+        for (cEvent *event : other.buckets[i]) {
+            cEvent *copy = event->dup();
+            copy->insertOrder = event->insertOrder;
+            copy->heapIndex = i;
+            take(copy);
+            buckets[i].push_back(copy);
+        }
+    }
+    bucketWidth = other.bucketWidth;
+    calendarLength = other.calendarLength;
+    insertCount = other.insertCount;
+    currentBucket = other.currentBucket;
+    currentSlot = other.currentSlot;
+    firstEvent = nullptr;
+
+    // copy circular buffer
+    cbhead = other.cbhead;
+    cbtail = other.cbtail;
+    cbsize = other.cbsize;
+    delete[] cb;
+    cb = new cEvent *[cbsize];
+    for (int i = cbhead; i != cbtail; CBINC(i)) {
+        cEvent *copy = other.cb[i]->dup();
+        copy->insertOrder = other.cb[i]->insertOrder;
+        copy->heapIndex = CBHEAPINDEX(i);
+        take(cb[i] = copy);
+    }
+
+    flattened.clear();
+    flattenedValid = false;
+}
+
+cCalendarQueue& cCalendarQueue::operator=(const cCalendarQueue& other)
+{
+    if (this == &other)
+        return *this;
+    cFutureEventSet::operator=(other);
+    clear();
+    copy(other);
+    return *this;
+}
+
+cEvent *cCalendarQueue::get(int k)
+{
+    if (k < 0)
+        return nullptr;
+
+    // first few elements map into the circular buffer
+    int cblen = cblength();
+    if (k < cblen)
+        return cb[(cbhead+k) & (cbsize-1)];
+    k -= cblen;
+
+    // map the rest to the calendar
+    if (k >= calendarLength)
+        return nullptr;
+    validateFlattened();
+    return flattened[k];
+}
+
+void cCalendarQueue::validateFlattened()
+{
+    if (flattenedValid)
+        return;
+    flattened.clear();
+    flattened.reserve(calendarLength);
+    for (const Bucket& bucket : buckets)
+        flattened.insert(flattened.end(), bucket.rbegin(), bucket.rend());
+    flattenedValid = true;
+}
+
+void cCalendarQueue::sort()
+{
+    // note: the circular buffer is always sorted, and its events precede all events in the calendar
+    validateFlattened();
+    std::sort(flattened.begin(), flattened.end(), [](const cEvent *a, const cEvent *b) {return a->shouldPrecede(b);});
+}
+
+void cCalendarQueue::insert(cEvent *event)
+{
+    take(event);
+
+    event->insertOrder = insertCount++;
+
+    // is event eligible for putting it into the cb?
+    bool eligible = false;
+    simtime_t now = simTime();
+    if (event->getArrivalTime() == now) {
+        ASSERT(cbhead == cbtail || cb[cbhead]->getArrivalTime() == now); // causality violation
+        if (event->getSchedulingPriority() == 0) {
+            cEvent *first = calendarPeekFirst();
+            if (first == nullptr || first->getArrivalTime() > now)
+                eligible = true;
+        }
+        else if (event->getSchedulingPriority() < 0)
+            flushCb();  // move all events into the calendar
+    }
+
+    if (eligible)
+        cbInsert(event);
+    else
+        calendarInsert(event);
+}
+
+void cCalendarQueue::cbInsert(cEvent *event)
+{
+    cb[cbtail] = event;
+    event->heapIndex = CBHEAPINDEX(cbtail);
+    CBINC(cbtail);
+    if (cbtail == cbhead)
+        cbgrow();
+}
+
+void cCalendarQueue::cbgrow()
+{
+    int newsize = 2*cbsize;  // cbsize MUST be power of 2
+    cEvent **newcb = new cEvent *[newsize];
+    for (int i = 0; i < cbsize; i++)
+        (newcb[i] = cb[(cbhead+i)&(cbsize-1)])->heapIndex = CBHEAPINDEX(i);
+    delete[] cb;
+
+    cb = newcb;
+    cbhead = 0;
+    cbtail = cbsize;
+    cbsize = newsize;
+}
+
+void cCalendarQueue::flushCb()
+{
+    for (int i = cbhead; i != cbtail; CBINC(i))
+        calendarInsert(cb[i]);
+    cbtail = cbhead;
+}
+
+int64_t cCalendarQueue::getSlot(const cEvent *event) const
+{
+    return event->getArrivalTime().raw() / bucketWidth;
+}
+
+void cCalendarQueue::calendarInsert(cEvent *event)
+{
+    if (bucketWidth == 0)
+        bucketWidth = std::max(SimTime::getScale(), (int64_t)1);  // 1s, until we know better
+
+    int64_t slot = getSlot(event);
+    int index = getBucketIndex(slot);
+    Bucket& bucket = buckets[index];
+    bucket.insert(std::lower_bound(bucket.begin(), bucket.end(), event, servedLater), event);
+    event->heapIndex = index;
+
+    // maintain invariant: no event in the calendar is before currentSlot
+    if (calendarLength == 0 || slot < currentSlot) {
+        currentSlot = slot;
+        currentBucket = index;
+    }
+    if (calendarLength == 0 || (firstEvent != nullptr && event->shouldPrecede(firstEvent)))
+        firstEvent = event;
+
+    calendarLength++;
+    flattenedValid = false;
+
+    if (calendarLength > 2 * (int)buckets.size())
+        resize(2 * buckets.size());
+}
+
+void cCalendarQueue::calendarRemove(cEvent *event)
+{
+    Bucket& bucket = buckets[event->heapIndex];
+    if (bucket.back() == event)
+        bucket.pop_back();  // the common case
+    else {
+        auto it = std::lower_bound(bucket.begin(), bucket.end(), event, servedLater);
+        ASSERT(it != bucket.end() && *it == event);  // sanity check
+        bucket.erase(it);
+    }
+
+    if (event == firstEvent)
+        firstEvent = nullptr;
+
+    calendarLength--;
+    flattenedValid = false;
+
+    if ((int)buckets.size() > MIN_BUCKETS && calendarLength < (int)buckets.size() / 2)
+        resize(buckets.size() / 2);
+}
+
+cEvent *cCalendarQueue::calendarPeekFirst() const
+{
+    if (firstEvent != nullptr || calendarLength == 0)
+        return firstEvent;
+
+    // walk the buckets for one "year", starting at the current one
+    int numBuckets = buckets.size();
+    for (int i = 0; i < numBuckets; i++) {
+        const Bucket& bucket = buckets[currentBucket];
+        if (!bucket.empty() && getSlot(bucket.back()) <= currentSlot)
+            return firstEvent = bucket.back();
+        currentBucket = (currentBucket + 1) & (numBuckets - 1);
+        currentSlot++;
+    }
+
+    // nothing in the next year: fall back to direct search
+    cEvent *first = nullptr;
+    for (const Bucket& bucket : buckets)
+        if (!bucket.empty() && (first == nullptr || bucket.back()->shouldPrecede(first)))
+            first = bucket.back();
+    ASSERT(first != nullptr);
+    currentSlot = getSlot(first);
+    currentBucket = getBucketIndex(currentSlot);
+    return firstEvent = first;
+}
+
+int64_t cCalendarQueue::computeBucketWidth(std::vector<cEvent*>& events) const
+{
+    // estimate the average inter-event time from the earliest events, and
+    // choose a width that puts ~3 events into a bucket (see Brown's paper)
+    int n = std::min((int)events.size(), WIDTH_SAMPLE_SIZE);
+    if (n < 2)
+        return bucketWidth;
+    std::nth_element(events.begin(), events.begin() + (n-1), events.end(), earlierArrival);
+    std::sort(events.begin(), events.begin() + n, earlierArrival);
+
+    int64_t span = events[n-1]->getArrivalTime().raw() - events[0]->getArrivalTime().raw();
+    double averageSeparation = (double)span / (n-1);
+    if (averageSeparation == 0)
+        return bucketWidth;
+
+    // recompute the average, ignoring outliers
+    double sum = 0;
+    int count = 0;
+    for (int i = 1; i < n; i++) {
+        int64_t separation = events[i]->getArrivalTime().raw() - events[i-1]->getArrivalTime().raw();
+        if (separation <= 2 * averageSeparation) {
+            sum += separation;
+            count++;
+        }
+    }
+    double width = 3 * (count == 0 ? averageSeparation : sum / count);
+    return width < 1 ? 1 : width > INT64_MAX / 2 ? INT64_MAX / 2 : (int64_t)width;
+}
+
+void cCalendarQueue::resize(int numBuckets)
+{
+    std::vector<cEvent*> events;
+    events.reserve(calendarLength);
+    for (const Bucket& bucket : buckets)
+        events.insert(events.end(), bucket.begin(), bucket.end());
+
+    bucketWidth = computeBucketWidth(events);
+    std::vector<Bucket>(numBuckets).swap(buckets);
+
+    // redistribute events
+    cEvent *first = nullptr;
+    for (cEvent *event : events) {
+        buckets[getBucketIndex(getSlot(event))].push_back(event);
+        if (first == nullptr || event->shouldPrecede(first))
+            first = event;
+    }
+    for (int i = 0; i < numBuckets; i++) {
+        Bucket& bucket = buckets[i];
+        if (bucket.size() > 1)
+            std::sort(bucket.begin(), bucket.end(), servedLater);
+        for (cEvent *event : bucket)
+            event->heapIndex = i;
+    }
+
+    firstEvent = first;
+    if (first != nullptr) {
+        currentSlot = getSlot(first);
+        currentBucket = getBucketIndex(currentSlot);
+    }
+    flattenedValid = false;
+}
+
+cEvent *cCalendarQueue::peekFirst() const
+{
+    return cbhead != cbtail ? cb[cbhead] : calendarPeekFirst();
+}
+
+cEvent *cCalendarQueue::removeFirst()
+{
+    cEvent *event = nullptr;
+    if (cbhead != cbtail) {
+        // remove head element from circular buffer
+        event = cb[cbhead];
+        CBINC(cbhead);
+    }
+    else if (calendarLength > 0) {
+        event = calendarPeekFirst();
+        calendarRemove(event);
+    }
+    else
+        return nullptr;
+
+    drop(event);
+    event->heapIndex = -1;
+    return event;
+}
+
+cEvent *cCalendarQueue::remove(cEvent *event)
+{
+    // make sure it is really in the FES
+    if (event->heapIndex == -1)
+        return nullptr;
+
+    if (event->heapIndex < 0) {
+        // event is in the circular buffer
+        int i = -event->heapIndex-2;
+        ASSERT(cb[i] == event);  // sanity check
+
+        // remove
+        int iminus1 = i;
+        CBINC(i);
+        for (  /**/; i != cbtail; iminus1 = i, CBINC(i))
+            (cb[iminus1] = cb[i])->heapIndex = CBHEAPINDEX(iminus1);
+        CBDEC(cbtail);
+    }
+    else {
+        // event is in the calendar
+        calendarRemove(event);
+    }
+
+    drop(event);
+    event->heapIndex = -1;
+    return event;
+}
+
+void cCalendarQueue::putBackFirst(cEvent *event)
+{
+    take(event);
+
+    CBDEC(cbhead);
+    cb[cbhead] = event;
+    event->heapIndex = CBHEAPINDEX(cbhead);
+
+    if (cbtail == cbhead)
+        cbgrow();
+}
+
+}  // namespace omnetpp
+
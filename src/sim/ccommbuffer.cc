@@ -18,6 +18,7 @@
   `license' for details on this and other legal matters.
 *--------------------------------------------------------------*/
 
+#include <cstring>
 #include "omnetpp/ccommbuffer.h"
 #include "omnetpp/simutil.h"
 #include "omnetpp/cobject.h"
@@ -31,11 +32,29 @@ void cCommBuffer::packObject(cObject *obj)
     obj->parsimPack(this);
 }
 
+// Class lookup cache for unpackObject(). Received objects are almost always
+// of a handful of classes, so it is worth sparing the registration list
+// lookup (a std::map keyed by std::string) for every single object.
+static cObjectFactory *findFactoryCached(const char *className)
+{
+    const int CACHE_SIZE = 64;  // power of two
+    static cObjectFactory *cache[CACHE_SIZE];
+
+    unsigned int hash = 2166136261u;  // FNV-1a
+    for (const char *s = className; *s; s++)
+        hash = (hash ^ (unsigned char)*s) * 16777619u;
+
+    cObjectFactory *& entry = cache[hash & (CACHE_SIZE-1)];
+    if (entry == nullptr || strcmp(entry->getFullName(), className) != 0)
+        entry = cObjectFactory::get(className);
+    return entry;
+}
+
 cObject *cCommBuffer::unpackObject()
 {
     char *classname;
     unpack(classname);
-    cObject *obj = createOne(classname);
+    cObject *obj = findFactoryCached(classname)->createOne();
     delete[] classname;
 
     obj->parsimUnpack(this);
@@ -58,6 +58,8 @@ simsignal_t POST_MODEL_CHANGE = cComponent::registerSignal("POST_MODEL_CHANGE");
 EXECUTE_ON_SHUTDOWN(cComponent::clearSignalRegistrations());
 
 std::vector<int> cComponent::signalListenerCounts;
+std::vector<int> cComponent::signalBitIndices;
+int cComponent::numSignalBitIndices = 0;
 
 // Calling registerSignal in static initializers of runtime loaded dynamic
 // libraries would cause an assertion failure without this:
@@ -82,6 +84,7 @@ cComponent::cComponent(const char *name) : cDefaultOwner(name)
     displayString = nullptr;
 
     signalTable = nullptr;
+    signalFlags = nullptr;
 
     setLogLevel(LOGLEVEL_TRACE);
 }
@@ -95,6 +98,7 @@ cComponent::~cComponent()
     delete[] rngMap;
     delete[] parArray;
     delete displayString;
+    delete signalFlags;
 }
 
 void cComponent::forEachChild(cVisitor *v)
@@ -448,6 +452,7 @@ simsignal_t cComponent::registerSignal(const char *name)
         signalNameMapping->signalIDToName[signalID] = name;
         if (cStaticFlag::insideMain()) { // otherwise signalListenerCount[] may not have been initialized by C++ yet
             signalListenerCounts.push_back(0);
+            signalBitIndices.push_back(-1);
             ASSERT((int)signalListenerCounts.size() == lastSignalID+1);
         }
         return signalID;
@@ -474,6 +479,10 @@ void cComponent::clearSignalState()
     for (int & listenerCount : signalListenerCounts)
         listenerCount = 0;
 
+    // forget bit index assignments
+    signalBitIndices.assign(lastSignalID+1, -1);
+    numSignalBitIndices = 0;
+
     // clear notification stack
     notificationSP = 0;
 }
@@ -484,6 +493,86 @@ void cComponent::clearSignalRegistrations()
     signalNameMapping = nullptr;
 }
 
+int cComponent::getSignalBitIndex(simsignal_t signalID)
+{
+    int& bitIndex = signalBitIndices[signalID];
+    if (bitIndex == -1)
+        bitIndex = numSignalBitIndices++;
+    return bitIndex;
+}
+
+void cComponent::SignalBits::set(int k, bool value)
+{
+    size_t w = k >> 6;
+    if (w >= words.size()) {
+        if (!value)
+            return;
+        words.resize(w+1, 0);
+    }
+    if (value)
+        words[w] |= (uint64_t)1 << (k & 63);
+    else
+        words[w] &= ~((uint64_t)1 << (k & 63));
+}
+
+void cComponent::setLocalSignalFlag(simsignal_t signalID, bool value)
+{
+    int bitIndex = getSignalBitIndex(signalID);
+    if (!signalFlags)
+        signalFlags = new SignalFlags;
+    signalFlags->local.set(bitIndex, value);
+    propagateSignalFlag(bitIndex);
+}
+
+void cComponent::propagateSignalFlag(int bitIndex)
+{
+    // recompute our "effective" bit; if it changed, descendants need to be updated as well
+    cModule *parent = getParentModule();
+    bool value = (signalFlags && signalFlags->local.test(bitIndex)) ||
+            (parent && parent->signalFlags && parent->signalFlags->effective.test(bitIndex));
+    if (value == (signalFlags && signalFlags->effective.test(bitIndex)))
+        return;
+    if (!signalFlags)
+        signalFlags = new SignalFlags;
+    signalFlags->effective.set(bitIndex, value);
+
+    if (cModule *module = dynamic_cast<cModule *>(this)) {
+        for (cModule::ChannelIterator it(module); !it.end(); ++it)
+            (*it)->propagateSignalFlag(bitIndex);
+        for (cModule::SubmoduleIterator it(module); !it.end(); ++it)
+            (*it)->propagateSignalFlag(bitIndex);
+    }
+}
+
+void cComponent::repairSignalFlags()
+{
+    // recompute "effective" bits from scratch, in this component and all descendants;
+    // to be called when the component is inserted at some place in the module tree
+    cModule *parent = getParentModule();
+    SignalFlags *parentFlags = parent ? parent->signalFlags : nullptr;
+    if (signalFlags || parentFlags) {
+        if (!signalFlags)
+            signalFlags = new SignalFlags;
+        std::vector<uint64_t>& effective = signalFlags->effective.words;
+        const std::vector<uint64_t>& local = signalFlags->local.words;
+        effective = local;
+        if (parentFlags) {
+            const std::vector<uint64_t>& inherited = parentFlags->effective.words;
+            if (effective.size() < inherited.size())
+                effective.resize(inherited.size(), 0);
+            for (size_t i = 0; i < inherited.size(); i++)
+                effective[i] |= inherited[i];
+        }
+    }
+
+    if (cModule *module = dynamic_cast<cModule *>(this)) {
+        for (cModule::ChannelIterator it(module); !it.end(); ++it)
+            (*it)->repairSignalFlags();
+        for (cModule::SubmoduleIterator it(module); !it.end(); ++it)
+            (*it)->repairSignalFlags();
+    }
+}
+
 cComponent::SignalListenerList *cComponent::findListenerList(simsignal_t signalID) const
 {
     // note: we could use std::binary_search() instead of linear search here,
@@ -558,26 +647,11 @@ void cComponent::removeListenerList(simsignal_t signalID)
     }
 }
 
-bool cComponent::hasListeners(simsignal_t signalID) const
-{
-    // check local listeners
-    if (signalTable) {
-        int n = signalTable->size();
-        for (int i = 0; i < n; i++)
-            if ((*signalTable)[i].signalID == signalID)
-                return true;
-    }
-
-    // if not found, check ancestors
-    cModule *parent = getParentModule();
-    return parent ? parent->hasListeners(signalID) : false;
-}
-
 void cComponent::emit(simsignal_t signalID, bool b, cObject *details)
 {
     if (checkSignals)
         getComponentType()->checkSignal(signalID, SIMSIGNAL_BOOL);
-    if (mayHaveListeners(signalID))
+    if (hasListeners(signalID))
         fire(this, signalID, b, details);
 }
 
@@ -585,7 +659,7 @@ void cComponent::doEmit(simsignal_t signalID, intval_t i, cObject *details)
 {
     if (checkSignals)
         getComponentType()->checkSignal(signalID, SIMSIGNAL_INT);
-    if (mayHaveListeners(signalID))
+    if (hasListeners(signalID))
         fire(this, signalID, i, details);
 }
 
@@ -593,7 +667,7 @@ void cComponent::doEmit(simsignal_t signalID, uintval_t i, cObject *details)
 {
     if (checkSignals)
         getComponentType()->checkSignal(signalID, SIMSIGNAL_UINT);
-    if (mayHaveListeners(signalID))
+    if (hasListeners(signalID))
         fire(this, signalID, i, details);
 }
 
@@ -601,7 +675,7 @@ void cComponent::emit(simsignal_t signalID, double d, cObject *details)
 {
     if (checkSignals)
         getComponentType()->checkSignal(signalID, SIMSIGNAL_DOUBLE);
-    if (mayHaveListeners(signalID))
+    if (hasListeners(signalID))
         fire(this, signalID, d, details);
 }
 
@@ -609,7 +683,7 @@ void cComponent::emit(simsignal_t signalID, const SimTime& t, cObject *details)
 {
     if (checkSignals)
         getComponentType()->checkSignal(signalID, SIMSIGNAL_SIMTIME);
-    if (mayHaveListeners(signalID))
+    if (hasListeners(signalID))
         fire(this, signalID, t, details);
 }
 
@@ -619,7 +693,7 @@ void cComponent::emit(simsignal_t signalID, const char *s, cObject *details)
         throw cRuntimeError(this, "emit(): Emitting nullptr as string (const char *) signal value is not allowed, signalID=%d", signalID);
     if (checkSignals)
         getComponentType()->checkSignal(signalID, SIMSIGNAL_STRING);
-    if (mayHaveListeners(signalID))
+    if (hasListeners(signalID))
         fire(this, signalID, s, details);
 }
 
@@ -627,37 +701,41 @@ void cComponent::emit(simsignal_t signalID, cObject *obj, cObject *details)
 {
     if (checkSignals)
         getComponentType()->checkSignal(signalID, SIMSIGNAL_OBJECT, obj);
-    if (mayHaveListeners(signalID))
+    if (hasListeners(signalID))
         fire(this, signalID, obj, details);
 }
 
 template<typename T>
 void cComponent::fire(cComponent *source, simsignal_t signalID, T x, cObject *details)
 {
-    // notify local listeners if there are any
-    SignalListenerList *listenerList = findListenerList(signalID);
-    if (listenerList) {
-        cIListener **listeners = listenerList->listeners;
-        if (notificationSP >= NOTIFICATION_STACK_SIZE)
-            throw cRuntimeError(this, "emit(): Recursive notification stack overflow, signalID=%d", signalID);
-
-        int oldNotificationSP = notificationSP;
-        try {
-            notificationStack[notificationSP++] = listeners;  // lock against modification
-            for (int i = 0; listeners[i]; i++)
-                listeners[i]->receiveSignal(source, signalID, x, details);  // will crash if listener is already deleted
-            notificationSP--;
-        }
-        catch (std::exception& e) {
-            notificationSP = oldNotificationSP;
-            throw;
+    // walk up the module tree while the "effective" flag says there are listeners here or
+    // above, and only look up listener lists in components that have local listeners
+    int bitIndex = signalBitIndices[signalID];
+    for (cComponent *component = this; component != nullptr; ) {
+        // notify local listeners if there are any
+        SignalListenerList *listenerList = component->signalFlags->local.test(bitIndex) ? component->findListenerList(signalID) : nullptr;
+        if (listenerList) {
+            cIListener **listeners = listenerList->listeners;
+            if (notificationSP >= NOTIFICATION_STACK_SIZE)
+                throw cRuntimeError(component, "emit(): Recursive notification stack overflow, signalID=%d", signalID);
+
+            int oldNotificationSP = notificationSP;
+            try {
+                notificationStack[notificationSP++] = listeners;  // lock against modification
+                for (int i = 0; listeners[i]; i++)
+                    listeners[i]->receiveSignal(source, signalID, x, details);  // will crash if listener is already deleted
+                notificationSP--;
+            }
+            catch (std::exception& e) {
+                notificationSP = oldNotificationSP;
+                throw;
+            }
         }
-    }
 
-    // notify ancestors recursively
-    cModule *parent = getParentModule();
-    if (parent)
-        parent->fire(source, signalID, x, details);
+        // continue with the parent, unless neither it nor its ancestors have listeners
+        cModule *parent = component->getParentModule();
+        component = (parent && parent->signalFlags && parent->signalFlags->effective.test(bitIndex)) ? parent : nullptr;
+    }
 }
 
 void cComponent::fireFinish()
@@ -679,8 +757,11 @@ void cComponent::subscribe(simsignal_t signalID, cIListener *listener)
     // add to local listeners
     SignalListenerList *listenerList = findOrCreateListenerList(signalID);
     checkNotFiring(signalID, listenerList->listeners);
+    bool hadListener = listenerList->hasListener();
     if (!listenerList->addListener(listener))
         throw cRuntimeError(this, "subscribe(): Listener already subscribed at this component to signal '%s' (id=%d)", getSignalName(signalID), signalID);
+    if (!hadListener)
+        setLocalSignalFlag(signalID, true);
     signalListenerCounts[signalID]++;
     listener->subscriptions.push_back(std::pair<cComponent*,simsignal_t>(this,signalID));
     listener->subscribedTo(this, signalID);
@@ -700,8 +781,10 @@ void cComponent::unsubscribe(simsignal_t signalID, cIListener *listener)
     if (!listenerList->removeListener(listener))
         return;  // was already removed
 
-    if (!listenerList->hasListener())
+    if (!listenerList->hasListener()) {
         removeListenerList(signalID);
+        setLocalSignalFlag(signalID, false);
+    }
 
     signalListenerCounts[signalID]--;
     ASSERT(signalListenerCounts[signalID] >= 0);
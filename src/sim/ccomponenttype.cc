@@ -84,10 +84,7 @@ cComponentType::cComponentType(const char *qname) : cNoncopyableOwnedObject(qnam
 
 cComponentType::~cComponentType()
 {
-    for (auto & it : sharedParMap)
-        delete it.second;
-    for (auto it : sharedParSet)
-        delete it;
+    clearSharedParImpls();
 }
 
 cComponentType *cComponentType::find(const char *qname)
@@ -137,6 +134,16 @@ void cComponentType::putSharedParImpl(cParImpl *value)
     sharedParSet.insert(value);
 }
 
+void cComponentType::clearSharedParImpls()
+{
+    for (auto & it : sharedParMap)
+        delete it.second;
+    sharedParMap.clear();
+    for (auto it : sharedParSet)
+        delete it;
+    sharedParSet.clear();
+}
+
 bool cComponentType::isAvailable()
 {
     if (!availabilityTested) {
@@ -0,0 +1,374 @@
+//=========================================================================
+//  CDARYEVENTHEAP.CC - part of
+//
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//   Member functions of
+//    cDaryEventHeap : future event set, implemented as 4-ary heap
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <algorithm>
+#include <sstream>
+#include "omnetpp/globals.h"
+#include "omnetpp/cmessage.h"
+#include "omnetpp/csimulation.h"
+#include "omnetpp/cdaryeventheap.h"
+
+namespace omnetpp {
+
+Register_Class(cDaryEventHeap);
+
+#define CBHEAPINDEX(i)    (-2-(i))
+#define CBINC(i)          ((i) = ((i)+1)&(cbsize-1))
+#define CBDEC(i)          ((i) = ((i)-1)&(cbsize-1))
+
+#define ARITY             4
+#define PARENT(i)         (((i)-1)/ARITY)
+#define FIRSTCHILD(i)     (ARITY*(i)+1)
+
+#define ORDER_BITS        48
+#define ORDER_MASK        ((((uint64_t)1) << ORDER_BITS) - 1)
+
+//----
+
+cDaryEventHeap::cDaryEventHeap(const char *name, int intialCapacity) : cFutureEventSet(name)
+{
+    insertCount = 0;
+
+    heapLength = 0;
+    heapCapacity = intialCapacity;
+    heap = new Entry[heapCapacity];
+
+    cbsize = 4;  // must be power of 2!
+    cb = new cEvent *[cbsize];
+    cbhead = cbtail = 0;
+}
+
+cDaryEventHeap::cDaryEventHeap(const cDaryEventHeap& other) : cFutureEventSet(other)
+{
+    cb = nullptr;
+    heap = nullptr;
+    heapLength = 0;
+    copy(other);
+}
+
+cDaryEventHeap::~cDaryEventHeap()
+{
+    clear();
+    delete[] heap;
+    delete[] cb;
+}
+
+std::string cDaryEventHeap::str() const
+{
+    if (isEmpty())
+        return std::string("empty");
+    std::stringstream out;
+    out << "length=" << getLength();
+    return out.str();
+}
+
+void cDaryEventHeap::forEachChild(cVisitor *v)
+{
+    sort();
+
+    for (int i = cbhead; i != cbtail; CBINC(i))
+        v->visit(cb[i]);
+
+    for (int i = 0; i < heapLength; i++)
+        v->visit(heap[i].event);
+}
+
+void cDaryEventHeap::clear()
+{
+    for (int i = cbhead; i != cbtail; CBINC(i))
+        dropAndDelete(cb[i]);
+    cbhead = cbtail = 0;
+
+    for (int i = 0; i < heapLength; i++)
+        dropAndDelete(heap[i].event);
+    heapLength = 0;
+}
+
+void cDaryEventHeap::copy(const cDaryEventHeap& other)
+{
+    insertCount = other.insertCount;
+
+    // copy heap
+    heapLength = other.heapLength;
+    heapCapacity = other.heapCapacity;
+    delete[] heap;
+    heap = new Entry[heapCapacity];
+    for (int i = 0; i < heapLength; i++) {
+        heap[i] = other.heap[i];
+        cEvent *event = other.heap[i].event->dup();
+        event->insertOrder = other.heap[i].event->insertOrder;
+        event->heapIndex = i;
+        take(heap[i].event = event);
+    }
+
+    // copy circular buffer
+    cbhead = other.cbhead;
+    cbtail = other.cbtail;
+    cbsize = other.cbsize;
+    delete[] cb;
+    cb = new cEvent *[cbsize];
+    for (int i = cbhead; i != cbtail; CBINC(i)) {
+        cEvent *event = other.cb[i]->dup();
+        event->insertOrder = other.cb[i]->insertOrder;
+        event->heapIndex = CBHEAPINDEX(i);
+        take(cb[i] = event);
+    }
+}
+
+cDaryEventHeap& cDaryEventHeap::operator=(const cDaryEventHeap& other)
+{
+    if (this == &other)
+        return *this;
+    cFutureEventSet::operator=(other);
+    clear();
+    copy(other);
+    return *this;
+}
+
+cEvent *cDaryEventHeap::get(int k)
+{
+    if (k < 0)
+        return nullptr;
+
+    // first few elements map into the circular buffer
+    int cblen = cblength();
+    if (k < cblen)
+        return cb[(cbhead+k) & (cbsize-1)];
+    k -= cblen;
+
+    // map the rest to the heap
+    if (k >= heapLength)
+        return nullptr;
+    return heap[k].event;
+}
+
+void cDaryEventHeap::sort()
+{
+    // note: a sorted array is also a valid heap
+    std::sort(heap, heap + heapLength);
+    for (int i = 0; i < heapLength; i++)
+        heap[i].event->heapIndex = i;
+}
+
+cDaryEventHeap::Entry cDaryEventHeap::makeEntry(cEvent *event) const
+{
+    Entry entry;
+    entry.time = event->getArrivalTime().raw();
+    entry.order = ((uint64_t)(event->getSchedulingPriority() + 32768) << ORDER_BITS) | (uint64_t)event->insertOrder;
+    entry.event = event;
+    return entry;
+}
+
+void cDaryEventHeap::renumber()
+{
+    // insertion order ran out of bits: renumber all events, keeping their order
+    sort();
+    eventnumber_t count = 0;
+    for (int i = cbhead; i != cbtail; CBINC(i))
+        cb[i]->insertOrder = count++;
+    for (int i = 0; i < heapLength; i++) {
+        heap[i].event->insertOrder = count++;
+        heap[i].order = makeEntry(heap[i].event).order;
+    }
+    insertCount = count;
+}
+
+void cDaryEventHeap::insert(cEvent *event)
+{
+    take(event);
+
+    if ((uint64_t)insertCount > ORDER_MASK)
+        renumber();
+    event->insertOrder = insertCount++;
+
+    // is event eligible for putting it into the cb?
+    bool eligible = false;
+    simtime_t now = simTime();
+    if (event->getArrivalTime() == now) {
+        ASSERT(cbhead == cbtail || cb[cbhead]->getArrivalTime() == now); // causality violation
+        if (event->getSchedulingPriority() == 0) {
+            if (heapLength == 0 || heap[0].time > now.raw())
+                eligible = true;
+        }
+        else if (event->getSchedulingPriority() < 0)
+            flushCb();  // move all events into the heap
+    }
+
+    if (eligible)
+        cbInsert(event);
+    else
+        heapInsert(event);
+}
+
+void cDaryEventHeap::cbInsert(cEvent *event)
+{
+    cb[cbtail] = event;
+    event->heapIndex = CBHEAPINDEX(cbtail);
+    CBINC(cbtail);
+    if (cbtail == cbhead)
+        cbgrow();
+}
+
+void cDaryEventHeap::heapInsert(cEvent *event)
+{
+    if (heapLength == heapCapacity) {
+        heapCapacity *= 2;
+        Entry *newHeap = new Entry[heapCapacity];
+        std::copy(heap, heap + heapLength, newHeap);
+        delete[] heap;
+        heap = newHeap;
+    }
+    siftUp(heapLength++, makeEntry(event));
+}
+
+void cDaryEventHeap::siftUp(int pos, const Entry& entry)
+{
+    // move the hole at pos up until entry fits in
+    while (pos > 0) {
+        int parent = PARENT(pos);
+        if (!(entry < heap[parent]))
+            break;
+        heap[pos] = heap[parent];
+        heap[pos].event->heapIndex = pos;
+        pos = parent;
+    }
+    heap[pos] = entry;
+    entry.event->heapIndex = pos;
+}
+
+void cDaryEventHeap::siftDown(int pos, const Entry& entry)
+{
+    // move the hole at pos down until entry fits in
+    for (;;) {
+        int first = FIRSTCHILD(pos);
+        if (first >= heapLength)
+            break;
+        int last = std::min(first + ARITY, heapLength);
+        int best = first;
+        for (int child = first + 1; child < last; child++)
+            if (heap[child] < heap[best])
+                best = child;
+        if (!(heap[best] < entry))
+            break;
+        heap[pos] = heap[best];
+        heap[pos].event->heapIndex = pos;
+        pos = best;
+    }
+    heap[pos] = entry;
+    entry.event->heapIndex = pos;
+}
+
+void cDaryEventHeap::cbgrow()
+{
+    int newsize = 2*cbsize;  // cbsize MUST be power of 2
+    cEvent **newcb = new cEvent *[newsize];
+    for (int i = 0; i < cbsize; i++)
+        (newcb[i] = cb[(cbhead+i)&(cbsize-1)])->heapIndex = CBHEAPINDEX(i);
+    delete[] cb;
+
+    cb = newcb;
+    cbhead = 0;
+    cbtail = cbsize;
+    cbsize = newsize;
+}
+
+void cDaryEventHeap::flushCb()
+{
+    for (int i = cbhead; i != cbtail; CBINC(i))
+        heapInsert(cb[i]);
+    cbtail = cbhead;
+}
+
+cEvent *cDaryEventHeap::peekFirst() const
+{
+    return cbhead != cbtail ? cb[cbhead] : heapLength != 0 ? heap[0].event : nullptr;
+}
+
+cEvent *cDaryEventHeap::removeFirst()
+{
+    cEvent *event;
+    if (cbhead != cbtail) {
+        // remove head element from circular buffer
+        event = cb[cbhead];
+        CBINC(cbhead);
+    }
+    else if (heapLength > 0) {
+        // heap: first is taken out and replaced by the last one
+        event = heap[0].event;
+        if (--heapLength > 0)
+            siftDown(0, heap[heapLength]);
+    }
+    else
+        return nullptr;
+
+    drop(event);
+    event->heapIndex = -1;
+    return event;
+}
+
+cEvent *cDaryEventHeap::remove(cEvent *event)
+{
+    // make sure it is really on the heap
+    if (event->heapIndex == -1)
+        return nullptr;
+
+    if (event->heapIndex < 0) {
+        // event is in the circular buffer
+        int i = -event->heapIndex-2;
+        ASSERT(cb[i] == event);  // sanity check
+
+        // remove
+        int iminus1 = i;
+        CBINC(i);
+        for (  /**/; i != cbtail; iminus1 = i, CBINC(i))
+            (cb[iminus1] = cb[i])->heapIndex = CBHEAPINDEX(iminus1);
+        CBDEC(cbtail);
+    }
+    else {
+        // event is on the heap: last element will be used to fill the hole
+        int pos = event->heapIndex;
+        ASSERT(heap[pos].event == event);  // sanity check
+        if (pos != --heapLength) {
+            Entry fill = heap[heapLength];
+            if (pos > 0 && fill < heap[PARENT(pos)])
+                siftUp(pos, fill);
+            else
+                siftDown(pos, fill);
+        }
+    }
+
+    drop(event);
+    event->heapIndex = -1;
+    return event;
+}
+
+void cDaryEventHeap::putBackFirst(cEvent *event)
+{
+    take(event);
+
+    CBDEC(cbhead);
+    cb[cbhead] = event;
+    event->heapIndex = CBHEAPINDEX(cbhead);
+
+    if (cbtail == cbhead)
+        cbgrow();
+}
+
+}  // namespace omnetpp
+
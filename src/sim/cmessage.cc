@@ -37,6 +37,87 @@ Register_Class(cMessage);
 long cMessage::nextMessageId = 0;
 long cMessage::totalMsgCount = 0;
 long cMessage::liveMsgCount = 0;
+bool cMessage::poolingEnabled = false;
+
+namespace {
+
+// Per-thread free lists of memory blocks released by deleted messages, one
+// list for each block size (multiples of POOL_GRANULARITY up to POOL_MAXSIZE).
+// Blocks are obtained from the global operator new, so they can be freely
+// exchanged between the pool and the global allocator.
+struct MessagePool
+{
+    enum { POOL_GRANULARITY = 8, POOL_MAXSIZE = 2048, NUM_LISTS = POOL_MAXSIZE/POOL_GRANULARITY + 1 };
+    struct Block { Block *next; };
+    Block *freeLists[NUM_LISTS] = {};
+    int64_t numAllocations = 0;
+    int64_t numHits = 0;
+
+    static bool isPoolable(size_t size) {return size <= POOL_MAXSIZE && size % POOL_GRANULARITY == 0;}
+
+    ~MessagePool() {
+        for (Block *head : freeLists) {
+            while (head) {
+                Block *next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+        }
+    }
+
+    void *allocate(size_t size) {
+        numAllocations++;
+        Block *& head = freeLists[size / POOL_GRANULARITY];
+        if (head == nullptr)
+            return ::operator new(size);
+        numHits++;
+        Block *block = head;
+        head = block->next;
+        return block;
+    }
+
+    void release(void *p, size_t size) {
+        Block *& head = freeLists[size / POOL_GRANULARITY];
+        Block *block = static_cast<Block *>(p);
+        block->next = head;
+        head = block;
+    }
+};
+
+thread_local MessagePool messagePool;
+
+}  // namespace
+
+void *cMessage::allocateFromPool(size_t size)
+{
+    if (poolingEnabled && MessagePool::isPoolable(size))
+        return messagePool.allocate(size);
+    return ::operator new(size);
+}
+
+void cMessage::releaseToPool(void *p, size_t size)
+{
+    if (poolingEnabled && p != nullptr && MessagePool::isPoolable(size))
+        messagePool.release(p, size);
+    else
+        ::operator delete(p);
+}
+
+int64_t cMessage::getPoolAllocationCount()
+{
+    return messagePool.numAllocations;
+}
+
+int64_t cMessage::getPoolHitCount()
+{
+    return messagePool.numHits;
+}
+
+void cMessage::resetMessageCounters()
+{
+    totalMsgCount = liveMsgCount = 0;
+    messagePool.numAllocations = messagePool.numHits = 0;
+}
 
 cMessage::cMessage(const cMessage& msg) : cEvent(msg)
 {
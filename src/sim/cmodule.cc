@@ -247,6 +247,9 @@ void cModule::insertSubmodule(cModule *mod)
         firstSubmodule = mod;
     lastSubmodule = mod;
 
+    // inherit listener flags from the new ancestors
+    mod->repairSignalFlags();
+
     // cached module getFullPath() possibly became invalid
     lastModuleFullPathModule = nullptr;
 }
@@ -286,6 +289,9 @@ void cModule::insertChannel(cChannel *channel)
     if (!firstChannel)
         firstChannel = channel;
     lastChannel = channel;
+
+    // inherit listener flags from the new ancestors
+    channel->repairSignalFlags();
 }
 
 void cModule::removeChannel(cChannel *channel)
@@ -327,8 +333,7 @@ void cModule::updateFullName()
         opp_appendindex(fullName, getIndex());
     }
 
-    if (lastModuleFullPathModule == this)
-        lastModuleFullPathModule = nullptr;  // invalidate
+    lastModuleFullPathModule = nullptr;  // invalidate (may be this module or a descendant)
 
     if (cacheFullPath)
         updateFullPathRec();
@@ -341,11 +346,12 @@ void cModule::updateFullName()
 void cModule::reassignModuleIdRec()
 {
     int oldId = getId();
-    getSimulation()->deregisterComponent(this);
-    getSimulation()->registerComponent(this);
+    cSimulation *simulation = getSimulation();  // deregisterComponent() clears it
+    simulation->deregisterComponent(this);
+    simulation->registerComponent(this);
     int newId = getId();
 
-    cFutureEventSet *fes = getSimulation()->getFES();
+    cFutureEventSet *fes = simulation->getFES();
     int fesLen = fes->getLength();
     for (int i = 0; i < fesLen; i++) {
         cEvent *event = fes->get(i);
@@ -22,6 +22,7 @@
   `license' for details on this and other legal matters.
 *--------------------------------------------------------------*/
 
+#include <algorithm>
 #include <cstring>
 #include <cstdio>
 #include <climits>
@@ -310,14 +311,16 @@ int cSimulation::registerComponent(cComponent *component)
     lastComponentId++;
 
     if (lastComponentId >= size) {
-        // vector full, grow by delta
-        cComponent **v = new cComponent *[size + delta];
+        // vector full, grow by at least delta; grow geometrically so that
+        // building large networks remains linear in the number of components
+        int newSize = size + std::max(delta, size);
+        cComponent **v = new cComponent *[newSize];
         memcpy(v, componentv, sizeof(cComponent *) * size);
-        for (int i = size; i < size + delta; i++)
+        for (int i = size; i < newSize; i++)
             v[i] = nullptr;
         delete[] componentv;
         componentv = v;
-        size += delta;
+        size = newSize;
     }
 
     int id = lastComponentId;
@@ -341,11 +344,14 @@ void cSimulation::deregisterComponent(cComponent *component)
     if (component == systemModule) {
         drop(systemModule);
         systemModule = nullptr;
+        numNetworks--;
     }
 }
 
 void cSimulation::setSystemModule(cModule *module)
 {
+    if (!systemModule && module)
+        numNetworks++;
     systemModule = module;
     take(module);
 }
@@ -497,7 +503,16 @@ void cSimulation::deleteNetwork()
 
     networkType = nullptr;
 
-    //FIXME todo delete cParImpl caches too (cParImplCache, cParImplCache2)
+    // delete the parameter values shared among the components of each type;
+    // they are no longer referenced, and would accumulate over runs otherwise.
+    // Component types are global, so this can only be done when no other
+    // simulation instance has a network whose modules still use them.
+    if (numNetworks == 0) {
+        cRegistrationList *types = componentTypes.getInstance();
+        for (int i = 0; i < types->size(); i++)
+            if (cComponentType *componentType = dynamic_cast<cComponentType *>(types->get(i)))
+                componentType->clearSharedParImpls();
+    }
     cModule::clearNamePools();
 
     getEnvir()->notifyLifecycleListeners(LF_POST_NETWORK_DELETE);
@@ -868,6 +883,7 @@ cEnvir *cSimulation::activeEnvir = &staticEnv;
 cEnvir *cSimulation::staticEnvir = &staticEnv;
 
 cSimulation *cSimulation::activeSimulation = nullptr;
+int cSimulation::numNetworks = 0;
 
 }  // namespace omnetpp
 
@@ -19,6 +19,7 @@
 #include "omnetpp/cconfiguration.h"
 #include "omnetpp/cconfigoption.h"
 #include "omnetpp/resultfilters.h"
+#include "omnetpp/onstartup.h"
 #include "common/stringtokenizer.h"
 #include "common/stringutil.h"
 #include "common/opp_ctype.h"
@@ -39,6 +40,10 @@ Register_PerObjectConfigOption(CFGID_RESULT_RECORDING_MODES, "result-recording-m
 
 typedef cStatisticBuilder::TristateBool TristateBool;
 
+std::map<cStatisticBuilder::PlanKey,cStatisticBuilder::Plan> cStatisticBuilder::plans;
+
+EXECUTE_ON_SHUTDOWN(cStatisticBuilder::clearPlans());
+
 static int search_(std::vector<std::string>& v, const char *s)
 {
     for (int i = 0; i < (int)v.size(); i++)
@@ -112,29 +117,56 @@ void cStatisticBuilder::doAddResultRecorders(cComponent *component, std::string&
 
     // collect the list of result recorders
     std::string modesOption = config->getAsString(statisticFullPath.c_str(), CFGID_RESULT_RECORDING_MODES, "");
-    std::vector<std::string> modes = extractRecorderList(modesOption.c_str(), statisticProperty);
+    // note: a property passed in with a signal may be short-lived, so its plan is not cached
+    Plan tmpPlan;
+    const Plan& plan = signal == SIMSIGNAL_NULL ? getPlan(statisticProperty, modesOption) : (tmpPlan = makePlan(statisticProperty, modesOption));
 
     // if there are result recorders, add source filters and recorders
-    if (!modes.empty()) {
-        TristateBool checkSignalDecl = parseTristateBool(statisticProperty->getValue(PROPKEY_STATISTIC_CHECKSIGNALS), "checkSignals attribute");
+    if (!plan.modes.empty()) {
         // determine source: use either the signal from the argument list, or the source= key in the @statistic property
         SignalSource source;
         if (signal == SIMSIGNAL_NULL) {
             const char *sourceSpec = opp_emptytodefault(statisticProperty->getValue(PROPKEY_STATISTIC_SOURCE, 0), statisticName);
             bool hasWarmupPeriod = getSimulation()->getWarmupPeriod() != SIMTIME_ZERO;
-            TristateBool warmupAttr = parseTristateBool(statisticProperty->getValue(PROPKEY_STATISTIC_AUTOWARMUPFILTER), "warmup attribute");
-            bool needWarmupFilter = hasWarmupPeriod && warmupAttr != TRISTATE_FALSE;
-            source = doStatisticSource(component, statisticProperty, statisticName, sourceSpec, checkSignalDecl, needWarmupFilter);
+            bool needWarmupFilter = hasWarmupPeriod && plan.warmupAttr != TRISTATE_FALSE;
+            source = doStatisticSource(component, statisticProperty, statisticName, sourceSpec, plan.checkSignalDecl, needWarmupFilter);
         }
         else {
             source = SignalSource(component, signal);
-            StatisticSourceParser::checkSignalDeclaration(component, cComponent::getSignalName(signal), checkSignalDecl);
+            StatisticSourceParser::checkSignalDeclaration(component, cComponent::getSignalName(signal), plan.checkSignalDecl);
         }
 
         // add result recorders
-        for (auto & mode : modes)
-            doResultRecorder(source, mode.c_str(), component, statisticName, statisticProperty);
+        for (int i = 0; i < (int)plan.modes.size(); i++)
+            doResultRecorder(source, plan.modes[i].c_str(), plan.recorderTypes[i], component, statisticName, statisticProperty);
+    }
+}
+
+const cStatisticBuilder::Plan& cStatisticBuilder::getPlan(cProperty *statisticProperty, const std::string& modesOption)
+{
+    PlanKey key(statisticProperty, modesOption);
+    auto it = plans.find(key);
+    if (it != plans.end())
+        return it->second;
+    return plans[key] = makePlan(statisticProperty, modesOption);  // note: makePlan() may throw
+}
+
+cStatisticBuilder::Plan cStatisticBuilder::makePlan(cProperty *statisticProperty, const std::string& modesOption)
+{
+    Plan plan;
+    plan.modes = extractRecorderList(modesOption.c_str(), statisticProperty);
+    if (!plan.modes.empty()) {
+        plan.checkSignalDecl = parseTristateBool(statisticProperty->getValue(PROPKEY_STATISTIC_CHECKSIGNALS), "checkSignals attribute");
+        plan.warmupAttr = parseTristateBool(statisticProperty->getValue(PROPKEY_STATISTIC_AUTOWARMUPFILTER), "warmup attribute");
+        for (auto& mode : plan.modes)
+            plan.recorderTypes.push_back(isIdentifier(mode.c_str()) ? cResultRecorderType::find(mode.c_str()) : nullptr);
     }
+    return plan;
+}
+
+void cStatisticBuilder::clearPlans()
+{
+    plans.clear();
 }
 
 std::vector<std::string> cStatisticBuilder::extractRecorderList(const char *modesOption, cProperty *statisticProperty)
@@ -220,13 +252,16 @@ SignalSource cStatisticBuilder::doStatisticSource(cComponent *component, cProper
     }
 }
 
-void cStatisticBuilder::doResultRecorder(const SignalSource& source, const char *recordingMode, cComponent *component, const char *statisticName, cProperty *attrsProperty)
+void cStatisticBuilder::doResultRecorder(const SignalSource& source, const char *recordingMode, cResultRecorderType *recorderType, cComponent *component, const char *statisticName, cProperty *attrsProperty)
 {
     try {
         if (isIdentifier(recordingMode)) {
-            // simple case: just a plain recorder
+            // simple case: just a plain recorder (recorderType is null if the lookup
+            // failed when the plan was made; get() reports the error)
             //TODO if disabled, don't add
-            cResultRecorder *recorder = cResultRecorderType::get(recordingMode)->create();
+            if (!recorderType)
+                recorderType = cResultRecorderType::get(recordingMode);
+            cResultRecorder *recorder = recorderType->create();
             recorder->init(component, statisticName, recordingMode, attrsProperty);
             source.subscribe(recorder);
         }
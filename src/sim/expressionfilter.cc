@@ -16,6 +16,7 @@
 #include <climits>
 #include "omnetpp/csimulation.h"
 #include "omnetpp/ccomponent.h"
+#include "omnetpp/onstartup.h"
 #include "expressionfilter.h"
 #include "common/stringpool.h"
 
@@ -56,6 +57,36 @@ std::string SignalSource::str() const
 
 //---
 
+std::map<std::string,Expression::AstNode*> StatisticExpressionCache::astCache;
+
+EXECUTE_ON_SHUTDOWN(StatisticExpressionCache::clear());
+
+Expression::ExprNode *StatisticExpressionCache::parseAndTranslate(const char *text, Expression::AstTranslator *translator)
+{
+    Expression expr;
+    Expression::AstNode *& astTree = astCache[text];
+    if (!astTree) {
+        try {
+            astTree = expr.parseToAst(text);
+        }
+        catch (std::exception&) {
+            astCache.erase(text);
+            throw;
+        }
+    }
+    Expression::ExprNode *exprTree = expr.translateToExpressionTree(astTree, translator);
+    return expr.performConstantFolding(exprTree);
+}
+
+void StatisticExpressionCache::clear()
+{
+    for (auto& entry : astCache)
+        delete entry.second;
+    astCache.clear();
+}
+
+//---
+
 ExpressionFilter::FilterInput *ExpressionFilter::find(cResultFilter *prevFilter)
 {
     if (numInputs == 1)
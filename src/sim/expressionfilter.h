@@ -17,6 +17,7 @@
 #ifndef __OMNETPP_EXPRESSIONFILTER_H
 #define __OMNETPP_EXPRESSIONFILTER_H
 
+#include <map>
 #include "common/expression.h"
 #include "common/exprnodes.h"
 #include "omnetpp/simkerneldefs.h"
@@ -43,6 +44,28 @@ struct SIM_API SignalSource
     std::string str() const;
 };
 
+/**
+ * Cache for the parsed form of the source= and record= expressions of
+ * @statistic properties. The AST only depends on the expression text, so it
+ * is parsed once and shared by all components that use the same @statistic;
+ * only the translation (which creates the filters and subscribes them to
+ * the component's signals) needs to be done for each component.
+ */
+class SIM_API StatisticExpressionCache
+{
+  private:
+    typedef omnetpp::common::Expression Expression;
+    static std::map<std::string,Expression::AstNode*> astCache;
+
+  public:
+    /**
+     * Like Expression::parseAndTranslate(), but uses the cached AST if the
+     * same text has been parsed before.
+     */
+    static Expression::ExprNode *parseAndTranslate(const char *text, Expression::AstTranslator *translator);
+    static void clear();
+};
+
 
 class SIM_API ExpressionFilter : public cResultFilter
 {
@@ -83,6 +83,24 @@ cValue *makeNedValues(cValue *&buffer, const ExprValue argv[], int argc)
     return buffer;
 }
 
+cPar& findParamFast(cComponent *component, const char *paramName, int& indexHint)
+{
+    // Parameters are looked up by name on every evaluation of a volatile
+    // parameter's expression, so remember the index where the parameter was
+    // found last time, and try it first. Components of the same type have
+    // their parameters in the same order, so the hint is usually right.
+    if (indexHint >= 0 && indexHint < component->getNumParams()) {
+        cPar& par = component->par(indexHint);
+        if (strcmp(par.getName(), paramName) == 0)
+            return par;
+    }
+    int k = component->findPar(paramName);
+    if (k < 0)
+        return component->par(paramName);  // throws
+    indexHint = k;
+    return component->par(k);
+}
+
 //----
 
 std::string NedFunctionNode::getName() const
@@ -99,12 +117,17 @@ ExprValue NedFunctionNode::evaluate(Context *context_) const
 {
     cExpression::Context *context = dynamic_cast<cExpression::Context*>(context_->simContext);
     ASSERT(context != nullptr);
+    // evaluate arguments into a buffer on the stack, to spare a heap allocation
+    // on every call (volatile parameters are evaluated on every read)
+    const int MAX_STACK_ARGS = 4;
+    cValue stackBuffer[MAX_STACK_ARGS];
     int argc = children.size();
-    std::unique_ptr<cValue[]> argv(new cValue[argc]);
+    std::unique_ptr<cValue[]> heapBuffer(argc > MAX_STACK_ARGS ? new cValue[argc] : nullptr);
+    cValue *argv = heapBuffer ? heapBuffer.get() : stackBuffer;
     int i = 0;
     for (ExprNode *child : children)
         argv[i++] = makeNedValue(child->tryEvaluate(context_));
-    return makeExprValue(nedFunction->invoke(context, argv.get(), argc));
+    return makeExprValue(nedFunction->invoke(context, argv, argc));
 }
 
 void NedFunctionNode::print(std::ostream& out, int spaciousness) const
@@ -181,7 +204,7 @@ ExprValue ParameterRef::evaluate(Context *context_) const
     if (ofThis) {
         // note: same code to do for both inSubcomponentScope=true and =false
         cComponent *component = context->component;
-        return makeExprValue(component->par(paramName.c_str()));
+        return makeExprValue(findParamFast(component, paramName.c_str(), paramIndexHint));
     }
     else {
         cComponent *component = inSubcomponentScope ? context->component->getParentModule() : context->component;
@@ -192,7 +215,7 @@ ExprValue ParameterRef::evaluate(Context *context_) const
         if (!inSubcomponentScope && component->getComponentType()->isInnerType())
             if (component->getParentModule() && component->getParentModule()->hasPar(paramName.c_str()))
                 return makeExprValue(component->getParentModule()->par(paramName.c_str()));
-        return makeExprValue(component->par(paramName.c_str()));
+        return makeExprValue(findParamFast(component, paramName.c_str(), paramIndexHint));
     }
 }
 
@@ -215,7 +238,7 @@ ExprValue SubmoduleParameterRef::evaluate(Context *context_) const
     cModule *submodule = compoundModule->getSubmodule(submoduleName.c_str());
     if (!submodule)
         throw cRuntimeError("'%s': Submodule '%s' not found", getName().c_str(), submoduleName.c_str());
-    return makeExprValue(submodule->par(paramName.c_str()));
+    return makeExprValue(findParamFast(submodule, paramName.c_str(), paramIndexHint));
 }
 
 void SubmoduleParameterRef::print(std::ostream& out, int spaciousness) const
@@ -251,7 +274,7 @@ ExprValue IndexedSubmoduleParameterRef::evaluate(Context *context_) const
     cModule *submodule = compoundModule->getSubmodule(submoduleName.c_str(), index);
     if (!submodule)
         throw cRuntimeError("'%s': Submodule '%s[%d]' not found", getName().c_str(), submoduleName.c_str(), index);
-    return makeExprValue(submodule->par(paramName.c_str())); //TODO make a copy here??? (and similar places)
+    return makeExprValue(findParamFast(submodule, paramName.c_str(), paramIndexHint)); //TODO make a copy here??? (and similar places)
 }
 
 void IndexedSubmoduleParameterRef::print(std::ostream& out, int spaciousness) const
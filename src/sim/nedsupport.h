@@ -36,6 +36,7 @@ cValue makeNedValue(const ExprValue& value);
 ExprValue makeExprValue(const cValue& value);
 ExprValue makeExprValue(const cPar& par);
 cValue *makeNedValues(cValue *&buffer, const ExprValue argv[], int argc);
+cPar& findParamFast(cComponent *component, const char *paramName, int& indexHint);
 
 class NedExpressionContext : public cExpression::Context
 {
@@ -106,6 +107,7 @@ class ParameterRef : public LeafNode
     std::string paramName;
     bool inSubcomponentScope;  // if true, operate on context module's parent
     bool ofThis; // if true, "this.ident" form
+    mutable int paramIndexHint = -1; // see findParamFast()
   protected:
     virtual ExprValue evaluate(Context *context) const override;
     virtual void print(std::ostream& out, int spaciousness) const override;
@@ -125,6 +127,7 @@ class SubmoduleParameterRef : public LeafNode
     std::string submoduleName;
     std::string paramName;
     bool inSubcomponentScope;  // if true, operate on context module's parent
+    mutable int paramIndexHint = -1; // see findParamFast()
   protected:
     virtual ExprValue evaluate(Context *context) const override;
     virtual void print(std::ostream& out, int spaciousness) const override;
@@ -144,6 +147,7 @@ class IndexedSubmoduleParameterRef : public UnaryNode
     std::string submoduleName;
     std::string paramName;
     bool inSubcomponentScope;  // if true, operate on context module's parent
+    mutable int paramIndexHint = -1; // see findParamFast()
   protected:
     virtual ExprValue evaluate(Context *context) const override;
     virtual void print(std::ostream& out, int spaciousness) const override;
@@ -507,9 +507,14 @@ void cNedNetworkBuilder::buildRecursively(cModule *modp, cNedDeclaration *decl)
 void cNedNetworkBuilder::addSubmodulesAndConnections(cModule *modp)
 {
     SubmodulesElement *submods = currentDecl->getSubmodulesElement();
-    if (submods)
-        for (SubmoduleElement *submod = submods->getFirstSubmoduleChild(); submod; submod = submod->getNextSubmoduleSibling())
-            addSubmodule(modp, submod);
+    if (submods) {
+        for (SubmoduleElement *submod = submods->getFirstSubmoduleChild(); submod; submod = submod->getNextSubmoduleSibling()) {
+            if (graph)
+                addSubmoduleToGraph(modp, submod);
+            else
+                addSubmodule(modp, submod);
+        }
+    }
 
 
     // loop through connections and add them
@@ -842,6 +847,131 @@ void cNedNetworkBuilder::addSubmodule(cModule *compoundModule, SubmoduleElement
     // on this level too.
 }
 
+void cNedNetworkBuilder::extractSubmoduleGraph(cModule *modp, cNedDeclaration *decl, SubmoduleGraph& outGraph)
+{
+    // walk the same code path as buildInside(), but in "graph" mode
+    graph = &outGraph;
+    graphNodeIndex.clear();
+    submodMap.clear();
+    try {
+        buildRecursively(modp, decl);
+    }
+    catch (std::exception& e) {
+        graph = nullptr;
+        throw;
+    }
+    graph = nullptr;
+}
+
+void cNedNetworkBuilder::addSubmoduleToGraph(cModule *compoundModule, SubmoduleElement *submod)
+{
+    // this mirrors addSubmodule(), except that nothing gets created
+    if (getBooleanProperty(submod, "dynamic"))
+        return;
+
+    const char *submodName = submod->getName();
+    ExprRef vectorSizeExpr(submod, SubmoduleElement::ATT_VECTOR_SIZE);
+    ConditionElement *condition = submod->getFirstConditionChild();
+    const char *baseDirectory = compoundModule->getComponentType()->getSourceFileDirectory();
+
+    if (vectorSizeExpr.empty()) {
+        if (condition) {
+            try {
+                std::string submodTypeName = getSubmoduleTypeName(compoundModule, submod);
+                ExprRef conditionExpr(condition, ConditionElement::ATT_CONDITION);
+                NedExpressionContext context(compoundModule, baseDirectory, NedExpressionContext::SUBMODULE_CONDITION, submodTypeName.c_str());
+                if (evaluateAsBool(conditionExpr, &context, false) == false)
+                    return;
+            }
+            catch (std::exception& e) {
+                updateOrRethrowException(e, submod);
+                throw;
+            }
+        }
+        graphNodeIndex[submodName] = graph->nodes.size();
+        graph->nodes.push_back(submodName);
+    }
+    else {
+        if (condition) {
+            ExprRef conditionExpr(condition, ConditionElement::ATT_CONDITION);
+            NedExpressionContext context(compoundModule, baseDirectory, NedExpressionContext::SUBMODULE_ARRAY_CONDITION, nullptr);
+            if (evaluateAsBool(conditionExpr, &context, false) == false)
+                return;
+        }
+        int vectorsize = (int)evaluateAsLong(vectorSizeExpr, compoundModule, false);
+        for (int i = 0; i < vectorsize; i++) {
+            std::string submodFullName = opp_stringf("%s[%d]", submodName, i);
+            graphNodeIndex[submodFullName] = graph->nodes.size();
+            graph->nodes.push_back(submodFullName);
+        }
+    }
+}
+
+void cNedNetworkBuilder::addConnectionToGraph(cModule *modp, ConnectionElement *conn)
+{
+    ExprRef srcModuleIndexExpr(conn, ConnectionElement::ATT_SRC_MODULE_INDEX);
+    ExprRef destModuleIndexExpr(conn, ConnectionElement::ATT_DEST_MODULE_INDEX);
+    int srcNode = resolveGraphNode(modp, conn->getSrcModule(), srcModuleIndexExpr);
+    int destNode = resolveGraphNode(modp, conn->getDestModule(), destModuleIndexExpr);
+    if (srcNode == -1 || destNode == -1)
+        return;  // connection to the compound module's own gate
+
+    double delay = getConnectionDelay(modp, conn);
+    graph->connections.push_back(SubmoduleGraph::Connection {srcNode, destNode, delay});
+    if (conn->getIsBidirectional())
+        graph->connections.push_back(SubmoduleGraph::Connection {destNode, srcNode, delay});
+}
+
+int cNedNetworkBuilder::resolveGraphNode(cModule *modp, const char *moduleName, const ExprRef& moduleIndexExpr)
+{
+    if (opp_isempty(moduleName))
+        return -1;
+    std::string submodFullName = moduleName;
+    if (!moduleIndexExpr.empty())
+        submodFullName += opp_stringf("[%d]", (int)evaluateAsLong(moduleIndexExpr, modp, false));
+    auto it = graphNodeIndex.find(submodFullName);
+    if (it == graphNodeIndex.end())
+        throw cRuntimeError(modp, "No submodule '%s' to be connected", submodFullName.c_str());
+    return it->second;
+}
+
+double cNedNetworkBuilder::getConnectionDelay(cModule *modp, ConnectionElement *conn)
+{
+    // a connection without channel spec has no delay
+    ParametersElement *channelParams = conn->getFirstParametersChild();
+    if (opp_isempty(conn->getName()) && opp_isempty(conn->getType()) && opp_isempty(conn->getLikeType()) && !channelParams)
+        return 0;
+
+    // otherwise we can only tell if the delay is assigned in the connection
+    // itself, and not as a default that the configuration may override
+    ParamElement *delayParam = nullptr;
+    if (channelParams)
+        for (ParamElement *param = channelParams->getFirstParamChild(); param; param = param->getNextParamSibling())
+            if (!param->getIsPattern() && strcmp(param->getName(), "delay") == 0)
+                delayParam = param;
+    if (!delayParam || delayParam->getIsDefault())
+        return -1;
+    ExprRef valueExpr(delayParam, ParamElement::ATT_VALUE);
+    if (valueExpr.empty())
+        return -1;
+
+    // only a constant is used; anything else is left unevaluated, because
+    // it may refer to the channel itself (which does not exist yet), or draw
+    // random numbers that belong to the actual network setup
+    try {
+        cDynamicExpression expr;
+        expr.parseNedExpr(valueExpr.getExprText(), true, false);
+        if (!expr.isAConstant())
+            return -1;
+        cExpression::Context context(modp, delayParam->getSourceFileDirectory());
+        return expr.doubleValue(&context, "s");
+    }
+    catch (std::exception& e) {
+        updateOrRethrowException(e, delayParam);
+        throw;
+    }
+}
+
 void cNedNetworkBuilder::assignSubcomponentParams(cComponent *subcomponent, NedElement *subcomponentNode)
 {
     ParametersElement *paramsNode = (ParametersElement *)subcomponentNode->getFirstChildWithTag(NED_PARAMETERS);
@@ -933,7 +1063,10 @@ void cNedNetworkBuilder::doAddConnection(cModule *modp, ConnectionElement *conn)
 {
 // FIXME spurious error message comes when trying to connect INOUT gate with "-->"
     try {
-        if (!conn->getIsBidirectional()) {
+        if (graph) {
+            addConnectionToGraph(modp, conn);
+        }
+        else if (!conn->getIsBidirectional()) {
             // find gates and create connection
             ExprRef srcModuleIndexExpr(conn, ConnectionElement::ATT_SRC_MODULE_INDEX);
             ExprRef srcGateIndexExpr(conn, ConnectionElement::ATT_SRC_GATE_INDEX);
@@ -45,6 +45,20 @@ class cChannel;
  */
 class SIM_API cNedNetworkBuilder
 {
+  public:
+    /**
+     * The submodules of a compound module and the connections among them,
+     * as declared in NED. Filled in by extractSubmoduleGraph().
+     */
+    struct SubmoduleGraph {
+        struct Connection {
+            int srcNode, destNode;  // indices into nodes[]
+            double delay;           // in seconds; negative if cannot be determined from the NED connection
+        };
+        std::vector<std::string> nodes;  // submodule full names, e.g. "host[3]"
+        std::vector<Connection> connections;
+    };
+
   protected:
     class ComponentTypeNames : public NedResourceCache::INedTypeNames {
       public:
@@ -66,6 +80,11 @@ class SIM_API cNedNetworkBuilder
     typedef std::map<std::string,ModulePtrVector> SubmodMap;
     SubmodMap submodMap;
 
+    // if not nullptr, we are only collecting submodules and connections into
+    // this graph, without creating anything; see extractSubmoduleGraph()
+    SubmoduleGraph *graph = nullptr;
+    std::map<std::string,int> graphNodeIndex;
+
   protected:
     cModule *_submodule(cModule *parentmodp, const char *submodName, int idx=-1);
     void addSubmodulesAndConnections(cModule *modp);
@@ -92,6 +111,10 @@ class SIM_API cNedNetworkBuilder
     void doGateSize(cModule *component, GateElement *gateNode, bool isSubcomponent);
     void assignSubcomponentParams(cComponent *subcomponent, NedElement *subcomponentNode);
     void setupSubmoduleGateVectors(cModule *submodule, NedElement *submoduleNode);
+    void addSubmoduleToGraph(cModule *modp, SubmoduleElement *submod);
+    void addConnectionToGraph(cModule *modp, ConnectionElement *conn);
+    int resolveGraphNode(cModule *modp, const char *moduleName, const ExprRef& moduleIndexExpr);
+    double getConnectionDelay(cModule *modp, ConnectionElement *conn);
 
     void addConnectionOrConnectionGroup(cModule *modp, NedElement *connOrConnGroup);
     void doConnOrConnGroupBody(cModule *modp, NedElement *connOrConnGroup, NedElement *loopOrCondition);
@@ -150,6 +173,16 @@ class SIM_API cNedNetworkBuilder
      * passed NedElement tree. Invoked from cDynamicModule.
      */
     void buildInside(cModule *module, cNedDeclaration *decl);
+
+    /**
+     * Collects the submodules and connections that buildInside() would create
+     * in the given compound module, without actually creating them. Submodule
+     * vector sizes, conditions and connection loops are evaluated in the
+     * context of the module, so they must not refer to parameters of the
+     * submodules. Connections to the module's own gates are not included.
+     * Used for the automatic partitioning of networks for parallel simulation.
+     */
+    void extractSubmoduleGraph(cModule *module, cNedDeclaration *decl, SubmoduleGraph& graph);
 };
 
 }  // namespace omnetpp
@@ -38,7 +38,8 @@ class SIM_API cCommBufferBase : public cCommBuffer
     int mPosition;    // current position in buffer for unpacking
 
   protected:
-    void extendBufferFor(int dataSize);
+    void extendBufferFor(int dataSize) {if (mMsgSize+dataSize >= mBufferSize) growBufferFor(dataSize);}
+    void growBufferFor(int dataSize);
 
   public:
     /**
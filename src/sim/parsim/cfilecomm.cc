@@ -149,7 +149,8 @@ bool cFileCommunications::receiveNonblocking(int filtTag, cCommBuffer *buffer, i
         sprintf(fmask, "%s#*-s*-d%d-t%d.msg", commDirPrefix.buffer(), myProcId, filtTag);
 
     bool ret = false;
-    const char *fname = FileGlobber(fmask).getNext();
+    FileGlobber globber(fmask);  // owns the returned file name
+    const char *fname = globber.getNext();
     if (fname) {
         ret = true;
 
@@ -44,6 +44,7 @@ Register_Class(cNullMessageProtocol);
 
 Register_GlobalConfigOption(CFGID_PARSIM_NULLMESSAGEPROTOCOL_LOOKAHEAD_CLASS, "parsim-nullmessageprotocol-lookahead-class", CFG_STRING, "cLinkDelayLookahead", "When `cNullMessageProtocol` is selected as parsim synchronization class: specifies the C++ class that calculates lookahead. The class should subclass from `cNMPLookahead`.");
 Register_GlobalConfigOption(CFGID_PARSIM_NULLMESSAGEPROTOCOL_LAZINESS, "parsim-nullmessageprotocol-laziness", CFG_DOUBLE, "0.5", "When `cNullMessageProtocol` is selected as parsim synchronization class: specifies the laziness of sending null messages. Values in the range `[0,1)` are accepted. Laziness=0 causes null messages to be sent out immediately as a new EOT is learned, which may result in excessive null message traffic.");
+Register_GlobalConfigOption(CFGID_PARSIM_NULLMESSAGEPROTOCOL_NEXT_EVENT_EOT, "parsim-nullmessageprotocol-next-event-eot", CFG_BOOL, "false", "When `cNullMessageProtocol` is selected as parsim synchronization class: if enabled, null messages carry an EOT computed from the earliest time an event may still occur in the partition (the next local event or the earliest input time, whichever is smaller) instead of the current simulation time. This greatly reduces null message traffic when the lookahead is small compared to the time between events. The lookahead must not depend on the simulation time.");
 extern cConfigOption *CFGID_PARSIM_DEBUG;  // registered in cparsimpartition.cc
 
 cNullMessageProtocol::cNullMessageProtocol() : cParsimProtocolBase()
@@ -57,13 +58,12 @@ cNullMessageProtocol::cNullMessageProtocol() : cParsimProtocolBase()
     if (!lookaheadcalc) \
         throw cRuntimeError("Class \"%s\" is not subclassed from cNMPLookahead", lookhClass.c_str());
     laziness = getEnvir()->getConfig()->getAsDouble(CFGID_PARSIM_NULLMESSAGEPROTOCOL_LAZINESS);
+    nextEventEot = getEnvir()->getConfig()->getAsBool(CFGID_PARSIM_NULLMESSAGEPROTOCOL_NEXT_EVENT_EOT);
 }
 
 cNullMessageProtocol::~cNullMessageProtocol()
 {
     delete lookaheadcalc;
-
-    // segInfo[*].eitEvent/eotEvent messages already deleted with getFES()->clear()
     delete[] segInfo;
 }
 
@@ -83,41 +83,16 @@ void cNullMessageProtocol::startRun()
     segInfo = new PartitionInfo[numSeg];
     int myProcId = comm->getProcId();
 
-    char buf[30];
-    int i;
-
-    // temporarily initialize everything to zero.
-    for (i = 0; i < numSeg; i++) {
-        segInfo[i].eotEvent = nullptr;
-        segInfo[i].eitEvent = nullptr;
-        segInfo[i].lastEotSent = 0.0;
-    }
-
-    // Note boot sequence: first we have to schedule all "resend-EOT" events,
-    // so that the simulation will start by sending out null messages --
-    // otherwise we'd end up sitting blocked on an EIT event forever!
-
-    // create "resend-EOT" events and schedule them to zero (1st thing to do)
-    EV << "  scheduling 'resend-EOT' events...\n";
-    for (i = 0; i < numSeg; i++) {
-        if (i != myProcId) {
-            sprintf(buf, "resendEOT-%d", i);
-            cMessage *eotMsg = new cMessage(buf, MK_PARSIM_RESENDEOT);
-            eotMsg->setContextPointer((void *)(uintptr_t)i);  // khmm...
-            segInfo[i].eotEvent = eotMsg;
-            rescheduleEvent(eotMsg, 0.0);
-        }
-    }
-
-    // create EIT events and schedule them to zero (null msgs will bump them)
-    EV << "  scheduling 'EIT' events...\n";
-    for (i = 0; i < numSeg; i++) {
-        if (i != myProcId) {
-            sprintf(buf, "EIT-%d", i);
-            cMessage *eitMsg = new cMessage(buf, MK_PARSIM_EIT);
-            segInfo[i].eitEvent = eitMsg;
-            rescheduleEvent(eitMsg, 0.0);
-        }
+    // Note boot sequence: null messages are due at zero, and take precedence
+    // over EITs (see takeNextEvent()), so that the simulation will start by
+    // sending out null messages -- otherwise we'd end up sitting blocked on
+    // an EIT forever! EITs start at zero too (null msgs will bump them).
+    // Our own partition never sends or receives null messages.
+    for (int i = 0; i < numSeg; i++) {
+        bool isOther = i != myProcId;
+        segInfo[i].eit = isOther ? SIMTIME_ZERO : SIMTIME_MAX;
+        segInfo[i].eotResendTime = isOther ? SIMTIME_ZERO : SIMTIME_MAX;
+        segInfo[i].lastEotSent = SIMTIME_ZERO;
     }
 
     // start lookahead calculator too
@@ -148,7 +123,7 @@ void cNullMessageProtocol::processOutgoingMessage(cMessage *msg, const SendOptio
         // update "resend-EOT" timer
         segInfo[destProcId].lastEotSent = eot;
         simtime_t eotResendTime = sim->getSimTime() + lookahead*laziness;
-        rescheduleEvent(segInfo[destProcId].eotEvent, eotResendTime);
+        segInfo[destProcId].eotResendTime = eotResendTime;
 
         {if (debug) EV << "piggybacking null msg on '" << msg->getName() << "' to " << destProcId << ", lookahead=" << lookahead << ", EOT=" << eot << "; next resend at " << eotResendTime << "\n";}
 
@@ -217,25 +192,16 @@ void cNullMessageProtocol::processReceivedBuffer(cCommBuffer *buffer, int tag, i
 
 void cNullMessageProtocol::processReceivedEIT(int sourceProcId, simtime_t eit)
 {
-    cMessage *eitMsg = segInfo[sourceProcId].eitEvent;
-
-    {if (debug) EV << "null msg received from " << sourceProcId << ", EIT=" << eit << ", rescheduling EIT event\n";}
+    {if (debug) EV << "null msg received from " << sourceProcId << ", EIT=" << eit << "\n";}
 
     // sanity check
-    ASSERT(eit > eitMsg->getArrivalTime());
+    ASSERT(eit > segInfo[sourceProcId].eit);
 
-    // reschedule it to the EIT just received
-    rescheduleEvent(eitMsg, eit);
+    segInfo[sourceProcId].eit = eit;
 }
 
 cEvent *cNullMessageProtocol::takeNextEvent()
 {
-    // our EIT and resendEOT messages are always scheduled, so the FES can
-    // only be empty if there are no other partitions at all -- "no events" then
-    // means we're finished.
-    if (sim->getFES()->isEmpty())
-        return nullptr;
-
     // we could do a receiveNonblocking() call here to look at our mailbox,
     // but for performance reasons we don't -- it's enough to read it
     // (receiveBlocking()) when we're stuck on an EIT. Or should we do it
@@ -243,21 +209,29 @@ cEvent *cNullMessageProtocol::takeNextEvent()
     // deadlock.
     // receiveNonblocking();
 
+    cFutureEventSet *fes = sim->getFES();
     cEvent *event;
     while (true) {
-        event = sim->getFES()->peekFirst();
-        cMessage *msg = event->isMessage() ? static_cast<cMessage *>(event) : nullptr;
-        if (msg && msg->getKind() == MK_PARSIM_RESENDEOT) {
+        event = fes->peekFirst();
+        simtime_t eventTime = event ? event->getArrivalTime() : SIMTIME_MAX;
+        int eotProcId = getMinEotResendPartition();
+        int eitProcId = getMinEitPartition();
+        simtime_t eotResendTime = eotProcId == -1 ? SIMTIME_MAX : segInfo[eotProcId].eotResendTime;
+        simtime_t eit = eitProcId == -1 ? SIMTIME_MAX : segInfo[eitProcId].eit;
+        if (eotProcId != -1 && eotResendTime <= eventTime && eotResendTime <= eit) {
             // send null messages if window closed for a partition
-            int procId = (uintptr_t)msg->getContextPointer();  // khmm...
-            sendNullMessage(procId, event->getArrivalTime());
+            sendNullMessage(eotProcId, eotResendTime);
         }
-        else if (msg && msg->getKind() == MK_PARSIM_EIT) {
+        else if (eitProcId != -1 && eit < eventTime) {
             // wait until it gets out of the way (i.e. we get a higher EIT)
-            {if (debug) EV << "blocking on EIT event '" << event->getName() << "'\n";}
+            {if (debug) EV << "blocking on EIT from " << eitProcId << ", EIT=" << eit << "\n";}
             if (!receiveBlocking())
                 return nullptr;
         }
+        else if (!event) {
+            // no events, and no other partitions -- we're finished
+            return nullptr;
+        }
         else {
             // just a normal event -- go ahead with it
             break;
@@ -265,7 +239,7 @@ cEvent *cNullMessageProtocol::takeNextEvent()
     }
 
     // remove event from FES and return it
-    cEvent *tmp = sim->getFES()->removeFirst();
+    cEvent *tmp = fes->removeFirst();
     ASSERT(tmp == event);
     return event;
 }
@@ -276,23 +250,61 @@ void cNullMessageProtocol::putBackEvent(cEvent *event)
                         "cannot be used with this scheduler (putBackEvent() not implemented)");
 }
 
+simtime_t cNullMessageProtocol::getEarliestEventTime()
+{
+    // No event can occur in this partition before the first event in the FES,
+    // or before a message arrives from another partition (i.e. the smallest EIT)
+    int eitProcId = getMinEitPartition();
+    simtime_t minEit = eitProcId == -1 ? SIMTIME_MAX : segInfo[eitProcId].eit;
+    cEvent *first = sim->getFES()->peekFirst();
+    return first ? std::min(first->getArrivalTime(), minEit) : minEit;
+}
+
+int cNullMessageProtocol::getMinEitPartition()
+{
+    int procId = -1;
+    for (int i = 0; i < numSeg; i++)
+        if (segInfo[i].eit != SIMTIME_MAX && (procId == -1 || segInfo[i].eit < segInfo[procId].eit))
+            procId = i;
+    return procId;
+}
+
+int cNullMessageProtocol::getMinEotResendPartition()
+{
+    int procId = -1;
+    for (int i = 0; i < numSeg; i++)
+        if (segInfo[i].eotResendTime != SIMTIME_MAX && (procId == -1 || segInfo[i].eotResendTime < segInfo[procId].eotResendTime))
+            procId = i;
+    return procId;
+}
+
 void cNullMessageProtocol::sendNullMessage(int procId, simtime_t now)
 {
-    // calculate EOT and sending of next null message
+    // calculate EOT and sending of next null message; with nextEventEot,
+    // the EOT is based on the earliest time we may send anything at all
     simtime_t lookahead = lookaheadcalc->getCurrentLookahead(procId);
-    simtime_t eot = now + lookahead;
+    simtime_t base = now;
+    if (nextEventEot) {
+        base = std::max(now, getEarliestEventTime());
+        if (base > SIMTIME_MAX - lookahead)
+            base = SIMTIME_MAX - lookahead;
+    }
+    simtime_t eot = base + lookahead;
+    simtime_t eotResendTime = base + lookahead*laziness;
 
     // ensure that even with eager resend, we only send out EOTs that
     // differ from previous one!
-    if (eot == segInfo[procId].lastEotSent)
+    if (eot == segInfo[procId].lastEotSent) {
+        if (nextEventEot)
+            segInfo[procId].eotResendTime = eotResendTime;  // nothing has changed since the last one
         return;
+    }
     if (eot < segInfo[procId].lastEotSent)
         throw cRuntimeError("cNullMessageProtocol error: Attempt to decrease EOT");
     segInfo[procId].lastEotSent = eot;
 
-    // calculate time of next null message sending, and schedule "resend-EOT" event
-    simtime_t eotResendTime = now + lookahead*laziness;
-    rescheduleEvent(segInfo[procId].eotEvent, eotResendTime);
+    // time of the next null message sending
+    segInfo[procId].eotResendTime = eotResendTime;
 
     {if (debug) EV << "sending null msg to " << procId << ", lookahead=" << lookahead << ", EOT=" << eot << "; next resend at " << eotResendTime << "\n";}
 
@@ -303,12 +315,5 @@ void cNullMessageProtocol::sendNullMessage(int procId, simtime_t now)
     comm->recycleCommBuffer(buffer);
 }
 
-void cNullMessageProtocol::rescheduleEvent(cMessage *msg, simtime_t t)
-{
-    sim->getFES()->remove(msg);  // also works if the event is not currently scheduled
-    msg->setArrivalTime(t);
-    sim->getFES()->insert(msg);
-}
-
 }  // namespace omnetpp
 
@@ -21,7 +21,7 @@
 #ifndef __OMNETPP_CNULLMESSAGEPROT_H
 #define __OMNETPP_CNULLMESSAGEPROT_H
 
-#include "omnetpp/cmessage.h"  // MK_PARSIM_BEGIN
+#include "omnetpp/cmessage.h"
 #include "cparsimprotocolbase.h"
 
 namespace omnetpp {
@@ -40,11 +40,13 @@ class cNMPLookahead;
 class SIM_API cNullMessageProtocol : public cParsimProtocolBase
 {
   protected:
+    // note: EIT and resend-EOT times are kept here and not as events in the
+    // FES, so that the first ordinary event is always at the front of the FES
     struct PartitionInfo
     {
-        cMessage *eitEvent;  // EIT received from partition
-        cMessage *eotEvent;  // events which marks that a null message should be sent out
-        simtime_t lastEotSent; // last EOT value that was sent
+        simtime_t eit;           // EIT received from partition
+        simtime_t eotResendTime; // when a null message should be sent out next
+        simtime_t lastEotSent;   // last EOT value that was sent
     };
 
     // partition information
@@ -54,12 +56,9 @@ class SIM_API cNullMessageProtocol : public cParsimProtocolBase
     // controls null message resend frequency, 0<=laziness<=1
     double laziness;
 
-    // internally used message kinds
-    enum
-    {
-        MK_PARSIM_EIT =       MK_PARSIM_BEGIN - 1,
-        MK_PARSIM_RESENDEOT = MK_PARSIM_BEGIN - 2
-    };
+    // whether to compute EOT from the earliest possible event time instead
+    // of the current simulation time
+    bool nextEventEot;
 
     bool debug;
 
@@ -75,8 +74,15 @@ class SIM_API cNullMessageProtocol : public cParsimProtocolBase
     // resend null message to this partition
     virtual void sendNullMessage(int procId, simtime_t now);
 
-    // reschedule event in FES, to the given time
-    virtual void rescheduleEvent(cMessage *msg, simtime_t t);
+    // the earliest time an event may occur in this partition: the smaller of
+    // the time of the first event in the FES and the smallest EIT
+    virtual simtime_t getEarliestEventTime();
+
+    // the partition with the smallest EIT (-1 if there are no other partitions)
+    virtual int getMinEitPartition();
+
+    // the partition to which a null message is due first (-1 if none)
+    virtual int getMinEotResendPartition();
 
   public:
     /**
@@ -20,28 +20,42 @@
 
 #include <cstdlib>
 #include <cstdio>
+#include <algorithm>
 #include "omnetpp/cmessage.h"
 #include "omnetpp/errmsg.h"
 #include "omnetpp/ccommbuffer.h"
 #include "omnetpp/cparsimcomm.h"
 #include "omnetpp/cenvir.h"
+#include "omnetpp/crng.h"
 #include "omnetpp/cconfiguration.h"
 #include "omnetpp/globals.h"
 #include "omnetpp/cconfigoption.h"
 #include "omnetpp/regmacros.h"
 #include "omnetpp/csimplemodule.h" // SendOptions
+#include "omnetpp/ccomponenttype.h"
+#include "common/stringutil.h"
+#include "sim/netbuilder/cnednetworkbuilder.h"
+#include "sim/netbuilder/cnedloader.h"
 #include "cplaceholdermod.h"
 #include "cproxygate.h"
 #include "cparsimpartition.h"
 #include "cparsimsynchr.h"
 #include "creceivedexception.h"
 #include "messagetags.h"
+#include "graphpartitioner.h"
 
 namespace omnetpp {
 
+using namespace omnetpp::common;
+
 Register_Class(cParsimPartition);
 
 Register_GlobalConfigOption(CFGID_PARSIM_DEBUG, "parsim-debug", CFG_BOOL, "true", "With `parallel-simulation=true`: turns on printing of log messages from the parallel simulation code.");
+Register_PerObjectConfigOption(CFGID_PARTITION_WEIGHT, "partition-weight", KIND_MODULE, CFG_DOUBLE, "1", "With parallel simulation and `partition-id=auto`: the relative amount of work (e.g. expected number of events, from a profiling run) the module represents. Automatic partitioning keeps the sum of weights balanced among partitions.");
+
+// cost of cutting a connection with zero or unknown delay (i.e. no lookahead),
+// relative to cutting one with the largest delay in the network
+#define ZERO_DELAY_CUT_COST  1000.0
 
 cParsimPartition::cParsimPartition()
 {
@@ -65,6 +79,7 @@ void cParsimPartition::setContext(cSimulation *simul, cParsimCommunications *com
 void cParsimPartition::lifecycleEvent(SimulationLifecycleEventType eventType, cObject *details)
 {
     switch (eventType) {
+        case LF_PRE_NETWORK_SETUP: autoPartitioningDone = false; autoPartitionIds.clear(); break;
         case LF_PRE_NETWORK_INITIALIZE: startRun(); break;
         case LF_ON_RUN_END: endRun(); break;
         case LF_ON_SHUTDOWN: shutdown(); break;
@@ -92,6 +107,137 @@ void cParsimPartition::shutdown()
     comm->shutdown();
 }
 
+int cParsimPartition::getAutoPartitionId(cModule *parentmod, const char *modname, int index)
+{
+    std::string fullName = index < 0 ? std::string(modname) : opp_stringf("%s[%d]", modname, index);
+    if (!parentmod || parentmod->getParentModule())
+        throw cRuntimeError("Automatic partitioning (partition-id=auto) is only supported for submodules of the network, not for '%s.%s'",
+                parentmod ? parentmod->getFullPath().c_str() : "", fullName.c_str());
+    if (!autoPartitioningDone)
+        computeAutoPartitioning(parentmod);
+    auto it = autoPartitionIds.find(fullName);
+    if (it == autoPartitionIds.end())
+        throw cRuntimeError("Automatic partitioning: Module '%s.%s' was not present at network setup, "
+                "dynamically created modules need an explicit partition-id", parentmod->getFullPath().c_str(), fullName.c_str());
+    return it->second;
+}
+
+unsigned long cParsimPartition::getNumRandomNumbersDrawn()
+{
+    unsigned long sum = 0;
+    cEnvir *envir = getEnvir();
+    for (int i = 0; i < envir->getNumRNGs(); i++)
+        sum += envir->getRNG(i)->getNumbersDrawn();
+    return sum;
+}
+
+void cParsimPartition::computeAutoPartitioning(cModule *network)
+{
+    autoPartitioningDone = true;
+    autoPartitionIds.clear();
+
+    // collect the submodules and connections of the network from its NED declaration
+    cNedDeclaration *decl = dynamic_cast<cNedDeclaration *>(cNedLoader::getInstance()->lookup(network->getComponentType()->getFullName()));
+    if (!decl)
+        throw cRuntimeError("Automatic partitioning: Network '%s' is not defined in NED", network->getComponentType()->getFullName());
+    cNedNetworkBuilder::SubmoduleGraph graph;
+    unsigned long numbersDrawn = getNumRandomNumbersDrawn();
+    try {
+        cNedNetworkBuilder().extractSubmoduleGraph(network, decl, graph);
+    }
+    catch (std::exception& e) {
+        throw cRuntimeError("Automatic partitioning: Cannot determine network topology: %s", e.what());
+    }
+
+    // the topology must be the same as the one the actual network setup will
+    // create, and extracting it must not take random numbers from the streams
+    // used by the simulation
+    if (getNumRandomNumbersDrawn() != numbersDrawn)
+        throw cRuntimeError("Automatic partitioning: The topology of network '%s' depends on random numbers "
+                "(submodule vector sizes, conditions or connection indices), this is not supported", network->getComponentType()->getFullName());
+
+    // modules with partition-id=auto take part; those with explicitly assigned partitions are left alone
+    cConfiguration *cfg = getEnvir()->getConfig();
+    cConfigOption *partitionIdOption = cConfigOption::get("partition-id");  // registered in the envir library
+    GraphPartitioner partitioner;
+    int numNodes = graph.nodes.size();
+    std::vector<int> partitionerNode(numNodes, -1);
+    std::vector<int> graphNode;
+    std::vector<double> weights;
+    for (int i = 0; i < numNodes; i++) {
+        std::string path = network->getFullPath() + "." + graph.nodes[i];
+        if (cfg->getAsString(path.c_str(), partitionIdOption, "") == "auto") {
+            double weight = cfg->getAsDouble(path.c_str(), CFGID_PARTITION_WEIGHT);
+            if (weight < 0)
+                throw cRuntimeError("Automatic partitioning: Negative %s for module '%s'", CFGID_PARTITION_WEIGHT->getName(), path.c_str());
+            partitionerNode[i] = partitioner.addNode(weight);
+            graphNode.push_back(i);
+            weights.push_back(weight);
+        }
+    }
+
+    // the cost of cutting a connection is inversely proportional to its delay
+    // (the lookahead it provides); connections of unknown delay may well have
+    // zero delay at runtime, so cutting them costs as much as if they had
+    double maxDelay = 0;
+    for (auto& conn : graph.connections)
+        maxDelay = std::max(maxDelay, conn.delay);
+    for (auto& conn : graph.connections) {
+        int node1 = partitionerNode[conn.srcNode], node2 = partitionerNode[conn.destNode];
+        if (node1 == -1 || node2 == -1)
+            continue;
+        double cost = conn.delay <= 0 ? ZERO_DELAY_CUT_COST : std::min(maxDelay / conn.delay, ZERO_DELAY_CUT_COST);
+        partitioner.addEdge(node1, node2, cost);
+    }
+
+    int numPartitions = comm->getNumPartitions();
+    std::vector<int> result = partitioner.partition(numPartitions);
+    for (int k = 0; k < (int)graphNode.size(); k++)
+        autoPartitionIds[graph.nodes[graphNode[k]]] = result[k];
+
+    // report the result: load of each partition, and lookahead across each cut
+    EV << "automatic partitioning: " << graphNode.size() << " modules into " << numPartitions << " partitions\n";
+    std::vector<int> numModules(numPartitions, 0);
+    std::vector<double> totalWeight(numPartitions, 0);
+    for (int k = 0; k < (int)graphNode.size(); k++) {
+        numModules[result[k]]++;
+        totalWeight[result[k]] += weights[k];
+    }
+    for (int p = 0; p < numPartitions; p++)
+        EV << "  partition " << p << ": " << numModules[p] << " modules, weight " << totalWeight[p] << "\n";
+
+    struct CutInfo {int numConnections = 0; int numUnknownDelay = 0; double minDelay = -1;};
+    std::map<std::pair<int,int>,CutInfo> cuts;
+    for (auto& conn : graph.connections) {
+        int node1 = partitionerNode[conn.srcNode], node2 = partitionerNode[conn.destNode];
+        if (node1 == -1 || node2 == -1 || result[node1] == result[node2])
+            continue;
+        CutInfo& cut = cuts[std::make_pair(result[node1], result[node2])];
+        cut.numConnections++;
+        if (conn.delay < 0)
+            cut.numUnknownDelay++;
+        else if (cut.minDelay < 0 || conn.delay < cut.minDelay)
+            cut.minDelay = conn.delay;
+    }
+    for (auto& it : cuts) {
+        const CutInfo& cut = it.second;
+        EV << "  partition " << it.first.first << " -> " << it.first.second << ": " << cut.numConnections << " connections, lookahead ";
+        if (cut.minDelay < 0)
+            EV << "unknown";
+        else
+            EV << (cut.numUnknownDelay > 0 ? "at most " : "") << cut.minDelay << "s";
+        if (cut.numUnknownDelay > 0)
+            EV << " (delay of " << cut.numUnknownDelay << " connections not known at network setup)";
+        EV << "\n";
+    }
+
+    if (debug) {
+        // in ini file syntax, so that the partitioning can be made permanent
+        for (int k = 0; k < (int)graphNode.size(); k++)
+            EV << "  " << network->getFullPath() << "." << graph.nodes[graphNode[k]] << ".partition-id = " << result[k] << "\n";
+    }
+}
+
 void cParsimPartition::connectRemoteGates()
 {
     cCommBuffer *buffer = comm->createCommBuffer();
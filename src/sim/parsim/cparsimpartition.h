@@ -21,6 +21,8 @@
 #ifndef __OMNETPP_CPARSIMPARTITION_H
 #define __OMNETPP_CPARSIMPARTITION_H
 
+#include <map>
+#include <string>
 #include "omnetpp/simkerneldefs.h"
 #include "omnetpp/cobject.h"
 #include "omnetpp/simtime_t.h"
@@ -29,6 +31,7 @@
 namespace omnetpp {
 
 class cSimulation;
+class cModule;
 class cParsimSynchronizer;
 class cParsimCommunications;
 class cCommBuffer;
@@ -67,10 +70,20 @@ class SIM_API cParsimPartition : public cObject, public cISimulationLifecycleLis
     cParsimSynchronizer *synch;
     bool debug;
 
+    // automatic partitioning: partition of the network's submodules, by full name
+    bool autoPartitioningDone = false;
+    std::map<std::string,int> autoPartitionIds;
+
   protected:
     // internal: fills in remote gate addresses of all cProxyGate's in the current partition
     void connectRemoteGates();
 
+    // internal: computes autoPartitionIds
+    void computeAutoPartitioning(cModule *network);
+
+    // internal: total count of random numbers drawn from the global RNGs
+    unsigned long getNumRandomNumbersDrawn();
+
     /**
      * A cISimulationLifecycleListener method. Delegates to startRun(), endRun() and
      * shutdown(); override if needed.
@@ -109,6 +122,19 @@ class SIM_API cParsimPartition : public cObject, public cISimulationLifecycleLis
      */
     void shutdown();
 
+    /**
+     * Returns the partition of the given submodule of the network, computed
+     * by automatic partitioning. This is invoked when creating modules whose
+     * partition-id is configured as "auto". The partitioning is computed on
+     * the first call during network setup, from the submodules and connections
+     * declared in the network's NED type. Its goal is to minimize the number
+     * of connections that cross partition boundaries, preferring to cut those
+     * with larger delay, while keeping the sum of the "partition-weight" config
+     * values of modules balanced among partitions. Connections whose delay is
+     * not a constant in the connection itself count as zero-delay ones.
+     */
+    virtual int getAutoPartitionId(cModule *parentmod, const char *modname, int index);
+
     /**
      * A hook called from cProxyGate::deliver() when an outgoing cMessage
      * arrives at partition boundary. We just pass it up to the synchronization
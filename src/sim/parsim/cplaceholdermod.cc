@@ -24,6 +24,7 @@
 #include <cstdio>
 #include "cfilecomm.h"
 #include "cnamedpipecomm.h"
+#include "csharedmemorycomm.h"
 #include "cmpicomm.h"
 #include "cnosynchronization.h"
 #include "cnullmessageprot.h"
@@ -0,0 +1,442 @@
+//=========================================================================
+//  CSHAREDMEMORYCOMM.CC - part of
+//
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2003-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include "csharedmemorycomm.h"
+
+#ifndef _WIN32
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <cstring>
+#include <cerrno>
+#include <new>
+#include <atomic>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <signal.h>
+#include "omnetpp/cexception.h"
+#include "omnetpp/clog.h"
+#include "omnetpp/globals.h"
+#include "omnetpp/regmacros.h"
+#include "omnetpp/cconfigoption.h"
+#include "omnetpp/cenvir.h"
+#include "omnetpp/csimulation.h"
+#include "omnetpp/cconfiguration.h"
+#include "cmemcommbuffer.h"
+#include "parsimutil.h"
+
+namespace omnetpp {
+
+Register_Class(cSharedMemoryCommunications);
+
+Register_GlobalConfigOption(CFGID_PARSIM_SHAREDMEMORYCOMM_NAME, "parsim-sharedmemorycommunications-name", CFG_STRING, "/omnetpp-parsim", "When `cSharedMemoryCommunications` is selected as parsim communications class: the name of the POSIX shared memory object used for communication. Simulations that run concurrently on the same host must use different names.");
+Register_GlobalConfigOptionU(CFGID_PARSIM_SHAREDMEMORYCOMM_RINGSIZE, "parsim-sharedmemorycommunications-ringsize", "B", "1MiB", "When `cSharedMemoryCommunications` is selected as parsim communications class: the size of the ring buffer for each ordered pair of partitions. It is rounded up to a power of two. Messages larger than the ring are streamed through it.");
+Register_GlobalConfigOption(CFGID_PARSIM_SHAREDMEMORYCOMM_SPINCOUNT, "parsim-sharedmemorycommunications-spincount", CFG_INT, "10000", "When `cSharedMemoryCommunications` is selected as parsim communications class: the number of times a blocking receive polls the incoming rings before it starts yielding the CPU to other processes. Higher values reduce latency but waste CPU time if partitions share cores.");
+
+#define SEGMENT_MAGIC     0x4f505053  // "OPPS"
+#define CACHELINE_SIZE    64
+#define RECORD_ALIGNMENT  8
+#define ATTACH_TIMEOUT    30  // seconds
+
+struct cSharedMemoryCommunications::SegmentHeader
+{
+    std::atomic<uint32_t> magic;  // set last by the creator
+    int32_t numPartitions;
+    uint64_t ringSize;
+    int64_t creatorPid;  // to recognize segments left over from crashed runs
+    std::atomic<int32_t> numAttached;
+};
+
+// Single-producer single-consumer ring. head and tail are byte counters that
+// are never wrapped; they are in separate cache lines to avoid false sharing.
+// The ring data follows the header.
+struct cSharedMemoryCommunications::Ring
+{
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> head;  // written by the sender only
+    alignas(CACHELINE_SIZE) std::atomic<uint64_t> tail;  // written by the receiver only
+
+    char *data() {return (char *)(this + 1);}
+};
+
+// Records in the ring start at RECORD_ALIGNMENT-aligned positions, so the
+// header of a record is never split by the end of the ring.
+struct RecordHeader
+{
+    int32_t tag;
+    int32_t contentLength;
+};
+
+static inline size_t alignUp(size_t size, size_t alignment)
+{
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+static inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__ ("yield");
+#endif
+}
+
+cSharedMemoryCommunications::cSharedMemoryCommunications()
+{
+    cConfiguration *cfg = getEnvir()->getConfig();
+    segmentName = cfg->getAsString(CFGID_PARSIM_SHAREDMEMORYCOMM_NAME);
+    double size = cfg->getAsDouble(CFGID_PARSIM_SHAREDMEMORYCOMM_RINGSIZE);
+    if (size < 4096 || size > (1LL << 40))
+        throw cRuntimeError("cSharedMemoryCommunications: Ring size %g is out of range", size);
+    ringSize = 4096;
+    while (ringSize < size)
+        ringSize *= 2;
+    ringStride = sizeof(Ring) + ringSize;
+    spinCount = cfg->getAsInt(CFGID_PARSIM_SHAREDMEMORYCOMM_SPINCOUNT);
+    numPartitions = 0;
+    myProcId = -1;
+    fd = -1;
+    segment = nullptr;
+    segmentSize = 0;
+    rrBase = 0;
+}
+
+cSharedMemoryCommunications::~cSharedMemoryCommunications()
+{
+    detachSegment();
+
+    for (auto item : incoming)
+        delete item.buffer;
+    for (auto item : receivedBuffers)
+        delete item.buffer;
+}
+
+void cSharedMemoryCommunications::init(int np)
+{
+    // store parameter
+    numPartitions = np;
+
+    // get myProcId from "-p" command-line option
+    myProcId = getProcIdFromCommandLineArgs(numPartitions, "cSharedMemoryCommunications");
+
+    EV << "cSharedMemoryCommunications: started as process " << myProcId << " out of " << numPartitions << ".\n";
+
+    attachSegment();
+
+    incoming.resize(numPartitions);
+    for (auto& item : incoming)
+        item = {false, 0, 0, 0, new cMemCommBuffer()};
+}
+
+cSharedMemoryCommunications::Ring *cSharedMemoryCommunications::getRing(int source, int destination) const
+{
+    size_t offset = alignUp(sizeof(SegmentHeader), CACHELINE_SIZE) + (source * numPartitions + destination) * ringStride;
+    return (Ring *)(segment + offset);
+}
+
+void cSharedMemoryCommunications::attachSegment()
+{
+    const char *name = segmentName.c_str();
+    segmentSize = alignUp(sizeof(SegmentHeader), CACHELINE_SIZE) + (size_t)numPartitions * numPartitions * ringStride;
+    SegmentHeader *header = nullptr;
+
+    if (myProcId == 0) {
+        // create segment; remove leftover from an earlier (crashed) run first
+        EV << "cSharedMemoryCommunications: creating shared memory object '" << name << "' (" << segmentSize << " bytes)...\n";
+        shm_unlink(name);
+        fd = shm_open(name, O_CREAT|O_EXCL|O_RDWR, 0600);
+        if (fd == -1)
+            throw cRuntimeError("cSharedMemoryCommunications: Cannot create shared memory object '%s': %s", name, strerror(errno));
+        if (ftruncate(fd, segmentSize) == -1) {
+            shm_unlink(name);
+            throw cRuntimeError("cSharedMemoryCommunications: Cannot set size of shared memory object '%s': %s", name, strerror(errno));
+        }
+        void *p = mmap(nullptr, segmentSize, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            shm_unlink(name);
+            throw cRuntimeError("cSharedMemoryCommunications: Cannot map shared memory object '%s': %s", name, strerror(errno));
+        }
+        segment = (char *)p;
+
+        header = new(segment) SegmentHeader;
+        header->numPartitions = numPartitions;
+        header->ringSize = ringSize;
+        header->creatorPid = getpid();
+        header->numAttached.store(0);
+        for (int i = 0; i < numPartitions; i++) {
+            for (int j = 0; j < numPartitions; j++) {
+                Ring *ring = new(getRing(i, j)) Ring;
+                ring->head.store(0);
+                ring->tail.store(0);
+            }
+        }
+        if (!header->magic.is_lock_free() || !getRing(0, 0)->head.is_lock_free())
+            throw cRuntimeError("cSharedMemoryCommunications: Atomic operations are not lock-free on this platform");
+        header->magic.store(SEGMENT_MAGIC, std::memory_order_release);
+
+        // wait until all other partitions have attached, then remove the name
+        // (the segment itself stays until the last process unmaps it)
+        for (int k = 0; k < ATTACH_TIMEOUT*100 && header->numAttached.load(std::memory_order_acquire) < numPartitions-1; k++)
+            usleep(10000);
+        shm_unlink(name);
+        if (header->numAttached.load(std::memory_order_acquire) < numPartitions-1)
+            throw cRuntimeError("cSharedMemoryCommunications: Timeout waiting for other partitions to attach to shared memory object '%s'", name);
+    }
+    else {
+        // attach to the segment created by partition 0
+        EV << "cSharedMemoryCommunications: attaching to shared memory object '" << name << "'...\n";
+        for (int k = 0; k < ATTACH_TIMEOUT*100; k++) {
+            fd = shm_open(name, O_RDWR, 0);
+            if (fd != -1) {
+                struct stat st;
+                if (fstat(fd, &st) == 0 && (size_t)st.st_size == segmentSize) {
+                    void *p = mmap(nullptr, segmentSize, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+                    if (p == MAP_FAILED)
+                        throw cRuntimeError("cSharedMemoryCommunications: Cannot map shared memory object '%s': %s", name, strerror(errno));
+                    segment = (char *)p;
+                    header = (SegmentHeader *)segment;
+                    // a leftover segment from a crashed run is ignored: partition 0
+                    // will replace it (its creator no longer exists)
+                    if (header->magic.load(std::memory_order_acquire) == SEGMENT_MAGIC && !(kill((pid_t)header->creatorPid, 0) == -1 && errno == ESRCH))
+                        break;
+                    munmap(segment, segmentSize);
+                    segment = nullptr;
+                }
+                close(fd);
+                fd = -1;
+            }
+            usleep(10000);
+        }
+        if (!segment)
+            throw cRuntimeError("cSharedMemoryCommunications: Cannot attach to shared memory object '%s' "
+                                "(does not exist, or it was created with a different number of partitions or ring size)", name);
+        if (header->numPartitions != numPartitions || header->ringSize != ringSize)
+            throw cRuntimeError("cSharedMemoryCommunications: Shared memory object '%s' was created with different parameters", name);
+        header->numAttached.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
+
+void cSharedMemoryCommunications::detachSegment()
+{
+    if (segment)
+        munmap(segment, segmentSize);
+    if (fd != -1)
+        close(fd);
+    segment = nullptr;
+    fd = -1;
+}
+
+void cSharedMemoryCommunications::shutdown()
+{
+    detachSegment();
+}
+
+int cSharedMemoryCommunications::getNumPartitions() const
+{
+    return numPartitions;
+}
+
+int cSharedMemoryCommunications::getProcId() const
+{
+    return myProcId;
+}
+
+cCommBuffer *cSharedMemoryCommunications::createCommBuffer()
+{
+    return new cMemCommBuffer();
+}
+
+void cSharedMemoryCommunications::recycleCommBuffer(cCommBuffer *buffer)
+{
+    delete buffer;
+}
+
+void cSharedMemoryCommunications::writeBytes(Ring *ring, uint64_t& head, const void *data, size_t length)
+{
+    // copies data (or zeroes if data==nullptr) into the ring; head is only
+    // published here if the ring is full, otherwise it is left to the caller
+    const char *src = (const char *)data;
+    while (length > 0) {
+        size_t freeSpace = ringSize - (head - ring->tail.load(std::memory_order_acquire));
+        if (freeSpace == 0) {
+            ring->head.store(head, std::memory_order_release);
+            drainIncoming();  // the receiver may be waiting for space in our ring
+            sched_yield();
+            continue;
+        }
+        size_t n = std::min(freeSpace, length);
+        size_t pos = head & (ringSize - 1);
+        size_t n1 = std::min(n, ringSize - pos);
+        if (src) {
+            memcpy(ring->data() + pos, src, n1);
+            memcpy(ring->data(), src + n1, n - n1);
+            src += n;
+        }
+        head += n;
+        length -= n;
+    }
+}
+
+void cSharedMemoryCommunications::send(cCommBuffer *buffer, int tag, int destination)
+{
+    cMemCommBuffer *b = (cMemCommBuffer *)buffer;
+    Ring *ring = getRing(myProcId, destination);
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+
+    RecordHeader rh;
+    rh.tag = tag;
+    rh.contentLength = b->getMessageSize();
+    writeBytes(ring, head, &rh, sizeof(rh));
+    writeBytes(ring, head, b->getBuffer(), rh.contentLength);
+    writeBytes(ring, head, nullptr, alignUp(rh.contentLength, RECORD_ALIGNMENT) - rh.contentLength);
+    ring->head.store(head, std::memory_order_release);
+}
+
+bool cSharedMemoryCommunications::readAvailable(int source)
+{
+    // consumes whatever is available of the current record from the given
+    // ring; returns true if the record is complete (it is then in the
+    // buffer of incoming[source])
+    Ring *ring = getRing(source, myProcId);
+    IncomingRecord& in = incoming[source];
+    uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+
+    if (!in.inProgress) {
+        if (head - tail < sizeof(RecordHeader))
+            return false;
+        RecordHeader rh;
+        memcpy(&rh, ring->data() + (tail & (ringSize - 1)), sizeof(rh));
+        tail += sizeof(rh);
+        in.inProgress = true;
+        in.tag = rh.tag;
+        in.length = rh.contentLength;
+        in.bytesRead = 0;
+        in.buffer->reset();
+        in.buffer->allocateAtLeast(rh.contentLength);
+        in.buffer->setMessageSize(rh.contentLength);
+    }
+
+    // copy content; the padding after it is just skipped
+    size_t paddedLength = alignUp(in.length, RECORD_ALIGNMENT);
+    size_t n = std::min((size_t)(head - tail), paddedLength - in.bytesRead);
+    size_t contentBytes = in.bytesRead < in.length ? std::min(n, in.length - in.bytesRead) : 0;
+    if (contentBytes > 0) {
+        size_t pos = tail & (ringSize - 1);
+        size_t n1 = std::min(contentBytes, ringSize - pos);
+        char *dest = in.buffer->getBuffer() + in.bytesRead;
+        memcpy(dest, ring->data() + pos, n1);
+        memcpy(dest + n1, ring->data(), contentBytes - n1);
+    }
+    in.bytesRead += n;
+    ring->tail.store(tail + n, std::memory_order_release);
+
+    if (in.bytesRead < paddedLength)
+        return false;
+    in.inProgress = false;
+    return true;
+}
+
+void cSharedMemoryCommunications::drainIncoming()
+{
+    for (int i = 0; i < numPartitions; i++) {
+        if (i == myProcId)
+            continue;
+        while (readAvailable(i)) {
+            IncomingRecord& in = incoming[i];
+            receivedBuffers.push_back({in.tag, i, in.buffer});
+            in.buffer = new cMemCommBuffer();
+        }
+    }
+}
+
+bool cSharedMemoryCommunications::receive(int filtTag, cCommBuffer *buffer, int& receivedTag, int& sourceProcId)
+{
+    // return one from the previously buffered ones, if exist
+    for (auto it = receivedBuffers.begin(); it != receivedBuffers.end(); ++it) {
+        if (it->receivedTag == filtTag || filtTag == PARSIM_ANY_TAG) {
+            receivedTag = it->receivedTag;
+            sourceProcId = it->sourceProcId;
+            ((cMemCommBuffer*)buffer)->swap(it->buffer);
+            delete it->buffer;
+            receivedBuffers.erase(it);
+            return true;
+        }
+    }
+
+    // receive from the rings
+    bool recv = doReceive(buffer, receivedTag, sourceProcId);
+
+    // if received one with a wrong tag, store it for later and return false
+    if (recv && filtTag != PARSIM_ANY_TAG && filtTag != receivedTag) {
+        cMemCommBuffer *copy = new cMemCommBuffer();
+        ((cMemCommBuffer*)buffer)->swap(copy);
+        receivedBuffers.push_back({receivedTag, sourceProcId, copy});
+        return false;
+    }
+    return recv;
+}
+
+bool cSharedMemoryCommunications::doReceive(cCommBuffer *buffer, int& receivedTag, int& sourceProcId)
+{
+    // poll incoming rings, starting at a different one each time (round-robin)
+    rrBase = (rrBase+1)%numPartitions;
+    for (int k = 0; k < numPartitions; k++) {
+        int i = (rrBase+k)%numPartitions;
+        if (i != myProcId && readAvailable(i)) {
+            // hand over the data by swapping buffer contents
+            receivedTag = incoming[i].tag;
+            sourceProcId = i;
+            ((cMemCommBuffer *)buffer)->swap(incoming[i].buffer);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool cSharedMemoryCommunications::receiveBlocking(int filtTag, cCommBuffer *buffer, int& receivedTag, int& sourceProcId)
+{
+    // busy-poll for spinCount rounds for low latency, then start yielding
+    // the CPU; check for user interrupt every 0.1s like other implementations
+    int64_t lastIdleCheck = opp_get_monotonic_clock_usecs();
+    for (long i = 0; !receive(filtTag, buffer, receivedTag, sourceProcId); i++) {
+        if (i < spinCount) {
+            cpuRelax();
+            continue;
+        }
+        sched_yield();
+        if ((i & 255) == 0) {
+            int64_t now = opp_get_monotonic_clock_usecs();
+            if (now - lastIdleCheck >= 100000) {
+                lastIdleCheck = now;
+                if (getEnvir()->idle())
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool cSharedMemoryCommunications::receiveNonblocking(int filtTag, cCommBuffer *buffer, int& receivedTag, int& sourceProcId)
+{
+    return receive(filtTag, buffer, receivedTag, sourceProcId);
+}
+
+}  // namespace omnetpp
+
+#endif /* !_WIN32 */
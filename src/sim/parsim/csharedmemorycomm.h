@@ -0,0 +1,165 @@
+//=========================================================================
+//  CSHAREDMEMORYCOMM.H - part of
+//
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2003-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_CSHAREDMEMORYCOMM_H
+#define __OMNETPP_CSHAREDMEMORYCOMM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+#include "omnetpp/simutil.h"
+#include "omnetpp/cparsimcomm.h"
+
+namespace omnetpp {
+
+class cMemCommBuffer;
+
+/**
+ * @brief Implementation of the communications layer which uses a shared
+ * memory segment for communication between partitions running on the
+ * same host.
+ *
+ * The segment is created with shm_open() by partition 0, and is mapped
+ * by all partitions. It contains a lock-free single-producer single-consumer
+ * ring buffer for each ordered pair of partitions. The other partitions only
+ * attach to a segment whose creator process is alive, so a segment left over
+ * from a crashed run is not mistaken for the current one. Sending a buffer copies
+ * its contents into the ring of the (source,destination) pair, and
+ * receiving copies it out into the receiver's buffer; there are no system
+ * calls on the data path. Blocking receive busy-polls the rings for a
+ * configurable number of rounds before starting to yield the CPU, which
+ * keeps the latency of null messages low when every partition has a core
+ * of its own.
+ *
+ * Received data is handed over to the caller's buffer by swapping buffer
+ * contents, so the steady state involves no memory allocation. Messages
+ * that do not fit into a ring are streamed through it. To prevent deadlock,
+ * a partition waiting for free space in a ring keeps draining its own
+ * incoming rings.
+ *
+ * @ingroup Parsim
+ */
+class SIM_API cSharedMemoryCommunications : public cParsimCommunications
+{
+  protected:
+    struct SegmentHeader;
+    struct Ring;
+
+    int numPartitions;
+    int myProcId;
+
+    // shared memory segment
+    std::string segmentName;
+    size_t ringSize;
+    size_t ringStride;
+    int spinCount;
+    int fd;
+    char *segment;
+    size_t segmentSize;
+    int rrBase;
+
+    // record being read from each incoming ring; records are read
+    // incrementally, so reading never has to wait for the sender
+    struct IncomingRecord {bool inProgress; int tag; size_t length; size_t bytesRead; cMemCommBuffer *buffer;};
+    std::vector<IncomingRecord> incoming;
+
+    // reordering buffer needed because of tag filtering support (filtTag),
+    // and also for storing messages drained while send() was waiting
+    struct ReceivedBuffer {int receivedTag; int sourceProcId; cMemCommBuffer *buffer;};
+    std::list<ReceivedBuffer> receivedBuffers;
+
+  protected:
+    Ring *getRing(int source, int destination) const;
+    void attachSegment();
+    void detachSegment();
+    void writeBytes(Ring *ring, uint64_t& head, const void *data, size_t length);
+    bool readAvailable(int source);
+    void drainIncoming();
+
+    // common impl. for receiveBlocking() and receiveNonblocking()
+    bool receive(int filtTag, cCommBuffer *buffer, int& receivedTag, int& sourceProcId);
+    bool doReceive(cCommBuffer *buffer, int& receivedTag, int& sourceProcId);
+
+  public:
+    /**
+     * Constructor.
+     */
+    cSharedMemoryCommunications();
+
+    /**
+     * Destructor.
+     */
+    virtual ~cSharedMemoryCommunications();
+
+    /** @name Redefined methods from cParsimCommunications */
+    //@{
+    /**
+     * Init the library. Here we create or attach the shared memory segment.
+     */
+    virtual void init(int numPartitions) override;
+
+    /**
+     * Shutdown the communications library. Unmaps the shared memory segment.
+     */
+    virtual void shutdown() override;
+
+    /**
+     * Returns total number of partitions.
+     */
+    virtual int getNumPartitions() const override;
+
+    /**
+     * Returns the id of this partition.
+     */
+    virtual int getProcId() const override;
+
+    /**
+     * Creates an empty buffer of type cMemCommBuffer.
+     */
+    virtual cCommBuffer *createCommBuffer() override;
+
+    /**
+     * Recycle communication buffer after use.
+     */
+    virtual void recycleCommBuffer(cCommBuffer *buffer) override;
+
+    /**
+     * Sends packed data with given tag to destination.
+     */
+    virtual void send(cCommBuffer *buffer, int tag, int destination) override;
+
+    /**
+     * Receives packed data, and also returns tag and source procId.
+     * Normally returns true; false is returned if blocking was interrupted by the user.
+     */
+    virtual bool receiveBlocking(int filtTag, cCommBuffer *buffer, int& receivedTag, int& sourceProcId) override;
+
+    /**
+     * Receives packed data, and also returns tag and source procId.
+     * Call is non-blocking -- it returns true if something has been
+     * received, false otherwise.
+     */
+    virtual bool receiveNonblocking(int filtTag, cCommBuffer *buffer,  int& receivedTag, int& sourceProcId) override;
+    //@}
+};
+
+}  // namespace omnetpp
+
+
+#endif
+
@@ -0,0 +1,286 @@
+//=========================================================================
+//  GRAPHPARTITIONER.CC - part of
+//
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2003-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cmath>
+#include <set>
+#include <deque>
+#include <algorithm>
+#include "omnetpp/cexception.h"
+#include "graphpartitioner.h"
+
+namespace omnetpp {
+
+#define MAX_REFINEMENT_PASSES    10
+#define MAX_UNPRODUCTIVE_MOVES   100
+#define MAX_CANDIDATES_SCANNED   16
+
+int GraphPartitioner::addNode(double weight)
+{
+    if (weight < 0 || std::isnan(weight))
+        throw cRuntimeError("GraphPartitioner: Invalid node weight %g", weight);
+    nodeWeights.push_back(weight);
+    adjacency.push_back(std::vector<Neighbor>());
+    return nodeWeights.size() - 1;
+}
+
+void GraphPartitioner::addEdge(int node1, int node2, double weight)
+{
+    int n = nodeWeights.size();
+    if (node1 < 0 || node1 >= n || node2 < 0 || node2 >= n)
+        throw cRuntimeError("GraphPartitioner: Node index out of range");
+    if (node1 == node2)
+        return;  // self-loops never get cut
+    adjacency[node1].push_back(Neighbor{node2, weight});
+    adjacency[node2].push_back(Neighbor{node1, weight});
+}
+
+std::vector<int> GraphPartitioner::partition(int numPartitions)
+{
+    if (numPartitions < 1)
+        throw cRuntimeError("GraphPartitioner: Invalid number of partitions %d", numPartitions);
+    int n = nodeWeights.size();
+    std::vector<int> result(n, 0);
+    std::vector<int> nodes(n);
+    for (int i = 0; i < n; i++)
+        nodes[i] = i;
+    doPartition(nodes, 0, numPartitions, result);
+    return result;
+}
+
+void GraphPartitioner::doPartition(const std::vector<int>& nodes, int firstPartition, int numPartitions, std::vector<int>& result)
+{
+    if (numPartitions == 1 || nodes.size() <= 1) {
+        for (int node : nodes)
+            result[node] = firstPartition;
+        return;
+    }
+
+    // split into two halves with weights proportional to the number of partitions they get
+    int numPartitions0 = numPartitions / 2;
+    std::vector<int> nodes0, nodes1;
+    bisect(nodes, numPartitions0 / (double)numPartitions, nodes0, nodes1);
+    doPartition(nodes0, firstPartition, numPartitions0, result);
+    doPartition(nodes1, firstPartition + numPartitions0, numPartitions - numPartitions0, result);
+}
+
+void GraphPartitioner::bisect(const std::vector<int>& nodes, double fraction, std::vector<int>& nodes0, std::vector<int>& nodes1)
+{
+    // build the subgraph induced by the given nodes, with local numbering
+    int n = nodes.size();
+    std::vector<int> localIndex(nodeWeights.size(), -1);
+    for (int i = 0; i < n; i++)
+        localIndex[nodes[i]] = i;
+
+    Adjacency adj(n);
+    std::vector<double> weights(n);
+    double totalWeight = 0, maxNodeWeight = 0;
+    for (int i = 0; i < n; i++) {
+        weights[i] = nodeWeights[nodes[i]];
+        totalWeight += weights[i];
+        maxNodeWeight = std::max(maxNodeWeight, weights[i]);
+        for (const Neighbor& neighbor : adjacency[nodes[i]]) {
+            int j = localIndex[neighbor.node];
+            if (j != -1)
+                adj[i].push_back(Neighbor{j, neighbor.weight});
+        }
+    }
+
+    // an exact split may not exist, so allow half a node's worth of imbalance at least
+    double target0 = fraction * totalWeight;
+    double tolerance = std::max(imbalanceTolerance * totalWeight, maxNodeWeight / 2);
+
+    std::vector<char> side(n, 1);
+    growInitialBisection(adj, weights, target0, side);
+    for (int pass = 0; pass < MAX_REFINEMENT_PASSES; pass++)
+        if (!refineBisection(adj, weights, target0, tolerance, side))
+            break;
+
+    for (int i = 0; i < n; i++)
+        (side[i] == 0 ? nodes0 : nodes1).push_back(nodes[i]);
+}
+
+int GraphPartitioner::findPeripheralNode(const Adjacency& adj, int startNode)
+{
+    // breadth-first search; the last node reached is (one of) the farthest
+    std::vector<char> visited(adj.size(), false);
+    std::deque<int> queue;
+    queue.push_back(startNode);
+    visited[startNode] = true;
+    int last = startNode;
+    while (!queue.empty()) {
+        last = queue.front();
+        queue.pop_front();
+        for (const Neighbor& neighbor : adj[last]) {
+            if (!visited[neighbor.node]) {
+                visited[neighbor.node] = true;
+                queue.push_back(neighbor.node);
+            }
+        }
+    }
+    return last;
+}
+
+void GraphPartitioner::growInitialBisection(const Adjacency& adj, const std::vector<double>& weights, double target0, std::vector<char>& side)
+{
+    // Grow side 0 from a peripheral node, always adding the node most strongly
+    // connected to it. Unconnected parts of the graph are started from their
+    // lowest-numbered node.
+    int n = adj.size();
+    std::vector<double> connectivity(n, 0);
+    std::set<std::pair<double,int>> frontier;  // (-connectivity, node)
+    int seed = findPeripheralNode(adj, findPeripheralNode(adj, 0));
+    int nextUnvisited = 0;
+    double weight0 = 0;
+    while (weight0 < target0) {
+        int node;
+        if (!frontier.empty()) {
+            node = frontier.begin()->second;
+            frontier.erase(frontier.begin());
+        }
+        else if (seed != -1) {
+            node = seed;
+            seed = -1;
+        }
+        else {
+            while (nextUnvisited < n && side[nextUnvisited] == 0)
+                nextUnvisited++;
+            if (nextUnvisited == n)
+                break;
+            node = nextUnvisited;
+        }
+
+        // stop if adding this node would take us farther from the target than we are now
+        if (weight0 + weights[node] - target0 > target0 - weight0)
+            break;
+
+        side[node] = 0;
+        weight0 += weights[node];
+        for (const Neighbor& neighbor : adj[node]) {
+            int other = neighbor.node;
+            if (side[other] == 1) {
+                frontier.erase(std::make_pair(-connectivity[other], other));
+                connectivity[other] += neighbor.weight;
+                frontier.insert(std::make_pair(-connectivity[other], other));
+            }
+        }
+    }
+}
+
+bool GraphPartitioner::refineBisection(const Adjacency& adj, const std::vector<double>& weights, double target0, double tolerance, std::vector<char>& side)
+{
+    // One Fiduccia-Mattheyses pass. Nodes are moved one by one (each at most
+    // once) in the order of decreasing gain, where gain is the decrease of the
+    // cut weight; then the best prefix of the move sequence is kept. A move is
+    // only allowed if it keeps the bisection within the balance tolerance, or
+    // at least does not make it worse; neither side may become empty. Returns
+    // true if the pass improved the bisection.
+    int n = adj.size();
+    std::vector<double> gain(n, 0);
+    double weight0 = 0;
+    int count[2] = {0, 0};
+    for (int i = 0; i < n; i++) {
+        count[(int)side[i]]++;
+        if (side[i] == 0)
+            weight0 += weights[i];
+        for (const Neighbor& neighbor : adj[i])
+            gain[i] += side[neighbor.node] != side[i] ? neighbor.weight : -neighbor.weight;
+    }
+
+    std::set<std::pair<double,int>> candidates[2];  // (-gain, node), per side
+    for (int i = 0; i < n; i++)
+        candidates[(int)side[i]].insert(std::make_pair(-gain[i], i));
+
+    const double EPSILON = 1e-9;
+    auto imbalanceOf = [target0](double w0) {return std::fabs(w0 - target0);};
+    double initialImbalance = imbalanceOf(weight0);
+    bool initiallyBalanced = initialImbalance <= tolerance && count[0] > 0 && count[1] > 0;
+
+    std::vector<int> moves;
+    double cumulativeGain = 0;
+    double bestGain = 0, bestImbalance = initialImbalance;
+    int bestNumMoves = 0;
+    bool improved = false;
+
+    while (!candidates[0].empty() || !candidates[1].empty()) {
+        // pick the highest-gain node from either side whose move is allowed
+        int bestCandidate = -1;
+        double currentImbalance = imbalanceOf(weight0);
+        for (int s = 0; s < 2; s++) {
+            if (count[s] <= 1 && count[1-s] > 0)
+                continue;
+            int scanned = 0;
+            for (auto it = candidates[s].begin(); it != candidates[s].end() && scanned < MAX_CANDIDATES_SCANNED; ++it, ++scanned) {
+                int node = it->second;
+                double newWeight0 = s == 0 ? weight0 - weights[node] : weight0 + weights[node];
+                double newImbalance = imbalanceOf(newWeight0);
+                if (newImbalance <= tolerance || newImbalance < currentImbalance) {
+                    if (bestCandidate == -1 || gain[node] > gain[bestCandidate])
+                        bestCandidate = node;
+                    break;
+                }
+            }
+        }
+        if (bestCandidate == -1)
+            break;
+
+        // move it, and update the gains of its neighbors
+        int node = bestCandidate;
+        int from = side[node];
+        candidates[from].erase(std::make_pair(-gain[node], node));
+        side[node] = 1 - from;
+        count[from]--;
+        count[1-from]++;
+        weight0 += from == 0 ? -weights[node] : weights[node];
+        cumulativeGain += gain[node];
+        moves.push_back(node);
+        for (const Neighbor& neighbor : adj[node]) {
+            int other = neighbor.node;
+            auto it = candidates[(int)side[other]].find(std::make_pair(-gain[other], other));
+            bool isLocked = it == candidates[(int)side[other]].end();
+            if (!isLocked)
+                candidates[(int)side[other]].erase(it);
+            // edge became internal if other is now on the same side, external otherwise
+            gain[other] += side[other] == side[node] ? -2 * neighbor.weight : 2 * neighbor.weight;
+            if (!isLocked)
+                candidates[(int)side[other]].insert(std::make_pair(-gain[other], other));
+        }
+
+        // remember the best state seen: first reach balance, then minimize the cut
+        double imbalance = imbalanceOf(weight0);
+        bool isBalanced = imbalance <= tolerance && count[0] > 0 && count[1] > 0;
+        bool isBetter;
+        if (!initiallyBalanced && !improved)
+            isBetter = isBalanced || imbalance < bestImbalance - EPSILON;
+        else
+            isBetter = isBalanced && (cumulativeGain > bestGain + EPSILON || (cumulativeGain > bestGain - EPSILON && imbalance < bestImbalance - EPSILON));
+        if (isBetter) {
+            bestGain = cumulativeGain;
+            bestImbalance = imbalance;
+            bestNumMoves = moves.size();
+            improved = true;
+            initiallyBalanced = initiallyBalanced || isBalanced;
+        }
+        else if ((int)moves.size() - bestNumMoves > MAX_UNPRODUCTIVE_MOVES)
+            break;
+    }
+
+    // undo the moves after the best state
+    for (int i = (int)moves.size() - 1; i >= bestNumMoves; i--)
+        side[moves[i]] = 1 - side[moves[i]];
+    return improved;
+}
+
+}  // namespace omnetpp
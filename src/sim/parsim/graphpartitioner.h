@@ -0,0 +1,89 @@
+//=========================================================================
+//  GRAPHPARTITIONER.H - part of
+//
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2003-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_GRAPHPARTITIONER_H
+#define __OMNETPP_GRAPHPARTITIONER_H
+
+#include <vector>
+
+namespace omnetpp {
+
+/**
+ * @brief Balanced min-cut partitioning of an undirected graph with weighted
+ * nodes and edges, used for the automatic partitioning of networks for
+ * parallel simulation.
+ *
+ * The graph is split by recursive bisection. Each bisection starts from a
+ * partition grown greedily from a peripheral node, and is then improved
+ * with Fiduccia-Mattheyses passes that move single nodes across the cut
+ * as long as the total weight of the cut edges decreases and the weights
+ * of the two sides stay within the imbalance tolerance.
+ *
+ * The algorithm is deterministic: the same graph (nodes and edges added
+ * in the same order) always yields the same partitioning, so partitions
+ * of a parallel simulation can compute it independently of each other.
+ */
+class GraphPartitioner
+{
+  protected:
+    struct Neighbor {int node; double weight;};
+    typedef std::vector<std::vector<Neighbor>> Adjacency;
+
+    std::vector<double> nodeWeights;
+    Adjacency adjacency;
+    double imbalanceTolerance = 0.03;
+
+  protected:
+    void doPartition(const std::vector<int>& nodes, int firstPartition, int numPartitions, std::vector<int>& result);
+    void bisect(const std::vector<int>& nodes, double fraction, std::vector<int>& nodes0, std::vector<int>& nodes1);
+    static int findPeripheralNode(const Adjacency& adj, int startNode);
+    static void growInitialBisection(const Adjacency& adj, const std::vector<double>& weights, double target0, std::vector<char>& side);
+    static bool refineBisection(const Adjacency& adj, const std::vector<double>& weights, double target0, double tolerance, std::vector<char>& side);
+
+  public:
+    /**
+     * Adds a node with the given weight (e.g. expected number of events),
+     * and returns its index. Indices are assigned sequentially from zero.
+     */
+    int addNode(double weight);
+
+    /**
+     * Adds an edge with the given weight (cost of cutting it). Parallel
+     * edges are allowed; their weights add up.
+     */
+    void addEdge(int node1, int node2, double weight);
+
+    /**
+     * Returns the number of nodes.
+     */
+    int getNumNodes() const {return nodeWeights.size();}
+
+    /**
+     * Sets the allowed deviation of the weight of each side of a bisection
+     * from its target, as a fraction of the total weight. The default is 0.03.
+     */
+    void setImbalanceTolerance(double tolerance) {imbalanceTolerance = tolerance;}
+
+    /**
+     * Computes the partitioning, and returns the partition index (in the
+     * range 0..numPartitions-1) for each node.
+     */
+    std::vector<int> partition(int numPartitions);
+};
+
+}  // namespace omnetpp
+
+#endif
@@ -17,6 +17,11 @@
 
 #include "omnetpp/cpacket.h"  // PacketBytesFilter
 #include "omnetpp/cproperty.h"
+#include "omnetpp/cenvir.h"
+#include "omnetpp/cconfiguration.h"
+#include "omnetpp/cconfigoption.h"
+#include "omnetpp/regmacros.h"
+#include "common/stringutil.h"
 #include "omnetpp/checkandcast.h"
 #include "omnetpp/resultfilters.h"
 #include "omnetpp/cresultrecorder.h"
@@ -35,6 +40,14 @@ namespace omnetpp {
         "they indicate that the interval up to the next value is to be ignored. " \
         "To turn on time-weighted, specify 'timeWeighted=true' in the @statistic property."
 
+#define TIME_BUCKETS \
+        "Simulation time is divided into intervals of equal length (buckets), " \
+        "and one value is output for each non-empty bucket, timestamped with the start of the bucket. " \
+        "The bucket length is given with the 'bucketInterval' attribute of the @statistic property, " \
+        "or the 'result-bucket-interval' configuration option. "
+
+Register_PerObjectConfigOptionU(CFGID_RESULT_BUCKET_INTERVAL, "result-bucket-interval", KIND_STATISTIC, "s", nullptr, "Bucket length for the time bucket result filters (bucketCount, bucketMin, bucketMax, bucketMean, lttb) of the matching `@statistic`. Overrides the `bucketInterval` attribute of the `@statistic` property.\nUsage: `<module-full-path>.<statistic-name>.result-bucket-interval=<interval>`.\nExample: `**.queueLength.result-bucket-interval=0.1s`");
+
 // note: we don't register ExpressionFilter
 
 Register_ResultFilter2("warmup", WarmupPeriodFilter,
@@ -138,6 +151,39 @@ Register_ResultFilter2("sumPerDuration", SumPerDurationFilter,
         "(simtime minus warmupPeriod). NaN values in the input are ignored. "
         SIGNALTYPE_TO_NUMERIC_CONVERSIONS
 );
+Register_ResultFilter2("bucketCount", BucketCountFilter,
+        "Produces the number of input values in each time bucket. "
+        TIME_BUCKETS
+        NAN_VALUES_IGNORED
+        SIGNALTYPE_TO_NUMERIC_CONVERSIONS
+);
+Register_ResultFilter2("bucketMin", BucketMinFilter,
+        "Produces the minimum of the input values in each time bucket. "
+        TIME_BUCKETS
+        NAN_VALUES_IGNORED
+        SIGNALTYPE_TO_NUMERIC_CONVERSIONS
+);
+Register_ResultFilter2("bucketMax", BucketMaxFilter,
+        "Produces the maximum of the input values in each time bucket. "
+        TIME_BUCKETS
+        NAN_VALUES_IGNORED
+        SIGNALTYPE_TO_NUMERIC_CONVERSIONS
+);
+Register_ResultFilter2("bucketMean", BucketMeanFilter,
+        "Produces the arithmetic mean of the input values in each time bucket. "
+        TIME_BUCKETS
+        NAN_VALUES_IGNORED
+        SIGNALTYPE_TO_NUMERIC_CONVERSIONS
+);
+Register_ResultFilter2("lttb", LttbFilter,
+        "Downsamples the input with the Largest-Triangle-Three-Buckets algorithm, "
+        "letting through one value (with its original timestamp) from each time bucket, "
+        "chosen so that the line plot of the output resembles that of the input. "
+        "The bucket length is given with the 'bucketInterval' attribute of the @statistic property, "
+        "or the 'result-bucket-interval' configuration option. "
+        NAN_VALUES_IGNORED
+        SIGNALTYPE_TO_NUMERIC_CONVERSIONS
+);
 
 
 void WarmupPeriodFilter::receiveSignal(cResultFilter *prev, simtime_t_cref t, bool b, cObject *details)
@@ -559,5 +605,173 @@ std::string SumPerDurationFilter::str() const
     return os.str();
 }
 
-}  // namespace omnetpp
+//---
+
+static simtime_t readBucketInterval(cResultFilter *filter, cComponent *component, cProperty *attrsProperty)
+{
+    simtime_t interval;
+    std::string statisticFullPath = component->getFullPath() + "." + common::opp_nulltoempty(attrsProperty->getIndex());
+    cConfiguration *config = getEnvir()->getConfig();
+    if (config->getPerObjectConfigValue(statisticFullPath.c_str(), CFGID_RESULT_BUCKET_INTERVAL) != nullptr)
+        interval = config->getAsDouble(statisticFullPath.c_str(), CFGID_RESULT_BUCKET_INTERVAL);
+    else {
+        const char *attr = attrsProperty->getValue("bucketInterval", 0);
+        if (!attr)
+            throw cRuntimeError("%s: Bucket length not specified, use the 'bucketInterval' attribute "
+                                "of the @statistic property or the '%s' configuration option",
+                                filter->getClassName(), CFGID_RESULT_BUCKET_INTERVAL->getName());
+        interval = SimTime::parse(attr);
+    }
+    if (interval <= SIMTIME_ZERO)
+        throw cRuntimeError("%s: Bucket length must be positive", filter->getClassName());
+    return interval;
+}
+
+void TimeBucketFilter::init(cComponent *component, cProperty *attrsProperty)
+{
+    cNumericResultFilter::init(component, attrsProperty);
+    bucketInterval = readBucketInterval(this, component, attrsProperty);
+}
+
+bool TimeBucketFilter::process(simtime_t& t, double& value, cObject *details)
+{
+    if (std::isnan(value))
+        return false;
+
+    int64_t index = t.raw() / bucketInterval.raw();
+    bool bucketComplete = index != bucketIndex && bucketIndex != -1;
+    if (bucketComplete) {
+        double bucketValue = getBucketValue();
+        simtime_t bucketStart = getBucketStartTime();
+        count = 0;
+        sum = 0;
+        min = INFINITY;
+        max = -INFINITY;
+        collect(value);
+        t = bucketStart;
+        value = bucketValue;
+    }
+    else
+        collect(value);
+    bucketIndex = index;
+    return bucketComplete;
+}
+
+void TimeBucketFilter::collect(double value)
+{
+    count++;
+    sum += value;
+    if (value < min)
+        min = value;
+    if (value > max)
+        max = value;
+}
+
+void TimeBucketFilter::finish(cResultFilter *prev)
+{
+    if (count > 0)
+        fire(this, getBucketStartTime(), getBucketValue(), nullptr);
+    count = 0;
+}
+
+std::string TimeBucketFilter::str() const
+{
+    std::stringstream os;
+    os << "bucketInterval = " << bucketInterval << ", current bucket: count = " << count;
+    if (count > 0)
+        os << ", value = " << getBucketValue();
+    return os.str();
+}
+
+//---
+
+void LttbFilter::init(cComponent *component, cProperty *attrsProperty)
+{
+    cNumericResultFilter::init(component, attrsProperty);
+    bucketInterval = readBucketInterval(this, component, attrsProperty);
+}
+
+bool LttbFilter::process(simtime_t& t, double& value, cObject *details)
+{
+    if (std::isnan(value))
+        return false;
+
+    // the first value is always let through
+    int64_t index = t.raw() / bucketInterval.raw();
+    if (!hasSelected) {
+        hasSelected = true;
+        lastSelected = {t, value};
+        bucketIndex = index;
+        return true;
+    }
+
+    if (index == bucketIndex) {
+        currentBucket.push_back({t, value});
+        return false;
+    }
 
+    // current bucket is complete; now the pending one can be decided on
+    bool selected = false;
+    if (!pendingBucket.empty() && !currentBucket.empty()) {
+        lastSelected = selectFromPendingBucket();
+        selected = true;
+    }
+    if (!currentBucket.empty()) {
+        pendingBucket.swap(currentBucket);
+        currentBucket.clear();
+    }
+    currentBucket.push_back({t, value});
+    bucketIndex = index;
+
+    if (selected) {
+        t = lastSelected.t;
+        value = lastSelected.value;
+    }
+    return selected;
+}
+
+const LttbFilter::Point& LttbFilter::selectFromPendingBucket() const
+{
+    // average of the next bucket; times are relative to the last selected point
+    double nextT = 0, nextValue = 0;
+    for (const Point& p : currentBucket) {
+        nextT += (p.t - lastSelected.t).dbl();
+        nextValue += p.value;
+    }
+    nextT /= currentBucket.size();
+    nextValue /= currentBucket.size();
+
+    // choose the point that forms the largest triangle (twice the area is computed)
+    const Point *best = &pendingBucket[0];
+    double bestArea = -1;
+    for (const Point& p : pendingBucket) {
+        double dt = (p.t - lastSelected.t).dbl();
+        double area = std::fabs(dt * (nextValue - lastSelected.value) - nextT * (p.value - lastSelected.value));
+        if (area > bestArea) {
+            bestArea = area;
+            best = &p;
+        }
+    }
+    return *best;
+}
+
+void LttbFilter::finish(cResultFilter *prev)
+{
+    if (!pendingBucket.empty()) {
+        const Point& p = currentBucket.empty() ? pendingBucket.back() : selectFromPendingBucket();
+        fire(this, p.t, p.value, nullptr);
+    }
+    if (!currentBucket.empty())
+        fire(this, currentBucket.back().t, currentBucket.back().value, nullptr);  // the last value is always let through
+    pendingBucket.clear();
+    currentBucket.clear();
+}
+
+std::string LttbFilter::str() const
+{
+    std::stringstream os;
+    os << "bucketInterval = " << bucketInterval << ", buffered values: " << pendingBucket.size() + currentBucket.size();
+    return os.str();
+}
+
+}  // namespace omnetpp
@@ -156,7 +156,7 @@ void StatisticRecorderParser::parse(const SignalSource& source, const char *reco
     StatisticRecorderAstTranslator statisticTranslator(source, recordingMode, component, attrsProperty, statisticName);
     Expression::MultiAstTranslator translator({ &statisticTranslator, Expression::getDefaultAstTranslator() });
 
-    ExprNode *exprTree = Expression().parseAndTranslate(recordingMode, &translator);
+    ExprNode *exprTree = StatisticExpressionCache::parseAndTranslate(recordingMode, &translator);
 
     SignalSource output = statisticTranslator.makeSignalSource(exprTree);
 
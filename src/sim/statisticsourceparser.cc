@@ -231,7 +231,7 @@ SignalSource StatisticSourceParser::parse(cComponent *component, cProperty *stat
     StatisticSourceAstTranslator statisticTranslator(component, statisticProperty, statisticName, checkSignalDecl, needWarmupFilter);
     Expression::MultiAstTranslator translator({ &statisticTranslator, Expression::getDefaultAstTranslator() });
 
-    ExprNode *exprTree = Expression().parseAndTranslate(sourceSpec, &translator);
+    ExprNode *exprTree = StatisticExpressionCache::parseAndTranslate(sourceSpec, &translator);
 
     SignalSource signalSource = statisticTranslator.makeSignalSource(exprTree);
 
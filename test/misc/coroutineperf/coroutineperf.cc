@@ -0,0 +1,127 @@
+#include <omnetpp.h>
+
+using namespace omnetpp;
+
+#ifndef OMNETPP_HAS_COROUTINE_MODULE
+#error "This benchmark must be compiled as C++20 (e.g. make CXXFLAGS=-std=c++20)"
+#endif
+
+enum { PING = 1, PONG };
+
+// helper: sends a ping to a random other node
+static void sendPing(cSimpleModule *module)
+{
+    cModule *network = module->getParentModule();
+    int numNodes = network->par("numNodes");
+    cModule *target = network->getSubmodule("node", module->intrand(numNodes));
+    module->sendDirect(new cMessage("ping", PING), target, "in");
+}
+
+// helper: replies to a ping
+static void sendPong(cSimpleModule *module, cMessage *ping)
+{
+    cModule *sender = ping->getSenderModule();
+    delete ping;
+    module->sendDirect(new cMessage("pong", PONG), sender, "in");
+}
+
+class ActivityNode : public cSimpleModule
+{
+  protected:
+    cQueue queue;
+
+  public:
+    ActivityNode() : cSimpleModule(16384) {}
+    virtual void activity() override;
+};
+
+Define_Module(ActivityNode);
+
+void ActivityNode::activity()
+{
+    double pingProbability = par("pingProbability");
+    for (;;) {
+        waitAndEnqueue(par("waitTime"), &queue);
+        while (!queue.isEmpty()) {
+            cMessage *msg = check_and_cast<cMessage *>(queue.pop());
+            if (msg->getKind() == PING)
+                sendPong(this, msg);
+            else
+                delete msg;  // late pong
+        }
+        if (dblrand() < pingProbability) {
+            sendPing(this);
+            cMessage *msg;
+            while ((msg = receive(0.1)) != nullptr && msg->getKind() == PING)
+                sendPong(this, msg);
+            delete msg;
+        }
+    }
+}
+
+class CoroutineNode : public cCoroutineModule
+{
+  protected:
+    cQueue queue;
+
+  protected:
+    virtual Task coActivity() override;
+};
+
+Define_Module(CoroutineNode);
+
+cCoroutineModule::Task CoroutineNode::coActivity()
+{
+    double pingProbability = par("pingProbability");
+    for (;;) {
+        co_await coWaitAndEnqueue(par("waitTime"), &queue);
+        while (!queue.isEmpty()) {
+            cMessage *msg = check_and_cast<cMessage *>(queue.pop());
+            if (msg->getKind() == PING)
+                sendPong(this, msg);
+            else
+                delete msg;  // late pong
+        }
+        if (dblrand() < pingProbability) {
+            sendPing(this);
+            cMessage *msg;
+            while ((msg = co_await coReceive(0.1)) != nullptr && msg->getKind() == PING)
+                sendPong(this, msg);
+            delete msg;
+        }
+    }
+}
+
+class Reporter : public cSimpleModule
+{
+  protected:
+    int64_t startTime;
+
+  protected:
+    virtual void initialize() override {startTime = opp_get_monotonic_clock_usecs();}
+    virtual void finish() override;
+};
+
+Define_Module(Reporter);
+
+void Reporter::finish()
+{
+    double elapsed = (opp_get_monotonic_clock_usecs() - startTime) / 1e6;
+    int64_t numEvents = getSimulation()->getEventNumber();
+    cModule *network = getParentModule();
+    int numNodes = network->par("numNodes");
+
+    // memory used for the module bodies: stacks or coroutine frames
+    int64_t bodyMemory = 0;
+    if (strcmp(network->par("nodeType").stringValue(), "ActivityNode") == 0) {
+        for (int i = 0; i < numNodes; i++)
+            bodyMemory += check_and_cast<cSimpleModule *>(network->getSubmodule("node", i))->getStackSize();
+    }
+    else {
+        bodyMemory = cCoroutineModule::getTotalFrameSize();
+    }
+
+    std::cout << network->par("nodeType").stringValue() << "\tn=" << numNodes << "\t"
+              << (int64_t)(numEvents / elapsed) << " ev/sec\t"
+              << bodyMemory / numNodes << " bytes/module (stack or frame)" << std::endl;
+}
@@ -154,4 +154,5 @@ sub testEventLogTool
 testEventLogTool("elog/predefined/simple/empty.elog");
 testEventLogTool("elog/predefined/simple/one-event.elog");
 testEventLogTool("elog/predefined/simple/two-events.elog");
+testEventLogTool("elog/predefined/simple/log-lines.elog");
 testEventLogTool("elog/generated/stress.elog");
@@ -0,0 +1,62 @@
+#include <omnetpp.h>
+
+using namespace omnetpp;
+
+class FesBench : public cSimpleModule
+{
+  protected:
+    enum { HOLD, BURST };
+    bool bursty;
+    int burstSize;
+    double burstProbability;
+    int64_t numEventsToRun;
+    int64_t startTime;
+
+  public:
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage *msg) override;
+    virtual void finish() override;
+};
+
+Define_Module(FesBench);
+
+void FesBench::initialize()
+{
+    bursty = strcmp(par("workload").stringValue(), "bursty") == 0;
+    burstSize = par("burstSize");
+    burstProbability = par("burstProbability");
+    numEventsToRun = par("numEventsToRun");
+
+    int numEvents = par("numEvents");
+    for (int i = 0; i < numEvents; i++)
+        scheduleAfter(par("holdTime"), new cMessage("hold", HOLD));
+    startTime = opp_get_monotonic_clock_usecs();
+}
+
+void FesBench::handleMessage(cMessage *msg)
+{
+    if (getSimulation()->getEventNumber() >= numEventsToRun)
+        endSimulation();
+
+    if (msg->getKind() == BURST) {
+        delete msg;
+        return;
+    }
+
+    scheduleAfter(par("holdTime"), msg);
+
+    if (bursty && dblrand() < burstProbability) {
+        simtime_t t = simTime() + par("holdTime").doubleValue() / 100;
+        for (int i = 0; i < burstSize; i++)
+            scheduleAt(i % 2 == 0 ? simTime() : t, new cMessage("burst", BURST));
+    }
+}
+
+void FesBench::finish()
+{
+    double elapsed = (opp_get_monotonic_clock_usecs() - startTime) / 1e6;
+    int64_t numEventsRun = getSimulation()->getEventNumber();
+    std::cout << getSimulation()->getFES()->getClassName() << "\t" << par("workload").stringValue()
+              << "\tn=" << par("numEvents").intValue() << "\t"
+              << (int64_t)(numEventsRun / elapsed) << " ev/sec" << std::endl;
+}
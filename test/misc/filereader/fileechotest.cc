@@ -27,11 +27,21 @@
 using namespace omnetpp;
 using namespace omnetpp::common;
 
-void testFileEcho(const char *file, bool forward)
+void testFileEcho(const char *file, const char *mode, bool useMemoryMapping)
 {
     _setmode(_fileno(stdout), _O_BINARY);
     FileReader fileReader(file);
+    fileReader.setUseMemoryMapping(useMemoryMapping);
 
+    if (!strcmp(mode, "bulk")) {
+        fileReader.readLines(0, -1, [](char *line, int length) {
+            printf("%.*s", length, line);
+            return true;
+        });
+        return;
+    }
+
+    bool forward = strcmp(mode, "backward");
     if (forward)
         fileReader.seekTo(0);
     else
@@ -50,7 +60,7 @@ void usage(const char *message)
 
     fprintf(stderr, ""
                     "Usage:\n"
-                    "   filereadertest <input-file-name> (forward|backward)\n"
+                    "   fileechotest <input-file-name> (forward|backward|bulk) [mmap]\n"
             );
 }
 
@@ -62,7 +72,7 @@ int main(int argc, char **argv)
             return -1;
         }
         else {
-            testFileEcho(argv[1], strcmp(argv[2], "backward"));
+            testFileEcho(argv[1], argv[2], argc > 3 && !strcmp(argv[3], "mmap"));
             return 0;
         }
     }
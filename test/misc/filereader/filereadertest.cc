@@ -14,6 +14,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <fcntl.h>
 #include <common/lcgrandom.h>
 #include <common/exception.h>
@@ -33,10 +34,11 @@ int parseLineNumber(char *line)
     return !line || *line == '\r' || *line == '\n' ? -1 : atol(line);
 }
 
-void testFileReader(const char *file, long numberOfLines, int numberOfSeeks, int numberOfReadLines)
+void testFileReader(const char *file, long numberOfLines, int numberOfSeeks, int numberOfReadLines, bool useMemoryMapping)
 {
     _setmode(_fileno(stdout), _O_BINARY);
     FileReader fileReader(file);
+    fileReader.setUseMemoryMapping(useMemoryMapping);
     LCGRandom random;
     int64_t fileSize = fileReader.getFileSize();
 
@@ -121,7 +123,7 @@ void usage(char *message)
 
     fprintf(stderr, ""
                     "Usage:\n"
-                    "   filereadertest <input-file-name> <number-of-lines> <number-of-seeks> <number-of-read-lines-per-seek>\n"
+                    "   filereadertest <input-file-name> <number-of-lines> <number-of-seeks> <number-of-read-lines-per-seek> [mmap]\n"
             );
 }
 
@@ -134,7 +136,7 @@ int main(int argc, char **argv)
             return -1;
         }
         else {
-            testFileReader(argv[1], atol(argv[2]), atoi(argv[3]), atoi(argv[4]));
+            testFileReader(argv[1], atol(argv[2]), atoi(argv[3]), atoi(argv[4]), argc > 5 && !strcmp(argv[5], "mmap"));
             printf("PASS\n");
 
             return 0;
@@ -59,6 +59,32 @@ sub test
    {
       print("FAIL: Reader test on $fileName\n\n");
    }
+
+   foreach $mode ("bulk", "forward mmap", "bulk mmap")
+   {
+      $modeResultFileName = $fileName;
+      $modeTag = $mode;
+      $modeTag =~ s/ /-/g;
+      $modeResultFileName =~ s/^(.*)\//results\/$modeTag-/;
+
+      if (system("${progdir}fileechotest $fileName $mode > $modeResultFileName") == 0 && matchFiles($fileName, $modeResultFileName))
+      {
+         print("PASS: Echoing $fileName ($mode)\n\n");
+      }
+      else
+      {
+         print("FAIL: Echoing $fileName ($mode)\n\n");
+      }
+   }
+
+   if (system("${progdir}filereadertest $fileName $numberOfLines $numberOfSeeks $numberOfReadLines mmap > $resultFileName") == 0)
+   {
+      print("PASS: Reader test on $fileName (mmap)\n\n");
+   }
+   else
+   {
+      print("FAIL: Reader test on $fileName (mmap)\n\n");
+   }
 }
 
 sub generateContent
@@ -0,0 +1,63 @@
+//
+// This file is part of an OMNeT++/OMNEST simulation example.
+//
+// Copyright (C) 2010 Andras Varga
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file
+// `license' for details on this and other legal matters.
+//
+
+#include <omnetpp.h>
+
+using namespace omnetpp;
+
+class RingNode : public cSimpleModule
+{
+  protected:
+    cMessage *timer = nullptr;
+    long numReceived = 0;
+
+  protected:
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage *msg) override;
+    virtual void finish() override;
+
+  public:
+    virtual ~RingNode() {cancelAndDelete(timer);}
+};
+
+Define_Module(RingNode);
+
+void RingNode::initialize()
+{
+    if (par("sendToken").boolValue()) {
+        std::string name = std::string("token-") + getFullName();
+        send(new cPacket(name.c_str()), "out");
+    }
+    if (par("timerInterval").doubleValue() > 0) {
+        timer = new cMessage("timer");
+        scheduleAt(par("timerOffset"), timer);
+    }
+}
+
+void RingNode::handleMessage(cMessage *msg)
+{
+    simtime_t stopTime = par("stopTime");
+    bool stopped = stopTime >= SIMTIME_ZERO && simTime() >= stopTime;
+    if (msg == timer) {
+        if (!stopped)
+            scheduleAt(simTime() + par("timerInterval"), timer);
+    }
+    else {
+        numReceived++;
+        if (!stopped)
+            send(msg, "out");
+        else
+            delete msg;
+    }
+}
+
+void RingNode::finish()
+{
+    EV << getFullPath() << ": " << numReceived << " tokens received\n";
+}
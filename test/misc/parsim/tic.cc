@@ -8,21 +8,28 @@
 //
 
 #include <string.h>
+#include <iostream>
 #include <omnetpp.h>
 
 using namespace omnetpp;
 
 class Tic : public cSimpleModule
 {
+  protected:
+    long numReceived = 0;
+    int64_t startTime = 0;  // wall clock, in microseconds
+
   protected:
     virtual void initialize();
     virtual void handleMessage(cMessage *msg);
+    virtual void finish();
 };
 
 Define_Module(Tic);
 
 void Tic::initialize()
 {
+    startTime = opp_get_monotonic_clock_usecs();
     if (par("initialSend").boolValue()) {
         cPacket *pkt = new cPacket(getFullName());
         send(pkt, par("outputGate").stringValue());
@@ -32,6 +39,7 @@ void Tic::initialize()
 void Tic::handleMessage(cMessage *msg)
 {
     cPacket *pkt = check_and_cast<cPacket *>(msg);
+    numReceived++;
 
     if (par("delete").boolValue()) {
         if (par("allowPointerAliasing").boolValue()) {
@@ -46,3 +54,14 @@ void Tic::handleMessage(cMessage *msg)
     send(pkt, par("outputGate").stringValue());
 }
 
+void Tic::finish()
+{
+    // with the two Tic modules in different partitions, every message
+    // crosses the partition boundary, so this is the per-message latency
+    // of the communications layer (plus the synchronization overhead)
+    if (par("reportLatency").boolValue() && numReceived > 0) {
+        double usecs = opp_get_monotonic_clock_usecs() - startTime;
+        std::cout << getFullPath() << ": " << numReceived << " messages received, "
+                  << usecs / numReceived << "us wall-clock time per message\n";
+    }
+}
@@ -0,0 +1,148 @@
+//
+// Benchmark for writing text result files: fprintf() vs TextBuffer.
+// See README for details.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <cinttypes>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "common/stringutil.h"
+#include "common/numberformat.h"
+#include "common/textbuffer.h"
+
+using namespace omnetpp::common;
+
+struct Sample {
+    int64_t eventNumber;
+    int64_t t;
+    double value;
+};
+
+static double now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static long fileSize(const char *fname)
+{
+    FILE *f = fopen(fname, "rb");
+    if (!f)
+        return -1;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    return size;
+}
+
+static bool sameContents(const char *fname1, const char *fname2)
+{
+    FILE *f1 = fopen(fname1, "rb"), *f2 = fopen(fname2, "rb");
+    bool same = f1 && f2;
+    while (same) {
+        int c1 = fgetc(f1), c2 = fgetc(f2);
+        if (c1 != c2)
+            same = false;
+        if (c1 == EOF)
+            break;
+    }
+    if (f1)
+        fclose(f1);
+    if (f2)
+        fclose(f2);
+    return same;
+}
+
+static void writeWithPrintf(const char *fname, const std::vector<Sample>& samples, int prec)
+{
+    FILE *f = fopen(fname, "w");
+    char buf[64];
+    for (const Sample& s : samples) {
+        char *endp;
+        fprintf(f, "%d\t%" PRId64 "\t%s\t%.*g\n", 42, s.eventNumber, opp_ttoa(buf, s.t, -12, endp), prec, s.value);
+    }
+    fclose(f);
+}
+
+static void writeWithTextBuffer(const char *fname, const std::vector<Sample>& samples, int prec)
+{
+    FILE *f = fopen(fname, "w");
+    TextBuffer b;
+    for (const Sample& s : samples) {
+        b.appendInt(42);
+        b.append('\t');
+        b.appendInt(s.eventNumber);
+        b.append('\t');
+        b.appendSimtime(s.t, -12);
+        b.append('\t');
+        b.appendDouble(s.value, prec);
+        b.append('\n');
+        if (b.getLength() >= 65536)
+            b.writeTo(f);
+    }
+    b.writeTo(f);
+    fclose(f);
+}
+
+static long checkFormatting(long n)
+{
+    std::mt19937_64 rng(1);
+    long mismatches = 0;
+    char expected[600], actual[600];
+    for (long i = 0; i < n; i++) {
+        // random bit patterns, and "typical" values
+        uint64_t bits = rng();
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        double typical = std::ldexp((double)(rng() >> 11), (int)(rng() % 120) - 110);
+        for (double x : {d, typical, -typical}) {
+            int prec = 1 + rng() % 17;
+            snprintf(expected, sizeof(expected), "%.*g", prec, x);
+            opp_formatdouble(actual, x, prec);
+            if (strcmp(expected, actual) != 0 && mismatches++ < 10)
+                printf("  mismatch: %%.%dg of %.17g: \"%s\" vs \"%s\"\n", prec, x, expected, actual);
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char **argv)
+{
+    long n = argc > 1 ? atol(argv[1]) : 1000000;
+    int prec = argc > 2 ? atoi(argv[2]) : 14;
+
+    std::mt19937_64 rng(0);
+    std::vector<Sample> samples(n);
+    int64_t t = 0, eventNumber = 0;
+    for (Sample& s : samples) {
+        t += rng() % 1000000000;
+        eventNumber += 1 + rng() % 10;
+        s.eventNumber = eventNumber;
+        s.t = t;
+        s.value = std::exp((double)(rng() % 4000) / 100.0 - 20);
+    }
+
+    double t0 = now();
+    writeWithPrintf("printf.out", samples, prec);
+    double t1 = now();
+    writeWithTextBuffer("textbuffer.out", samples, prec);
+    double t2 = now();
+
+    long size = fileSize("printf.out");
+    printf("%ld lines, precision %d, %ld bytes\n", n, prec, size);
+    printf("fprintf:    %.3fs, %.1f MB/s\n", t1 - t0, size / (t1 - t0) / 1e6);
+    printf("TextBuffer: %.3fs, %.1f MB/s\n", t2 - t1, size / (t2 - t1) / 1e6);
+    if (!sameContents("printf.out", "textbuffer.out")) {
+        printf("ERROR: output files differ\n");
+        return 1;
+    }
+
+    long mismatches = checkFormatting(n);
+    printf("opp_formatdouble() vs sprintf(): %ld mismatches in %ld numbers\n", mismatches, 3 * n);
+    return mismatches == 0 ? 0 : 1;
+}
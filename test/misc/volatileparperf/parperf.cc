@@ -0,0 +1,36 @@
+#include <omnetpp.h>
+
+using namespace omnetpp;
+
+class ParPerf : public cSimpleModule
+{
+  protected:
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage *msg) override {}
+};
+
+Define_Module(ParPerf);
+
+void ParPerf::initialize()
+{
+    int64_t numReads = par("numReads");
+    for (int i = 0; i < getNumParams(); i++) {
+        cPar& p = par(i);
+        if (!p.isVolatile())
+            continue;
+
+        double sum = 0;  // to prevent the reads from being optimized out
+        int64_t startTime = opp_get_monotonic_clock_usecs();
+        for (int64_t k = 0; k < numReads; k++) {
+            switch (p.getType()) {
+                case cPar::BOOL: sum += p.boolValue(); break;
+                case cPar::INT: sum += p.intValue(); break;
+                default: sum += p.doubleValue(); break;
+            }
+        }
+        double elapsed = (opp_get_monotonic_clock_usecs() - startTime) / 1e6;
+        std::cout << p.getName() << "\t" << p.str() << "\t"
+                  << (int64_t)(numReads / elapsed) << " reads/sec"
+                  << "\t(avg " << sum / numReads << ")" << std::endl;
+    }
+}
@@ -0,0 +1,59 @@
+//
+// Loads result files into a ResultFileManager, either one by one with
+// loadFile(), or with loadFiles() on the given number of threads, and
+// prints the file runs and the result items with their IDs in the order
+// the ResultFileManager returns them. If loading fails, the error is
+// printed, followed by the contents loaded until then.
+//
+// usage: loadtest <numThreads>|seq <files>...
+//
+
+#include <cstdio>
+#include <cstring>
+#include "scave/resultfilemanager.h"
+
+using namespace omnetpp::scave;
+
+static void dump(ResultFileManager& manager)
+{
+    for (FileRun *fileRun : manager.getFileRuns())
+        if (fileRun)
+            printf("filerun %s %s\n", fileRun->getFile()->getFilePath().c_str(), fileRun->getRun()->getRunName().c_str());
+
+    IDList ids = manager.getAllItems();
+    for (int i = 0; i < ids.size(); i++) {
+        ID id = ids.get(i);
+        ScalarResult buffer;
+        const ResultItem *item = manager.getItem(id, buffer);
+        printf("item %lld %s %s %s %s\n", (long long)id, item->getFileRun()->getFile()->getFilePath().c_str(),
+                item->getFileRun()->getRun()->getRunName().c_str(), item->getModuleName().c_str(), item->getName().c_str());
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: loadtest <numThreads>|seq <files>...\n");
+        return 1;
+    }
+
+    StringVector fileNames(argv + 2, argv + argc);
+    int flags = ResultFileManager::LOADFLAGS_DEFAULTS;
+    ResultFileManager manager;
+    try {
+        if (strcmp(argv[1], "seq") == 0) {
+            for (const std::string& fileName : fileNames)
+                manager.loadFile(fileName.c_str(), fileName.c_str(), flags, nullptr);
+        }
+        else {
+            ResultFileList files = manager.loadFiles(fileNames, flags, nullptr, atoi(argv[1]));
+            for (ResultFile *file : files)
+                printf("file %s\n", file->getFilePath().c_str());
+        }
+    }
+    catch (std::exception& e) {
+        printf("error: %s\n", e.what());
+    }
+    dump(manager);
+    return 0;
+}
@@ -0,0 +1,17 @@
+#include <omnetpp.h>
+
+using namespace omnetpp;
+
+class Node : public cSimpleModule
+{
+    virtual void initialize() override {
+        simsignal_t foo = registerSignal("foo");
+        for (int i = 0; i < 100; i++) {
+            cTimestampedValue tmp((simtime_t)i, (double)((i * (getIndex() + 3)) % 17));
+            emit(foo, &tmp);
+        }
+        recordScalar("index", getIndex());
+    }
+};
+
+Define_Module(Node);
@@ -0,0 +1,36 @@
+#include <omnetpp.h>
+
+using namespace omnetpp;
+
+// Records a few vectors with deterministic data: samples at every 0.25s,
+// some of them several times per event, and one vector without event numbers.
+class Source : public cSimpleModule
+{
+    cOutVector counter;
+    cOutVector pairs;
+    cOutVector noEventNumbers;
+    int eventsLeft;
+
+    virtual void initialize() override {
+        counter.setName("counter");
+        pairs.setName("pairs");
+        noEventNumbers.setName("noEventNumbers");
+        eventsLeft = par("numEvents");
+        scheduleAt(0, new cMessage("timer"));
+    }
+
+    virtual void handleMessage(cMessage *msg) override {
+        long k = getSimulation()->getEventNumber();
+        counter.record(k);
+        pairs.record(k * 0.1 + getIndex());
+        pairs.record(-k * 1e-3);
+        if (k % 3 == 0)
+            noEventNumbers.record(1.0 / (k + 1));
+        if (--eventsLeft > 0)
+            scheduleAfter(0.25, msg);
+        else
+            delete msg;
+    }
+};
+
+Define_Module(Source);